@@ -1,10 +1,16 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+/// ===========================================================================
+/// @section Core
+#include "RayTracer/Core/Cpu.hpp"
+#include "RayTracer/Core/ThreadPool.hpp"
+
 /// ===========================================================================
 /// @section Math
 #include "RayTracer/Math/Constants.hpp"
 #include "RayTracer/Math/Matrix.hpp"
+#include "RayTracer/Math/SIMD.hpp"
 #include "RayTracer/Math/Transformations.hpp"
 #include "RayTracer/Math/Tuple.hpp"
 
@@ -19,9 +25,17 @@
 #include "RayTracer/Rendering/Canvas.hpp"
 #include "RayTracer/Rendering/Color.hpp"
 
+/// ---------------------------------------------------------------------------
+/// @subsection Acceleration
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+#include "RayTracer/Rendering/Acceleration/BoundingBox.hpp"
+#include "RayTracer/Rendering/Acceleration/TopLevelBVH.hpp"
+#include "RayTracer/Rendering/Acceleration/WideBVH.hpp"
+
 /// ---------------------------------------------------------------------------
 /// @subsection Cameras
 #include "RayTracer/Rendering/Cameras/Camera.hpp"
+#include "RayTracer/Rendering/Cameras/WavefrontRenderer.hpp"
 
 /// ---------------------------------------------------------------------------
 /// @subsection Lighting
@@ -29,6 +43,7 @@
 #include "RayTracer/Rendering/Lighting/Intersection.hpp"
 #include "RayTracer/Rendering/Lighting/Light.hpp"
 #include "RayTracer/Rendering/Lighting/Ray.hpp"
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
 
 /// ---------------------------------------------------------------------------
 /// @subsection Materials
@@ -41,18 +56,23 @@
 #include "RayTracer/Rendering/Primitives/Cube.hpp"
 #include "RayTracer/Rendering/Primitives/Cylinder.hpp"
 #include "RayTracer/Rendering/Primitives/Group.hpp"
+#include "RayTracer/Rendering/Primitives/Instance.hpp"
 #include "RayTracer/Rendering/Primitives/Plane.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 #include "RayTracer/Rendering/Primitives/SmoothTriangle.hpp"
 #include "RayTracer/Rendering/Primitives/Sphere.hpp"
 #include "RayTracer/Rendering/Primitives/Triangle.hpp"
+#include "RayTracer/Rendering/Primitives/TriangleMesh.hpp"
 
 /// ---------------------------------------------------------------------------
 /// @subsection Scene
+#include "RayTracer/Rendering/Scene/CompiledScene.hpp"
+#include "RayTracer/Rendering/Scene/Integrator.hpp"
 #include "RayTracer/Rendering/Scene/World.hpp"
 
 /// ---------------------------------------------------------------------------
 /// @subsection Parsers
+#include "RayTracer/Rendering/Parsers/MeshCache.hpp"
 #include "RayTracer/Rendering/Parsers/OBJParser.hpp"
 
 /// ---------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+#include "RayTracer/Core/Cpu.hpp"
+
+#include "RayTracer/Core/CpuKernels.hpp"
+
+#include <atomic>
+
+#if defined(RAYTRACER_CPU_DISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace RayTracer::Cpu {
+
+namespace {
+
+KernelSet QueryCpu()
+{
+#if defined(RAYTRACER_CPU_DISPATCH)
+#if defined(_MSC_VER)
+  int regs[4]{};
+  __cpuid(regs, 1);
+  const bool sse42 = regs[2] & (1 << 20);
+  const bool osxsave = regs[2] & (1 << 27);
+  // the OS must save the YMM (and ZMM) registers for AVX code to be safe
+  const auto xcr0 = osxsave ? _xgetbv(0) : 0;
+  const bool ymm = (xcr0 & 0x06) == 0x06;
+  const bool zmm = (xcr0 & 0xE6) == 0xE6;
+
+  __cpuidex(regs, 7, 0);
+  const bool avx2 = ymm && (regs[1] & (1 << 5));
+  const bool avx512 = zmm && (regs[1] & (1 << 16));
+#else
+  __builtin_cpu_init();
+  const bool sse42 = __builtin_cpu_supports("sse4.2");
+  const bool avx2 = __builtin_cpu_supports("avx2");
+  const bool avx512 = __builtin_cpu_supports("avx512f");
+#endif
+
+  if (sse42 && avx2 && avx512) {
+    return KernelSet::AVX512;
+  }
+  if (sse42 && avx2) {
+    return KernelSet::AVX2;
+  }
+  if (sse42) {
+    return KernelSet::SSE42;
+  }
+#endif
+  return KernelSet::Baseline;
+}
+
+std::optional<KernelSet> FromString(std::string_view name)
+{
+  for (auto set : { KernelSet::Baseline,
+                    KernelSet::SSE42,
+                    KernelSet::AVX2,
+                    KernelSet::AVX512 }) {
+    if (name == ToString(set)) {
+      return set;
+    }
+  }
+  return std::nullopt;
+}
+
+KernelSet InitialKernelSet()
+{
+  auto set = DetectKernelSet();
+  if (const char* cap = std::getenv("RAYTRACER_KERNEL_SET"); cap) {
+    if (auto requested = FromString(cap); requested && *requested < set) {
+      set = *requested;
+    }
+  }
+  return set;
+}
+
+std::atomic<KernelSet>& ActiveSet()
+{
+  static std::atomic<KernelSet> active{ InitialKernelSet() };
+  return active;
+}
+
+} // namespace
+
+/// ===========================================================================
+/// @section Non-member functions
+/// ===========================================================================
+
+const char* ToString(KernelSet set)
+{
+  switch (set) {
+    case KernelSet::Baseline:
+      return "baseline";
+    case KernelSet::SSE42:
+      return "sse4.2";
+    case KernelSet::AVX2:
+      return "avx2";
+    case KernelSet::AVX512:
+      return "avx512";
+    default:
+      return "unknown";
+  }
+}
+
+KernelSet DetectKernelSet()
+{
+  static const KernelSet detected = QueryCpu();
+  return detected;
+}
+
+std::vector<KernelSet> AvailableKernelSets()
+{
+  std::vector<KernelSet> result;
+  for (auto set = static_cast<int>(KernelSet::Baseline);
+       set <= static_cast<int>(DetectKernelSet());
+       ++set) {
+    result.push_back(static_cast<KernelSet>(set));
+  }
+  return result;
+}
+
+const Kernels& GetKernels(KernelSet set)
+{
+  switch (std::min(set, DetectKernelSet())) {
+#if defined(RAYTRACER_CPU_DISPATCH)
+    case KernelSet::AVX512:
+      return Detail::AVX512Kernels;
+    case KernelSet::AVX2:
+      return Detail::AVX2Kernels;
+    case KernelSet::SSE42:
+      return Detail::SSE42Kernels;
+#endif
+    default:
+      return Detail::BaselineKernels;
+  }
+}
+
+KernelSet ActiveKernelSet()
+{
+  return ActiveSet().load(std::memory_order_relaxed);
+}
+
+const Kernels& ActiveKernels()
+{
+  return GetKernels(ActiveKernelSet());
+}
+
+void SetActiveKernelSet(KernelSet set)
+{
+  ActiveSet().store(std::min(set, DetectKernelSet()), std::memory_order_relaxed);
+}
+
+} // namespace RayTracer::Cpu
@@ -0,0 +1,92 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include <cstdint>
+
+namespace RayTracer::Cpu {
+
+/**
+ * @brief Instruction-set tiers the hot kernels are compiled for, lowest first
+ * @details Baseline is whatever the whole build targets (SSE2 on x86-64, NEON
+ * on AArch64). The other tiers are compiled alongside it and only selected at
+ * runtime when CPUID reports support, so one binary runs on every node.
+ */
+enum class KernelSet
+{
+  Baseline,
+  SSE42,
+  AVX2,
+  AVX512
+};
+
+/// @brief count rays, one array per coordinate, as a RayPacket keeps them
+struct RayLanes
+{
+  const float* originX;
+  const float* originY;
+  const float* originZ;
+  const float* directionX;
+  const float* directionY;
+  const float* directionZ;
+  std::size_t count; // at most 32, one bit of the result each
+};
+
+/// @brief Batched kernels compiled for one KernelSet
+struct Kernels
+{
+  /**
+   * @brief Quantizes linear colors to bytes, as canvas_to_ppm expects
+   * @details Reads and writes four lanes (r, g, b, padding) per pixel.
+   * Each channel becomes (int)clamp(c * 256, 0, 255).
+   */
+  void (*encodeColors)(const float* rgbx, std::size_t count, std::uint8_t* out);
+
+  /// @brief Both roots of each ray with the unit sphere
+  /// @return bit i set if ray i crosses the sphere
+  std::uint32_t (*solveSpheres)(const RayLanes& rays, float* t1, float* t2);
+
+  /// @brief Entry and exit of each ray through the unit cube
+  /// @return bit i set if ray i crosses the cube
+  std::uint32_t (*solveCubes)(const RayLanes& rays,
+                              float* tnear,
+                              float* tfar);
+
+  /**
+   * @brief Moeller-Trumbore test of each ray against one triangle
+   * @param corner p1, e1 and e2, as x, y, z each
+   * @return bit i set if ray i crosses the triangle
+   */
+  std::uint32_t (*solveTriangles)(const float* corner,
+                                  const RayLanes& rays,
+                                  float* t,
+                                  float* u,
+                                  float* v);
+};
+
+/// @section Non-member functions
+
+const char* ToString(KernelSet set);
+
+/// @return the best tier supported by both this CPU and this build
+KernelSet DetectKernelSet();
+
+/// @return every tier up to DetectKernelSet(), lowest first
+std::vector<KernelSet> AvailableKernelSets();
+
+const Kernels& GetKernels(KernelSet set);
+
+/**
+ * @brief Tier used by the renderer
+ * @details That is, by canvas_to_ppm and by the packet kernels of spheres,
+ * cubes and triangles, which serve the compiled scene's packet queries.
+ * Single rays are traced by code compiled for the build's target alone.
+ * Defaults to DetectKernelSet(), capped by the RAYTRACER_KERNEL_SET
+ * environment variable ("baseline", "sse4.2", "avx2" or "avx512") if set.
+ */
+KernelSet ActiveKernelSet();
+const Kernels& ActiveKernels();
+
+/// @brief Selects a tier; requests above DetectKernelSet() are clamped to it
+void SetActiveKernelSet(KernelSet set);
+
+} // namespace RayTracer::Cpu
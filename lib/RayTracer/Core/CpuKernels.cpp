@@ -0,0 +1,337 @@
+#include "RayTracer/Core/CpuKernels.hpp"
+
+#include "RayTracer/Math/Constants.hpp"
+
+#if defined(RAYTRACER_CPU_DISPATCH)
+#include <immintrin.h>
+#endif
+
+namespace RayTracer::Cpu::Detail {
+
+using Math::Constants::EPSILON;
+
+namespace {
+
+/// ===========================================================================
+/// @section Scalar building blocks
+/// min/max are written operand-for-operand like minps/maxps (the second
+/// operand wins on NaN), so every tier produces bit-identical results.
+/// ===========================================================================
+
+inline float MinF(float a, float b)
+{
+  return a < b ? a : b;
+}
+
+inline float MaxF(float a, float b)
+{
+  return a > b ? a : b;
+}
+
+inline std::uint8_t EncodeChannel(float c)
+{
+  const float scaled = MinF(MaxF(c * 256.0f, 0.0f), 255.0f);
+  return static_cast<std::uint8_t>(static_cast<int>(scaled));
+}
+
+/// ===========================================================================
+/// @section Packet intersection
+/// One plain loop across the rays per kernel, written once; each tier below
+/// compiles it for its own vector width. The arithmetic is that of the
+/// scalar Sphere, Cube and Triangle solvers. Inputs and outputs are read
+/// through restrict pointers, so that the loops vectorize without runtime
+/// alias checks.
+/// ===========================================================================
+
+/// @brief The arrays of one RayLanes, promised not to overlap the outputs
+struct Lanes
+{
+  explicit Lanes(const RayLanes& r)
+    : originX(r.originX)
+    , originY(r.originY)
+    , originZ(r.originZ)
+    , directionX(r.directionX)
+    , directionY(r.directionY)
+    , directionZ(r.directionZ)
+    , count(r.count)
+  {}
+
+  const float* __restrict originX;
+  const float* __restrict originY;
+  const float* __restrict originZ;
+  const float* __restrict directionX;
+  const float* __restrict directionY;
+  const float* __restrict directionZ;
+  std::size_t count;
+};
+
+RAYTRACER_FORCE_INLINE std::uint32_t SolveSpheres(const RayLanes& rays,
+                                                  float* __restrict t1,
+                                                  float* __restrict t2)
+{
+  const Lanes r(rays);
+  std::uint32_t hits = 0;
+  for (std::size_t i = 0; i < r.count; ++i) {
+    const auto ox = r.originX[i];
+    const auto oy = r.originY[i];
+    const auto oz = r.originZ[i];
+    const auto dx = r.directionX[i];
+    const auto dy = r.directionY[i];
+    const auto dz = r.directionZ[i];
+
+    const auto a = dx * dx + dy * dy + dz * dz;
+    const auto b = 2 * (dx * ox + dy * oy + dz * oz);
+    const auto c = ox * ox + oy * oy + oz * oz - 1;
+    const auto discriminant = (b * b) - (4 * a * c);
+
+    const auto sqrtd = std::sqrt(std::max(discriminant, 0.0f));
+    t1[i] = (-b - sqrtd) / (2 * a);
+    t2[i] = (-b + sqrtd) / (2 * a);
+    hits |= std::uint32_t{ discriminant >= 0 } << i;
+  }
+  return hits;
+}
+
+RAYTRACER_FORCE_INLINE std::uint32_t SolveCubes(const RayLanes& rays,
+                                                float* __restrict tnear,
+                                                float* __restrict tfar)
+{
+  const Lanes r(rays);
+  // check_axis(), without branches
+  const auto axis = [](float origin, float direction, float& lo, float& hi) {
+    const auto flat = std::abs(direction) < EPSILON;
+    const auto t0 = flat ? (-1 - origin) * INFINITY : (-1 - origin) / direction;
+    const auto t1 = flat ? (1 - origin) * INFINITY : (1 - origin) / direction;
+    const auto swap = t0 > t1;
+    lo = swap ? t1 : t0;
+    hi = swap ? t0 : t1;
+  };
+
+  std::uint32_t hits = 0;
+  for (std::size_t i = 0; i < r.count; ++i) {
+    float xtmin, xtmax, ytmin, ytmax, ztmin, ztmax;
+    axis(r.originX[i], r.directionX[i], xtmin, xtmax);
+    axis(r.originY[i], r.directionY[i], ytmin, ytmax);
+    axis(r.originZ[i], r.directionZ[i], ztmin, ztmax);
+    tnear[i] = std::max(xtmin, std::max(ytmin, ztmin));
+    tfar[i] = std::min(xtmax, std::min(ytmax, ztmax));
+    hits |= std::uint32_t{ tnear[i] <= tfar[i] } << i;
+  }
+  return hits;
+}
+
+RAYTRACER_FORCE_INLINE std::uint32_t SolveTriangles(const float* corner,
+                                                    const RayLanes& rays,
+                                                    float* __restrict t,
+                                                    float* __restrict u,
+                                                    float* __restrict v)
+{
+  const Lanes r(rays);
+  const float p1x = corner[0], p1y = corner[1], p1z = corner[2];
+  const float e1x = corner[3], e1y = corner[4], e1z = corner[5];
+  const float e2x = corner[6], e2y = corner[7], e2z = corner[8];
+
+  std::uint32_t hits = 0;
+  for (std::size_t i = 0; i < r.count; ++i) {
+    const auto dx = r.directionX[i];
+    const auto dy = r.directionY[i];
+    const auto dz = r.directionZ[i];
+
+    // dir_cross_e2
+    const auto ax = dy * e2z - dz * e2y;
+    const auto ay = dz * e2x - dx * e2z;
+    const auto az = dx * e2y - dy * e2x;
+    const auto det = e1x * ax + e1y * ay + e1z * az;
+    const auto f = 1.0f / det;
+
+    // p1_to_origin and origin_cross_e1
+    const auto px = r.originX[i] - p1x;
+    const auto py = r.originY[i] - p1y;
+    const auto pz = r.originZ[i] - p1z;
+    const auto qx = py * e1z - pz * e1y;
+    const auto qy = pz * e1x - px * e1z;
+    const auto qz = px * e1y - py * e1x;
+
+    u[i] = f * (px * ax + py * ay + pz * az);
+    v[i] = f * (dx * qx + dy * qy + dz * qz);
+    t[i] = f * (e2x * qx + e2y * qy + e2z * qz);
+    // & rather than &&, so that every test is a select
+    const bool inside = (std::abs(det) >= EPSILON) & !(u[i] < 0) &
+                        !(u[i] > 1) & !(v[i] < 0) & !((u[i] + v[i]) > 1);
+    hits |= std::uint32_t{ inside } << i;
+  }
+  return hits;
+}
+
+/// ===========================================================================
+/// @section Baseline
+/// ===========================================================================
+
+void EncodeColorsBaseline(const float* rgbx,
+                          std::size_t count,
+                          std::uint8_t* out)
+{
+  for (std::size_t i = 0; i < count * 4; ++i) {
+    out[i] = EncodeChannel(rgbx[i]);
+  }
+}
+
+#if defined(RAYTRACER_CPU_DISPATCH)
+
+/// @brief The packet intersection kernels of one tier
+#define RAYTRACER_PACKET_KERNELS(tier, isa)                                    \
+  RAYTRACER_TARGET(isa)                                                        \
+  std::uint32_t SolveSpheres##tier(const RayLanes& r, float* t1, float* t2)    \
+  {                                                                            \
+    return SolveSpheres(r, t1, t2);                                            \
+  }                                                                            \
+  RAYTRACER_TARGET(isa)                                                        \
+  std::uint32_t SolveCubes##tier(const RayLanes& r, float* t1, float* t2)      \
+  {                                                                            \
+    return SolveCubes(r, t1, t2);                                              \
+  }                                                                            \
+  RAYTRACER_TARGET(isa)                                                        \
+  std::uint32_t SolveTriangles##tier(                                          \
+    const float* corner, const RayLanes& r, float* t, float* u, float* v)      \
+  {                                                                            \
+    return SolveTriangles(corner, r, t, u, v);                                 \
+  }
+
+/// ===========================================================================
+/// @section SSE4.2
+/// ===========================================================================
+
+RAYTRACER_PACKET_KERNELS(SSE42, "sse4.2")
+
+RAYTRACER_TARGET("sse4.2")
+void EncodeColorsSSE42(const float* rgbx, std::size_t count, std::uint8_t* out)
+{
+  const __m128 scale = _mm_set1_ps(256.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 top = _mm_set1_ps(255.0f);
+
+  // four pixels (16 channels) per iteration
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i px[4];
+    for (int k = 0; k < 4; ++k) {
+      const __m128 c = _mm_loadu_ps(rgbx + (i + k) * 4);
+      px[k] = _mm_cvttps_epi32(
+        _mm_min_ps(_mm_max_ps(_mm_mul_ps(c, scale), zero), top));
+    }
+    const __m128i words0 = _mm_packs_epi32(px[0], px[1]);
+    const __m128i words1 = _mm_packs_epi32(px[2], px[3]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4),
+                     _mm_packus_epi16(words0, words1));
+  }
+  for (i *= 4; i < count * 4; ++i) {
+    out[i] = EncodeChannel(rgbx[i]);
+  }
+}
+
+/// ===========================================================================
+/// @section AVX2
+/// ===========================================================================
+
+RAYTRACER_PACKET_KERNELS(AVX2, "avx2")
+
+RAYTRACER_TARGET("avx2")
+void EncodeColorsAVX2(const float* rgbx, std::size_t count, std::uint8_t* out)
+{
+  const __m256 scale = _mm256_set1_ps(256.0f);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 top = _mm256_set1_ps(255.0f);
+  // packs/packus work per 128-bit half, leaving pixels as 0 2 4 6 1 3 5 7
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  // eight pixels (32 channels) per iteration
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i px[4];
+    for (int k = 0; k < 4; ++k) {
+      const __m256 c = _mm256_loadu_ps(rgbx + (i + k * 2) * 4);
+      px[k] = _mm256_cvttps_epi32(
+        _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(c, scale), zero), top));
+    }
+    const __m256i words0 = _mm256_packs_epi32(px[0], px[1]);
+    const __m256i words1 = _mm256_packs_epi32(px[2], px[3]);
+    const __m256i bytes = _mm256_packus_epi16(words0, words1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4),
+                        _mm256_permutevar8x32_epi32(bytes, order));
+  }
+  for (i *= 4; i < count * 4; ++i) {
+    out[i] = EncodeChannel(rgbx[i]);
+  }
+}
+
+/// ===========================================================================
+/// @section AVX-512
+/// GCC's unmasked AVX-512 intrinsics pass a deliberately undefined register
+/// as the unused merge source, which -Wmaybe-uninitialized reports.
+/// ===========================================================================
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+RAYTRACER_PACKET_KERNELS(AVX512, "avx512f")
+
+RAYTRACER_TARGET("avx512f")
+void EncodeColorsAVX512(const float* rgbx,
+                        std::size_t count,
+                        std::uint8_t* out)
+{
+  const __m512 scale = _mm512_set1_ps(256.0f);
+  const __m512 zero = _mm512_setzero_ps();
+  const __m512 top = _mm512_set1_ps(255.0f);
+
+  // four pixels (16 channels) per register
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m512 c = _mm512_loadu_ps(rgbx + i * 4);
+    const __m512i channels = _mm512_cvttps_epi32(
+      _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(c, scale), zero), top));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4),
+                     _mm512_cvtusepi32_epi8(channels));
+  }
+  for (i *= 4; i < count * 4; ++i) {
+    out[i] = EncodeChannel(rgbx[i]);
+  }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#undef RAYTRACER_PACKET_KERNELS
+
+#endif // RAYTRACER_CPU_DISPATCH
+
+} // namespace
+
+/// ===========================================================================
+/// @section Kernel tables
+/// ===========================================================================
+
+const Kernels BaselineKernels{ EncodeColorsBaseline,
+                               SolveSpheres,
+                               SolveCubes,
+                               SolveTriangles };
+
+#if defined(RAYTRACER_CPU_DISPATCH)
+const Kernels SSE42Kernels{ EncodeColorsSSE42,
+                            SolveSpheresSSE42,
+                            SolveCubesSSE42,
+                            SolveTrianglesSSE42 };
+const Kernels AVX2Kernels{ EncodeColorsAVX2,
+                           SolveSpheresAVX2,
+                           SolveCubesAVX2,
+                           SolveTrianglesAVX2 };
+const Kernels AVX512Kernels{ EncodeColorsAVX512,
+                             SolveSpheresAVX512,
+                             SolveCubesAVX512,
+                             SolveTrianglesAVX512 };
+#endif
+
+} // namespace RayTracer::Cpu::Detail
@@ -0,0 +1,36 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Core/Cpu.hpp"
+
+/// ===========================================================================
+/// @section Build configuration
+/// Tiers above Baseline need x86 intrinsics and, outside MSVC, per-function
+/// target attributes. RAYTRACER_NO_CPU_DISPATCH keeps only the baseline.
+/// A loop shared by every tier is marked RAYTRACER_FORCE_INLINE, so that it
+/// is compiled into each tier's kernel under that kernel's target.
+/// ===========================================================================
+
+#if !defined(RAYTRACER_NO_CPU_DISPATCH) &&                                     \
+  (defined(__x86_64__) || defined(_M_X64))
+#define RAYTRACER_CPU_DISPATCH 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define RAYTRACER_TARGET(isa)
+#define RAYTRACER_FORCE_INLINE __forceinline
+#else
+#define RAYTRACER_TARGET(isa) __attribute__((target(isa)))
+#define RAYTRACER_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace RayTracer::Cpu::Detail {
+
+extern const Kernels BaselineKernels;
+#if defined(RAYTRACER_CPU_DISPATCH)
+extern const Kernels SSE42Kernels;
+extern const Kernels AVX2Kernels;
+extern const Kernels AVX512Kernels;
+#endif
+
+} // namespace RayTracer::Cpu::Detail
@@ -0,0 +1,199 @@
+#include "RayTracer/Core/ThreadPool.hpp"
+
+namespace RayTracer::Core {
+
+namespace {
+
+/// the pool whose task the current thread is running, if any
+thread_local const ThreadPool* CurrentPool = nullptr;
+
+} // namespace
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Special member functions
+/// ---------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  m_Queues.reserve(threadCount);
+  for (std::size_t i = 0; i < threadCount; ++i) {
+    m_Queues.push_back(std::make_unique<Queue>());
+  }
+  m_Workers.reserve(threadCount - 1);
+  for (std::size_t i = 1; i < threadCount; ++i) {
+    m_Workers.emplace_back([this, i] { Work(i); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lock(m_WakeMutex);
+    m_Stopping = true;
+  }
+  m_Wake.notify_all();
+  for (auto& worker : m_Workers) {
+    worker.join();
+  }
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+std::size_t ThreadPool::GetThreadCount() const
+{
+  return m_Queues.size();
+}
+
+std::size_t ThreadPool::GetStealCount() const
+{
+  return m_Steals.load(std::memory_order_relaxed);
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Operations
+/// ---------------------------------------------------------------------------
+
+void ThreadPool::ParallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& task)
+{
+  if (count == 0) {
+    return;
+  }
+  // a nested loop would wait on threads that may be waiting on it
+  if (CurrentPool == this || m_Workers.empty()) {
+    for (std::size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::lock_guard loop(m_LoopMutex);
+  m_Task = &task;
+  m_Error = nullptr;
+  m_Remaining.store(count, std::memory_order_relaxed);
+
+  // contiguous blocks, so each thread starts on neighbouring items
+  const auto threads = m_Queues.size();
+  for (std::size_t q = 0; q < threads; ++q) {
+    std::lock_guard lock(m_Queues[q]->mutex);
+    for (auto i = q * count / threads; i < (q + 1) * count / threads; ++i) {
+      m_Queues[q]->items.push_back(i);
+    }
+  }
+  {
+    std::lock_guard lock(m_WakeMutex);
+    ++m_Generation;
+  }
+  m_Wake.notify_all();
+
+  const auto* outer = CurrentPool;
+  CurrentPool = this;
+  while (RunOne(0)) {
+  }
+  CurrentPool = outer;
+  {
+    std::unique_lock lock(m_WakeMutex);
+    m_Done.wait(lock, [&] {
+      return m_Remaining.load(std::memory_order_acquire) == 0;
+    });
+  }
+  m_Task = nullptr;
+
+  if (m_Error) {
+    std::rethrow_exception(m_Error);
+  }
+}
+
+ThreadPool& ThreadPool::GetDefault()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+void ThreadPool::Work(std::size_t self)
+{
+  CurrentPool = this;
+  std::uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(m_WakeMutex);
+      m_Wake.wait(lock, [&] { return m_Stopping || m_Generation != seen; });
+      if (m_Stopping) {
+        return;
+      }
+      seen = m_Generation;
+    }
+    while (RunOne(self)) {
+    }
+  }
+}
+
+bool ThreadPool::RunOne(std::size_t self)
+{
+  auto item = Pop(self);
+  if (!item) {
+    item = Steal(self);
+    if (!item) {
+      return false;
+    }
+  }
+
+  try {
+    (*m_Task)(*item);
+  } catch (...) {
+    std::lock_guard lock(m_ErrorMutex);
+    if (!m_Error) {
+      m_Error = std::current_exception();
+    }
+  }
+
+  if (m_Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    std::lock_guard lock(m_WakeMutex);
+    m_Done.notify_all();
+  }
+  return true;
+}
+
+std::optional<std::size_t> ThreadPool::Pop(std::size_t self)
+{
+  auto& queue = *m_Queues[self];
+  std::lock_guard lock(queue.mutex);
+  if (queue.items.empty()) {
+    return std::nullopt;
+  }
+  const auto item = queue.items.front();
+  queue.items.pop_front();
+  return item;
+}
+
+std::optional<std::size_t> ThreadPool::Steal(std::size_t self)
+{
+  // from the back, the items the owner would reach last
+  const auto threads = m_Queues.size();
+  for (std::size_t offset = 1; offset < threads; ++offset) {
+    auto& victim = *m_Queues[(self + offset) % threads];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.items.empty()) {
+      const auto item = victim.items.back();
+      victim.items.pop_back();
+      m_Steals.fetch_add(1, std::memory_order_relaxed);
+      return item;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace RayTracer::Core
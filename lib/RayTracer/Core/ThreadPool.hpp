@@ -0,0 +1,85 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace RayTracer::Core {
+
+/**
+ * @brief Persistent worker threads that share loops by work stealing
+ * @details The threads are started once and sleep between loops, so a loop
+ * costs a wake-up rather than a thread team. ParallelFor() deals the indices
+ * out in contiguous blocks, one per thread, to keep neighbouring items (such
+ * as neighbouring tiles) on one core; each thread takes its own from the
+ * front, and a thread that runs dry steals from the back of another's.
+ * The calling thread works as one of them.
+ */
+class ThreadPool
+{
+public:
+  /// @section Member functions
+  /// @subsection Special member functions
+  /// @param threadCount including the caller; 0 for one per hardware thread
+  explicit ThreadPool(std::size_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @subsection Observers
+  /// @return the threads a loop runs on, including the caller
+  std::size_t GetThreadCount() const;
+  /// @return the items run by a thread other than the one dealt them
+  std::size_t GetStealCount() const;
+
+  /// @subsection Operations
+  /**
+   * @brief Calls task(i) once for every i in [0, count), in parallel, and
+   * returns when all calls have
+   * @details Loops run one at a time; a loop started from inside a task
+   * runs on the calling thread alone.
+   * @throw the first exception a call threw, once every call has returned
+   */
+  void ParallelFor(std::size_t count,
+                   const std::function<void(std::size_t)>& task);
+
+  /// @brief The pool shared by renders, with a thread per hardware thread
+  static ThreadPool& GetDefault();
+
+private:
+  struct alignas(64) Queue
+  {
+    std::mutex mutex;
+    std::deque<std::size_t> items;
+  };
+
+  void Work(std::size_t self);
+  /// @brief Runs one of the loop's items, own or stolen
+  /// @return false if none was left
+  bool RunOne(std::size_t self);
+  std::optional<std::size_t> Pop(std::size_t self);
+  std::optional<std::size_t> Steal(std::size_t self);
+
+  std::vector<std::unique_ptr<Queue>> m_Queues; // one per thread, caller's 0
+  std::vector<std::thread> m_Workers;
+
+  std::mutex m_LoopMutex; // held for the whole of ParallelFor()
+  const std::function<void(std::size_t)>* m_Task{ nullptr };
+  std::atomic<std::size_t> m_Remaining{ 0 };
+  std::atomic<std::size_t> m_Steals{ 0 };
+  std::exception_ptr m_Error;
+  std::mutex m_ErrorMutex;
+
+  std::mutex m_WakeMutex;
+  std::condition_variable m_Wake; // a loop started, or the pool stops
+  std::condition_variable m_Done; // m_Remaining dropped to 0
+  std::uint64_t m_Generation{ 0 };
+  bool m_Stopping{ false };
+};
+
+} // namespace RayTracer::Core
@@ -142,30 +142,155 @@ inline float cofactor(const Matrix<ROWS, COLS>& A,
 template<std::size_t ROWS, std::size_t COLS>
 inline bool isInvertible(const Matrix<ROWS, COLS>& A)
 {
-  return !determinant(A) == 0;
+  return determinant(A) != 0;
 }
 
 template<std::size_t ROWS, std::size_t COLS>
 inline Matrix<ROWS, COLS> inverse(const Matrix<ROWS, COLS>& A)
 {
-  if (isInvertible(A)) {
-    Matrix<ROWS, COLS> R;
+  const auto det = determinant(A);
+  if (det == 0) {
+    throw std::runtime_error("A is not invertible");
+  }
 
-    for (auto row = 0; row < ROWS; ++row) {
-      for (auto col = 0; col < COLS; ++col) {
-        auto c = cofactor(A, row, col);
+  Matrix<ROWS, COLS> R;
+  for (auto row = 0; row < ROWS; ++row) {
+    for (auto col = 0; col < COLS; ++col) {
+      auto c = cofactor(A, row, col);
 
-        // note that "col, row" here, instead of "row, col",
-        // accomplishes the transpose operation!
-        R[col][row] = c / determinant(A);
-      }
+      // note that "col, row" here, instead of "row, col",
+      // accomplishes the transpose operation!
+      R[col][row] = c / det;
     }
+  }
+  return R;
+}
 
-    return R;
+/// ---------------------------------------------------------------------------
+/// @subsection 4x4 specializations
+/// ---------------------------------------------------------------------------
 
-  } else {
+/**
+ * @brief 2x2 minors of the top two rows (s) and bottom two rows (c) of A.
+ * @details Every 4x4 cofactor is a combination of these twelve values
+ * (Laplace expansion along the row pairs), so they are computed once.
+ */
+struct Mat4Minors
+{
+  float s0, s1, s2, s3, s4, s5;
+  float c0, c1, c2, c3, c4, c5;
+
+  explicit Mat4Minors(const mat4& A)
+    : s0(A[0][0] * A[1][1] - A[1][0] * A[0][1])
+    , s1(A[0][0] * A[1][2] - A[1][0] * A[0][2])
+    , s2(A[0][0] * A[1][3] - A[1][0] * A[0][3])
+    , s3(A[0][1] * A[1][2] - A[1][1] * A[0][2])
+    , s4(A[0][1] * A[1][3] - A[1][1] * A[0][3])
+    , s5(A[0][2] * A[1][3] - A[1][2] * A[0][3])
+    , c0(A[2][0] * A[3][1] - A[3][0] * A[2][1])
+    , c1(A[2][0] * A[3][2] - A[3][0] * A[2][2])
+    , c2(A[2][0] * A[3][3] - A[3][0] * A[2][3])
+    , c3(A[2][1] * A[3][2] - A[3][1] * A[2][2])
+    , c4(A[2][1] * A[3][3] - A[3][1] * A[2][3])
+    , c5(A[2][2] * A[3][3] - A[3][2] * A[2][3])
+  {}
+
+  float Determinant() const
+  {
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  }
+};
+
+inline float determinant(const mat4& A)
+{
+  return Mat4Minors(A).Determinant();
+}
+
+/** @return true if the bottom row of A is (0, 0, 0, 1) */
+inline bool isAffine(const mat4& A)
+{
+  return A[3][0] == 0 && A[3][1] == 0 && A[3][2] == 0 && A[3][3] == 1;
+}
+
+/**
+ * @brief Inverse of an affine transformation [ M t ; 0 1 ]
+ * @details inverse(M) comes from the 3x3 adjugate and the translation is
+ * -inverse(M) * t. The bottom row of A is assumed to be (0, 0, 0, 1).
+ */
+inline mat4 affine_inverse(const mat4& A)
+{
+  const float m00 = A[1][1] * A[2][2] - A[1][2] * A[2][1];
+  const float m01 = A[0][2] * A[2][1] - A[0][1] * A[2][2];
+  const float m02 = A[0][1] * A[1][2] - A[0][2] * A[1][1];
+  const float det = A[0][0] * m00 + A[1][0] * m01 + A[2][0] * m02;
+  if (det == 0) {
     throw std::runtime_error("A is not invertible");
   }
+  const float invDet = 1.0f / det;
+
+  mat4 R;
+  R[0][0] = m00 * invDet;
+  R[0][1] = m01 * invDet;
+  R[0][2] = m02 * invDet;
+  R[1][0] = (A[1][2] * A[2][0] - A[1][0] * A[2][2]) * invDet;
+  R[1][1] = (A[0][0] * A[2][2] - A[0][2] * A[2][0]) * invDet;
+  R[1][2] = (A[0][2] * A[1][0] - A[0][0] * A[1][2]) * invDet;
+  R[2][0] = (A[1][0] * A[2][1] - A[1][1] * A[2][0]) * invDet;
+  R[2][1] = (A[0][1] * A[2][0] - A[0][0] * A[2][1]) * invDet;
+  R[2][2] = (A[0][0] * A[1][1] - A[0][1] * A[1][0]) * invDet;
+
+  for (auto row = 0; row < 3; ++row) {
+    R[row][3] = -(R[row][0] * A[0][3] + //
+                  R[row][1] * A[1][3] + //
+                  R[row][2] * A[2][3]);
+  }
+  R[3][3] = 1;
+  return R;
+}
+
+/**
+ * @brief Closed-form (adjugate) inverse of a 4x4 matrix
+ * @details Affine matrices, which cover every transform built from
+ * Transformations.hpp, take the cheaper affine_inverse() path.
+ * The cofactor expansion remains reachable as inverse<4, 4>(A).
+ */
+inline mat4 inverse(const mat4& A)
+{
+  if (isAffine(A)) {
+    return affine_inverse(A);
+  }
+
+  const Mat4Minors m(A);
+  const float det = m.Determinant();
+  if (det == 0) {
+    throw std::runtime_error("A is not invertible");
+  }
+
+  // clang-format off
+  mat4 R = {
+    ( A[1][1] * m.c5 - A[1][2] * m.c4 + A[1][3] * m.c3) / det,
+    (-A[0][1] * m.c5 + A[0][2] * m.c4 - A[0][3] * m.c3) / det,
+    ( A[3][1] * m.s5 - A[3][2] * m.s4 + A[3][3] * m.s3) / det,
+    (-A[2][1] * m.s5 + A[2][2] * m.s4 - A[2][3] * m.s3) / det,
+
+    (-A[1][0] * m.c5 + A[1][2] * m.c2 - A[1][3] * m.c1) / det,
+    ( A[0][0] * m.c5 - A[0][2] * m.c2 + A[0][3] * m.c1) / det,
+    (-A[3][0] * m.s5 + A[3][2] * m.s2 - A[3][3] * m.s1) / det,
+    ( A[2][0] * m.s5 - A[2][2] * m.s2 + A[2][3] * m.s1) / det,
+
+    ( A[1][0] * m.c4 - A[1][1] * m.c2 + A[1][3] * m.c0) / det,
+    (-A[0][0] * m.c4 + A[0][1] * m.c2 - A[0][3] * m.c0) / det,
+    ( A[3][0] * m.s4 - A[3][1] * m.s2 + A[3][3] * m.s0) / det,
+    (-A[2][0] * m.s4 + A[2][1] * m.s2 - A[2][3] * m.s0) / det,
+
+    (-A[1][0] * m.c3 + A[1][1] * m.c1 - A[1][2] * m.c0) / det,
+    ( A[0][0] * m.c3 - A[0][1] * m.c1 + A[0][2] * m.c0) / det,
+    (-A[3][0] * m.s3 + A[3][1] * m.s1 - A[3][2] * m.s0) / det,
+    ( A[2][0] * m.s3 - A[2][1] * m.s1 + A[2][2] * m.s0) / det
+  };
+  // clang-format on
+
+  return R;
 }
 
 } // namespace RayTracer::Math
\ No newline at end of file
@@ -0,0 +1,223 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+/// ===========================================================================
+/// @section Backend selection
+/// SSE2 is part of the x86-64 baseline and NEON of AArch64, so neither needs
+/// extra compiler flags. Define RAYTRACER_NO_SIMD to force the scalar code.
+/// ===========================================================================
+
+#if !defined(RAYTRACER_NO_SIMD) &&                                             \
+  (defined(__SSE2__) || defined(_M_X64) ||                                     \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define RAYTRACER_SIMD_SSE 1
+#include <emmintrin.h>
+#elif !defined(RAYTRACER_NO_SIMD) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define RAYTRACER_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define RAYTRACER_SIMD_SCALAR 1
+#endif
+
+namespace RayTracer::Math {
+
+/**
+ * @brief Four packed floats backed by one SSE/NEON register
+ * @details Load() and Store() expect 16-byte aligned addresses, which holds
+ * for every alignas(16) Tuple and Color.
+ */
+struct Float4
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  __m128 v;
+#elif defined(RAYTRACER_SIMD_NEON)
+  float32x4_t v;
+#else
+  float v[4];
+#endif
+
+  static Float4 Load(const float* p)
+  {
+#if defined(RAYTRACER_SIMD_SSE)
+    return { _mm_load_ps(p) };
+#elif defined(RAYTRACER_SIMD_NEON)
+    return { vld1q_f32(p) };
+#else
+    return { { p[0], p[1], p[2], p[3] } };
+#endif
+  }
+
+  static Float4 Splat(float s)
+  {
+#if defined(RAYTRACER_SIMD_SSE)
+    return { _mm_set1_ps(s) };
+#elif defined(RAYTRACER_SIMD_NEON)
+    return { vdupq_n_f32(s) };
+#else
+    return { { s, s, s, s } };
+#endif
+  }
+
+  void Store(float* p) const
+  {
+#if defined(RAYTRACER_SIMD_SSE)
+    _mm_store_ps(p, v);
+#elif defined(RAYTRACER_SIMD_NEON)
+    vst1q_f32(p, v);
+#else
+    p[0] = v[0];
+    p[1] = v[1];
+    p[2] = v[2];
+    p[3] = v[3];
+#endif
+  }
+};
+
+/// ===========================================================================
+/// @section Non-member functions
+/// ===========================================================================
+
+#if defined(RAYTRACER_SIMD_SCALAR)
+#define RAYTRACER_FLOAT4_LANEWISE(op)                                          \
+  return { { a.v[0] op b.v[0], a.v[1] op b.v[1], a.v[2] op b.v[2],            \
+             a.v[3] op b.v[3] } }
+#endif
+
+inline Float4 operator+(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_add_ps(a.v, b.v) };
+#elif defined(RAYTRACER_SIMD_NEON)
+  return { vaddq_f32(a.v, b.v) };
+#else
+  RAYTRACER_FLOAT4_LANEWISE(+);
+#endif
+}
+
+inline Float4 operator-(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_sub_ps(a.v, b.v) };
+#elif defined(RAYTRACER_SIMD_NEON)
+  return { vsubq_f32(a.v, b.v) };
+#else
+  RAYTRACER_FLOAT4_LANEWISE(-);
+#endif
+}
+
+inline Float4 operator-(Float4 a)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)) };
+#elif defined(RAYTRACER_SIMD_NEON)
+  return { vnegq_f32(a.v) };
+#else
+  return { { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } };
+#endif
+}
+
+inline Float4 operator*(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_mul_ps(a.v, b.v) };
+#elif defined(RAYTRACER_SIMD_NEON)
+  return { vmulq_f32(a.v, b.v) };
+#else
+  RAYTRACER_FLOAT4_LANEWISE(*);
+#endif
+}
+
+inline Float4 operator/(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_div_ps(a.v, b.v) };
+#elif defined(RAYTRACER_SIMD_NEON) && defined(__aarch64__)
+  return { vdivq_f32(a.v, b.v) };
+#else
+  alignas(16) float l[4];
+  alignas(16) float r[4];
+  a.Store(l);
+  b.Store(r);
+  return { { l[0] / r[0], l[1] / r[1], l[2] / r[2], l[3] / r[3] } };
+#endif
+}
+
+inline Float4 Min(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_min_ps(a.v, b.v) };
+#elif defined(RAYTRACER_SIMD_NEON)
+  return { vminq_f32(a.v, b.v) };
+#else
+  return { { std::min(a.v[0], b.v[0]),
+             std::min(a.v[1], b.v[1]),
+             std::min(a.v[2], b.v[2]),
+             std::min(a.v[3], b.v[3]) } };
+#endif
+}
+
+inline Float4 Max(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_max_ps(a.v, b.v) };
+#elif defined(RAYTRACER_SIMD_NEON)
+  return { vmaxq_f32(a.v, b.v) };
+#else
+  return { { std::max(a.v[0], b.v[0]),
+             std::max(a.v[1], b.v[1]),
+             std::max(a.v[2], b.v[2]),
+             std::max(a.v[3], b.v[3]) } };
+#endif
+}
+
+/** @return a bit mask with bit i set where lane i of a <= lane i of b */
+inline int LessEqualMask(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return _mm_movemask_ps(_mm_cmple_ps(a.v, b.v));
+#else
+  alignas(16) float l[4];
+  alignas(16) float r[4];
+  a.Store(l);
+  b.Store(r);
+  return (l[0] <= r[0] ? 1 : 0) | (l[1] <= r[1] ? 2 : 0) |
+         (l[2] <= r[2] ? 4 : 0) | (l[3] <= r[3] ? 8 : 0);
+#endif
+}
+
+/** @return the sum of all four lanes of a * b */
+inline float Dot(Float4 a, Float4 b)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  const __m128 m = _mm_mul_ps(a.v, b.v);
+  const __m128 swapped = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1));
+  const __m128 pairs = _mm_add_ps(m, swapped); // (x+y, x+y, z+w, z+w)
+  const __m128 high = _mm_movehl_ps(swapped, pairs);
+  return _mm_cvtss_f32(_mm_add_ss(pairs, high));
+#elif defined(RAYTRACER_SIMD_NEON) && defined(__aarch64__)
+  return vaddvq_f32(vmulq_f32(a.v, b.v));
+#else
+  alignas(16) float l[4];
+  alignas(16) float r[4];
+  a.Store(l);
+  b.Store(r);
+  return (l[0] * r[0]) + (l[1] * r[1]) + (l[2] * r[2]) + (l[3] * r[3]);
+#endif
+}
+
+/** @return (a.y, a.z, a.x, a.w) */
+inline Float4 RotateXYZ(Float4 a)
+{
+#if defined(RAYTRACER_SIMD_SSE)
+  return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 0, 2, 1)) };
+#else
+  alignas(16) float l[4];
+  a.Store(l);
+  alignas(16) const float r[4] = { l[1], l[2], l[0], l[3] };
+  return Float4::Load(r);
+#endif
+}
+
+#undef RAYTRACER_FLOAT4_LANEWISE
+
+} // namespace RayTracer::Math
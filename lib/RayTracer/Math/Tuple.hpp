@@ -3,12 +3,26 @@
 
 // Project Library
 #include "RayTracer/Math/Constants.hpp"
+#include "RayTracer/Math/SIMD.hpp"
 
 namespace RayTracer::Math {
 
-struct Tuple
+/**
+ * @brief Point (w = 1) or vector (w = 0) in homogeneous coordinates
+ * @details 16-byte aligned so the arithmetic below maps onto one Float4.
+ */
+struct alignas(16) Tuple
 {
-  Tuple(float x_, float y_, float z_, float w_);
+  Tuple(float x_, float y_, float z_, float w_)
+    : x(x_)
+    , y(y_)
+    , z(z_)
+    , w(w_)
+  {}
+  explicit Tuple(Float4 v) { v.Store(&x); }
+
+  Float4 Lanes() const { return Float4::Load(&x); }
+
   float x;
   float y;
   float z;
@@ -19,44 +33,109 @@ struct Tuple
 
 /// @subsection Creation Methods
 
-Tuple Point(float x, float y, float z);
-Tuple Vector(float x, float y, float z);
+inline Tuple Point(float x, float y, float z)
+{
+  return Tuple(x, y, z, 1.0f);
+}
+
+inline Tuple Vector(float x, float y, float z)
+{
+  return Tuple(x, y, z, 0.0f);
+}
 
-bool isPoint(Tuple aTuple);  // Useless API (only used in tests)
-bool isVector(Tuple aTuple); // Useless API (only used in tests)
+// Useless API (only used in tests)
+inline bool isPoint(Tuple aTuple)
+{
+  return aTuple.w == 1.0f;
+}
+
+// Useless API (only used in tests)
+inline bool isVector(Tuple aTuple)
+{
+  return aTuple.w == 0.0f;
+}
 
 /// @subsection Arithmetic operators
 
 std::ostream& operator<<(std::ostream& os, const Tuple& aTuple);
 
-Tuple operator+(const Tuple& lhs, const Tuple& rhs);
+inline Tuple operator+(const Tuple& lhs, const Tuple& rhs)
+{
+  return Tuple(lhs.Lanes() + rhs.Lanes());
+}
 
-Tuple operator-(const Tuple& lhs, const Tuple& rhs);
+inline Tuple operator-(const Tuple& lhs, const Tuple& rhs)
+{
+  return Tuple(lhs.Lanes() - rhs.Lanes());
+}
 
-Tuple operator-(const Tuple& rhs); // Negate
+// Negate
+inline Tuple operator-(const Tuple& rhs)
+{
+  return Tuple(-rhs.Lanes());
+}
 
-Tuple operator*(const Tuple& lhs, float s);
+inline Tuple operator*(const Tuple& lhs, float s)
+{
+  return Tuple(lhs.Lanes() * Float4::Splat(s));
+}
 
-Tuple operator*(float s, const Tuple& rhs);
+inline Tuple operator*(float s, const Tuple& rhs)
+{
+  return rhs * s;
+}
 
-Tuple operator*(const Tuple& lhs, const Tuple& rhs); // Hadamard product
+// Hadamard product
+inline Tuple operator*(const Tuple& lhs, const Tuple& rhs)
+{
+  return Tuple(lhs.Lanes() * rhs.Lanes());
+}
 
-Tuple operator/(const Tuple& lhs, float s);
+inline Tuple operator/(const Tuple& lhs, float s)
+{
+  return Tuple(lhs.Lanes() / Float4::Splat(s));
+}
 
 /// @subsection Logic operators
 
-bool operator==(const Tuple& lhs, const Tuple& rhs);
+inline bool operator==(const Tuple& lhs, const Tuple& rhs)
+{
+  using namespace Constants;
+  return std::abs(lhs.x - rhs.x) < EPSILON &&
+         std::abs(lhs.y - rhs.y) < EPSILON &&
+         std::abs(lhs.z - rhs.z) < EPSILON &&
+         std::abs(lhs.w - rhs.w) < EPSILON; //
+}
 
 /// @subsection Vector API
 
-float magnitude(Tuple aTuple);
-
-Tuple normalize(Tuple v);
+inline float dot(const Tuple& a, const Tuple& b)
+{
+  return Dot(a.Lanes(), b.Lanes());
+}
 
-float dot(const Tuple& a, const Tuple& b);
+inline float magnitude(Tuple v)
+{
+  return std::sqrt(dot(v, v));
+}
 
-Tuple cross(const Tuple& a, const Tuple& b);
+inline Tuple normalize(Tuple v)
+{
+  return v / magnitude(v);
+}
 
-Tuple reflect(const Tuple& aVector, const Tuple& aNormal);
+inline Tuple cross(const Tuple& a, const Tuple& b)
+{
+  // a.yzx * b.zxy - a.zxy * b.yzx, computed as one rotation of the result;
+  // the w lane cancels to 0 so the result is a vector
+  const auto l = a.Lanes();
+  const auto r = b.Lanes();
+  return Tuple(RotateXYZ(l * RotateXYZ(r) - RotateXYZ(l) * r));
+}
+
+inline Tuple reflect(const Tuple& aVector, const Tuple& aNormal)
+{
+  return aVector - aNormal * 2 * dot(aVector, aNormal);
+}
 
 } // namespace RayTracer::Math
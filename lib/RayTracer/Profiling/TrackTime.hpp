@@ -46,5 +46,30 @@ private:
   TimePoint m_End{};
 };
 
+/**
+ * @brief Silent counterpart of Timer, for code that stores its own timings
+ */
+class Stopwatch
+{
+public:
+  using Clock = Timer::Clock;
+
+  Stopwatch()
+    : m_Start(Clock::now())
+  {}
+
+  void reset() { m_Start = Clock::now(); }
+
+  double elapsedMilliseconds() const
+  {
+    const std::chrono::duration<double, std::milli> diff =
+      Clock::now() - m_Start;
+    return diff.count();
+  }
+
+private:
+  Timer::TimePoint m_Start;
+};
+
 } // namespace Profiling
 } // namespace RayTracer
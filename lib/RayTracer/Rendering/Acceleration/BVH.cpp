@@ -0,0 +1,410 @@
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+
+#include "RayTracer/Core/Assertions.hpp"
+#include "RayTracer/Profiling/TrackTime.hpp"
+
+#include <atomic>
+#include <numeric>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace RayTracer::Rendering::Acceleration {
+
+namespace {
+
+float AxisOf(const Tuple& t, int axis)
+{
+  return axis == 0 ? t.x : axis == 1 ? t.y : t.z;
+}
+
+bool InParallelRegion()
+{
+#ifdef _OPENMP
+  return omp_in_parallel() != 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+/// @brief State shared by every task of one Build()
+struct BVH::BuildContext
+{
+  /// Nodes as the tasks create them; Flatten() then lays them out depth-first
+  struct TreeNode
+  {
+    BoundingBox bounds;
+    std::uint32_t left{ 0 };  // interior nodes only
+    std::uint32_t first{ 0 }; // leaves only
+    std::uint32_t count{ 0 }; // 0 for interior nodes
+  };
+
+  const std::vector<BoundingBox>& primitiveBounds;
+  const std::vector<Tuple>& centroids;
+  BuildSettings settings;
+  std::vector<TreeNode> tree{};
+  std::atomic<std::uint32_t> nextNode{ 1 };
+  std::atomic<std::uint32_t> leafCount{ 0 };
+  std::atomic<std::uint32_t> depth{ 0 };
+};
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+bool BVH::IsEmpty() const
+{
+  return m_Nodes.empty();
+}
+
+const BoundingBox& BVH::GetBounds() const
+{
+  return m_Bounds;
+}
+
+const std::vector<BVH::Node>& BVH::GetNodes() const
+{
+  return m_Nodes;
+}
+
+const std::vector<std::uint32_t>& BVH::GetPrimitiveIndices() const
+{
+  return m_Indices;
+}
+
+const BVH::BuildStats& BVH::GetBuildStats() const
+{
+  return m_Stats;
+}
+
+float BVH::GetSAHCost() const
+{
+  if (m_Nodes.empty()) {
+    return 0.0f;
+  }
+  const auto rootArea = surface_area(m_Bounds);
+  if (!(rootArea > 0.0f) || !std::isfinite(rootArea)) {
+    return static_cast<float>(m_Indices.size());
+  }
+
+  float cost = 0.0f;
+  for (const auto& node : m_Nodes) {
+    const auto probability = surface_area(node.Bounds()) / rootArea;
+    cost += probability * (node.IsLeaf() ? node.count : 1.0f);
+  }
+  return cost;
+}
+
+bool BVH::IsDegraded(float costLimit) const
+{
+  return GetSAHCost() > costLimit * m_Stats.sahCost;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+void BVH::Build(const std::vector<BoundingBox>& primitiveBounds)
+{
+  Build(primitiveBounds, BuildSettings{});
+}
+
+void BVH::Build(const std::vector<BoundingBox>& primitiveBounds,
+                const BuildSettings& settings)
+{
+  Profiling::Stopwatch stopwatch;
+  Clear();
+  if (primitiveBounds.empty()) {
+    return;
+  }
+
+  const auto count = static_cast<std::uint32_t>(primitiveBounds.size());
+  std::vector<Tuple> centroids;
+  centroids.reserve(count);
+  for (const auto& box : primitiveBounds) {
+    centroids.push_back(centroid(box));
+  }
+
+  m_Indices.resize(count);
+  std::iota(m_Indices.begin(), m_Indices.end(), 0U);
+
+  BuildContext context{ primitiveBounds, centroids, settings };
+  context.settings.maxLeafSize = std::max(context.settings.maxLeafSize, 1U);
+  context.settings.binCount =
+    std::clamp(context.settings.binCount, 2U, MaxBinCount);
+  // a binary tree with one primitive per leaf is the largest possible
+  context.tree.resize(2 * count - 1);
+
+  const bool parallel =
+    count >= context.settings.parallelThreshold && !InParallelRegion();
+#pragma omp parallel if (parallel)
+#pragma omp single
+  BuildNode(context, 0, 0, count, 0);
+
+  context.tree.resize(context.nextNode.load());
+  Flatten(context);
+  m_Stats.nodeCount = m_Nodes.size();
+  m_Stats.leafCount = context.leafCount.load();
+  m_Stats.depth = context.depth.load();
+  m_Stats.milliseconds = stopwatch.elapsedMilliseconds();
+  m_Stats.sahCost = GetSAHCost();
+}
+
+void BVH::Refit(const std::vector<BoundingBox>& slotBounds)
+{
+  DEBUG_ASSERT(slotBounds.size() == m_Indices.size());
+
+  const auto store = [](Node& node, const BoundingBox& box) {
+    node.min[0] = box.min.x;
+    node.min[1] = box.min.y;
+    node.min[2] = box.min.z;
+    node.max[0] = box.max.x;
+    node.max[1] = box.max.y;
+    node.max[2] = box.max.z;
+  };
+
+  // children always follow their parent, so a reverse sweep is bottom-up
+  for (auto index = m_Nodes.size(); index-- > 0;) {
+    Node& node = m_Nodes[index];
+    BoundingBox box{};
+    if (node.IsLeaf()) {
+      for (auto slot = node.offset; slot < node.offset + node.count; ++slot) {
+        add_box(box, slotBounds[slot]);
+      }
+    } else {
+      box = m_Nodes[index + 1].Bounds();
+      add_box(box, m_Nodes[node.offset].Bounds());
+    }
+    store(node, box);
+  }
+  m_Bounds = m_Nodes.empty() ? BoundingBox{} : m_Nodes.front().Bounds();
+}
+
+void BVH::Assign(std::vector<Node> nodes,
+                 std::vector<std::uint32_t> primitiveIndices,
+                 const BuildStats& stats)
+{
+  DEBUG_ASSERT(nodes.empty() == primitiveIndices.empty());
+  DEBUG_ASSERT(stats.nodeCount == nodes.size());
+  m_Nodes = std::move(nodes);
+  m_Indices = std::move(primitiveIndices);
+  m_Stats = stats;
+  m_Bounds = m_Nodes.empty() ? BoundingBox{} : m_Nodes.front().Bounds();
+}
+
+void BVH::Clear()
+{
+  m_Bounds = {};
+  m_Nodes.clear();
+  m_Indices.clear();
+  m_Stats = {};
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+void BVH::Flatten(const BuildContext& context)
+{
+  m_Bounds = context.tree.front().bounds;
+  m_Nodes.resize(context.tree.size());
+
+  // preorder walk; each entry remembers the parent whose right-child offset
+  // it fills in, as its own index is only known once it is placed
+  struct Entry
+  {
+    std::uint32_t treeIndex;
+    std::uint32_t parent;
+  };
+  constexpr auto NoParent = ~std::uint32_t{ 0 };
+  std::vector<Entry> stack{ { 0, NoParent } };
+  std::uint32_t next = 0;
+
+  while (!stack.empty()) {
+    const auto entry = stack.back();
+    stack.pop_back();
+
+    const auto& treeNode = context.tree[entry.treeIndex];
+    const auto index = next++;
+    if (entry.parent != NoParent) {
+      m_Nodes[entry.parent].offset = index;
+    }
+
+    Node& node = m_Nodes[index];
+    node.min[0] = treeNode.bounds.min.x;
+    node.min[1] = treeNode.bounds.min.y;
+    node.min[2] = treeNode.bounds.min.z;
+    node.max[0] = treeNode.bounds.max.x;
+    node.max[1] = treeNode.bounds.max.y;
+    node.max[2] = treeNode.bounds.max.z;
+    node.count = treeNode.count;
+    if (treeNode.count > 0) {
+      node.offset = treeNode.first;
+    } else {
+      // the left child is placed right after this node
+      stack.push_back({ treeNode.left + 1, index });
+      stack.push_back({ treeNode.left, NoParent });
+    }
+  }
+}
+
+void BVH::BuildNode(BuildContext& context,
+                    std::uint32_t nodeIndex,
+                    std::uint32_t first,
+                    std::uint32_t last,
+                    std::uint32_t depth)
+{
+  // the tree never reallocates during a build, so the reference stays valid
+  auto& node = context.tree[nodeIndex];
+  node.bounds = {};
+  BoundingBox centroidBounds{};
+  for (auto i = first; i < last; ++i) {
+    add_box(node.bounds, context.primitiveBounds[m_Indices[i]]);
+    add_point(centroidBounds, context.centroids[m_Indices[i]]);
+  }
+
+  const auto count = last - first;
+  if (count <= context.settings.maxLeafSize) {
+    node.first = first;
+    node.count = count;
+    context.leafCount.fetch_add(1, std::memory_order_relaxed);
+    auto deepest = context.depth.load(std::memory_order_relaxed);
+    while (deepest < depth &&
+           !context.depth.compare_exchange_weak(deepest, depth)) {
+    }
+    return;
+  }
+
+  std::uint32_t mid = 0;
+  if (context.settings.splitMethod == SplitMethod::BinnedSAH &&
+      depth < MaxDepth / 2) {
+    mid = PartitionSAH(context, centroidBounds, first, last);
+  }
+  if (mid == 0) {
+    mid = PartitionMedian(context, centroidBounds, first, last);
+  }
+
+  const auto left = context.nextNode.fetch_add(2, std::memory_order_relaxed);
+  node.left = left;
+
+#pragma omp task default(shared) firstprivate(left, first, mid, depth)        \
+  if (count >= context.settings.parallelThreshold)
+  BuildNode(context, left, first, mid, depth + 1);
+  BuildNode(context, left + 1, mid, last, depth + 1);
+#pragma omp taskwait
+}
+
+std::uint32_t BVH::PartitionMedian(const BuildContext& context,
+                                   const BoundingBox& centroidBounds,
+                                   std::uint32_t first,
+                                   std::uint32_t last)
+{
+  // split along the axis where the centroids are spread the most
+  const auto extent = centroidBounds.max - centroidBounds.min;
+  int axis = 0;
+  if (extent.y > extent.x && extent.y >= extent.z) {
+    axis = 1;
+  } else if (extent.z > extent.x && extent.z > extent.y) {
+    axis = 2;
+  }
+
+  const auto mid = first + (last - first) / 2;
+  if (AxisOf(extent, axis) > 0.0f) {
+    std::nth_element(m_Indices.begin() + first,
+                     m_Indices.begin() + mid,
+                     m_Indices.begin() + last,
+                     [&](auto lhs, auto rhs) {
+                       return AxisOf(context.centroids[lhs], axis) <
+                              AxisOf(context.centroids[rhs], axis);
+                     });
+  }
+  return mid;
+}
+
+std::uint32_t BVH::PartitionSAH(const BuildContext& context,
+                                const BoundingBox& centroidBounds,
+                                std::uint32_t first,
+                                std::uint32_t last)
+{
+  struct Bin
+  {
+    BoundingBox bounds;
+    std::uint32_t count{ 0 };
+  };
+
+  const auto binCount = context.settings.binCount;
+  const auto binOf = [&](std::uint32_t index, int axis) {
+    const auto lo = AxisOf(centroidBounds.min, axis);
+    const auto extent = AxisOf(centroidBounds.max, axis) - lo;
+    const auto offset = AxisOf(context.centroids[index], axis) - lo;
+    const auto bin = static_cast<std::uint32_t>(offset / extent * binCount);
+    return std::min(bin, binCount - 1);
+  };
+
+  // cost of a split is area(left) * count(left) + area(right) * count(right);
+  // the parent's area and the traversal step are the same for every plane
+  float bestCost = INFINITY;
+  int bestAxis = -1;
+  std::uint32_t bestSplit = 0;
+
+  for (int axis = 0; axis < 3; ++axis) {
+    if (!(AxisOf(centroidBounds.max, axis) > AxisOf(centroidBounds.min, axis))) {
+      continue;
+    }
+
+    std::array<Bin, MaxBinCount> bins{};
+    for (auto i = first; i < last; ++i) {
+      const auto index = m_Indices[i];
+      auto& bin = bins[binOf(index, axis)];
+      add_box(bin.bounds, context.primitiveBounds[index]);
+      ++bin.count;
+    }
+
+    // sweep from the right to get the cost of every right-hand side
+    std::array<float, MaxBinCount> rightCost{};
+    BoundingBox rightBounds{};
+    std::uint32_t rightCount = 0;
+    for (auto split = binCount - 1; split > 0; --split) {
+      add_box(rightBounds, bins[split].bounds);
+      rightCount += bins[split].count;
+      rightCost[split - 1] =
+        rightCount > 0 ? surface_area(rightBounds) * rightCount : INFINITY;
+    }
+
+    BoundingBox leftBounds{};
+    std::uint32_t leftCount = 0;
+    for (std::uint32_t split = 0; split + 1 < binCount; ++split) {
+      add_box(leftBounds, bins[split].bounds);
+      leftCount += bins[split].count;
+      if (leftCount == 0) {
+        continue;
+      }
+      const auto cost = surface_area(leftBounds) * leftCount + rightCost[split];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestSplit = split;
+      }
+    }
+  }
+
+  if (bestAxis < 0) {
+    return 0;
+  }
+
+  const auto middle = std::partition(
+    m_Indices.begin() + first, m_Indices.begin() + last, [&](auto index) {
+      return binOf(index, bestAxis) <= bestSplit;
+    });
+  const auto mid = static_cast<std::uint32_t>(middle - m_Indices.begin());
+  return (mid == first || mid == last) ? 0 : mid;
+}
+
+} // namespace RayTracer::Rendering::Acceleration
@@ -0,0 +1,473 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Acceleration/BoundingBox.hpp"
+#include "RayTracer/Rendering/Lighting/Ray.hpp"
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
+
+namespace RayTracer::Rendering::Acceleration {
+
+using namespace Math;
+using namespace Lighting;
+
+/**
+ * @brief Bounding-volume hierarchy over primitives identified by index
+ * @details The hierarchy only knows each primitive's bounding box. Nodes are
+ * stored flat, in depth-first order, and every leaf covers a contiguous range
+ * of slots; the visitor receives slots, and GetPrimitiveIndices()[slot] is the
+ * primitive in that slot. Callers lay their own per-primitive data out in slot
+ * order so a leaf reads one contiguous run.
+ */
+class BVH
+{
+public:
+  /// @section Member types
+  /// @brief 32 bytes, so that two nodes share a cache line
+  struct alignas(32) Node
+  {
+    float min[3];
+    /// interior nodes: index of the right child, the left one comes next;
+    /// leaves: first slot
+    std::uint32_t offset{ 0 };
+    float max[3];
+    std::uint32_t count{ 0 }; // slots in a leaf, 0 for interior nodes
+
+    bool IsLeaf() const { return count > 0; }
+    BoundingBox Bounds() const
+    {
+      return { Point(min[0], min[1], min[2]), Point(max[0], max[1], max[2]) };
+    }
+  };
+
+  enum class SplitMethod
+  {
+    Median,   // halve the range along the widest centroid axis
+    BinnedSAH // cheapest of binCount - 1 planes per axis, by surface area
+  };
+
+  struct BuildSettings
+  {
+    SplitMethod splitMethod{ SplitMethod::BinnedSAH };
+    std::uint32_t maxLeafSize{ 4 };
+    std::uint32_t binCount{ 16 }; // clamped to [2, MaxBinCount]
+    /// ranges at least this large are built as parallel tasks
+    std::uint32_t parallelThreshold{ 4096 };
+    /// children per node traversed by the owner: 2, or 4 / 8 for a WideBVH
+    /// collapsed from this one
+    std::uint32_t width{ 2 };
+    /// owners that refit rebuild instead once the SAH cost exceeds this
+    /// multiple of its value after the last build
+    float refitCostLimit{ 1.5f };
+  };
+
+  struct BuildStats
+  {
+    double milliseconds{ 0.0 };
+    std::size_t nodeCount{ 0 };
+    std::size_t leafCount{ 0 };
+    std::uint32_t depth{ 0 };
+    float sahCost{ 0.0f }; // GetSAHCost() right after the build
+  };
+
+  static_assert(sizeof(Node) == 32);
+
+  static constexpr std::uint32_t MaxBinCount = 64;
+  /// SAH splits stop at half this depth, so median splits can finish the job
+  static constexpr std::uint32_t MaxDepth = 64;
+
+  /// @section Member functions
+  /// @subsection Observers
+  bool IsEmpty() const;
+  const BoundingBox& GetBounds() const;
+  const std::vector<Node>& GetNodes() const;
+  const std::vector<std::uint32_t>& GetPrimitiveIndices() const;
+  const BuildStats& GetBuildStats() const;
+
+  /**
+   * @brief Expected cost of tracing a ray that hits the root box
+   * @details In units of one primitive test, with one box test costing the
+   * same. Unbounded hierarchies report their primitive count.
+   */
+  float GetSAHCost() const;
+
+  /// @return true if GetSAHCost() grew past costLimit times its built value
+  bool IsDegraded(float costLimit) const;
+
+  /// @subsection Modifiers
+  void Build(const std::vector<BoundingBox>& primitiveBounds);
+  void Build(const std::vector<BoundingBox>& primitiveBounds,
+             const BuildSettings& settings);
+
+  /**
+   * @brief Recomputes every node's box, bottom-up, keeping the topology
+   * @details For primitives that moved but were neither added nor removed.
+   * Much cheaper than Build(), but the tree degrades as primitives drift
+   * away from where they were built; see IsDegraded().
+   * @param slotBounds the new box of the primitive in each slot
+   */
+  void Refit(const std::vector<BoundingBox>& slotBounds);
+
+  /**
+   * @brief Adopts nodes and slots produced by an earlier Build()
+   * @details For hierarchies restored from storage; nothing is rebuilt or
+   * checked beyond debug assertions, so the caller vouches for the layout.
+   */
+  void Assign(std::vector<Node> nodes,
+              std::vector<std::uint32_t> primitiveIndices,
+              const BuildStats& stats);
+  void Clear();
+
+  /// @subsection Traversal
+  /**
+   * @brief Calls visit(slot) for every primitive in a leaf the ray reaches
+   * @details Subtrees whose boxes the ray's line misses are skipped.
+   */
+  template<typename Visitor>
+  void Traverse(const Ray& r, Visitor&& visit) const;
+
+  /**
+   * @brief Front-to-back traversal limited to [tmin, tmax]
+   * @details visit(slot) may lower tmax, typically to the distance of a hit
+   * it found; subtrees entered beyond the new tmax are then skipped. Nearer
+   * children are visited first so tmax shrinks as early as possible.
+   */
+  template<typename Visitor>
+  void TraverseClosest(const Ray& r,
+                       float tmin,
+                       float& tmax,
+                       Visitor&& visit) const;
+
+  /**
+   * @brief TraverseClosest() for the active lanes of a packet together
+   * @details A box is tested against the lanes that reached its parent, and
+   * visit(slot, lanes) receives those that reach the leaf; it may lower
+   * their tmax. Children are ordered for the packet's first lane. Once a
+   * single lane is left in a subtree, that lane's ray finishes it alone.
+   */
+  template<std::size_t N, typename Visitor>
+  void TraverseClosest(const RayPacket<N>& packet,
+                       float tmin,
+                       float (&tmax)[N],
+                       Visitor&& visit) const;
+
+  /**
+   * @brief Any-hit traversal limited to [tmin, tmax]
+   * @details Stops as soon as visit(slot) returns true, in no particular
+   * order, and reports whether it did.
+   */
+  template<typename Visitor>
+  bool TraverseAny(const Ray& r,
+                   float tmin,
+                   float tmax,
+                   Visitor&& visit) const;
+
+private:
+  struct BuildContext;
+
+  /// @brief TraverseClosest() of the subtree rooted at node start
+  template<typename Visitor>
+  void TraverseClosestFrom(std::uint32_t start,
+                           const Ray& r,
+                           float tmin,
+                           float& tmax,
+                           Visitor&& visit) const;
+
+  void Flatten(const BuildContext& context);
+  void BuildNode(BuildContext& context,
+                 std::uint32_t nodeIndex,
+                 std::uint32_t first,
+                 std::uint32_t last,
+                 std::uint32_t depth);
+  std::uint32_t PartitionMedian(const BuildContext& context,
+                                const BoundingBox& centroidBounds,
+                                std::uint32_t first,
+                                std::uint32_t last);
+  std::uint32_t PartitionSAH(const BuildContext& context,
+                             const BoundingBox& centroidBounds,
+                             std::uint32_t first,
+                             std::uint32_t last);
+
+  BoundingBox m_Bounds;
+  std::vector<Node> m_Nodes;            // depth-first, the root first
+  std::vector<std::uint32_t> m_Indices; // slot -> primitive
+  BuildStats m_Stats;
+};
+
+/// ===========================================================================
+/// @section Template member functions
+/// ===========================================================================
+
+template<typename Visitor>
+void BVH::Traverse(const Ray& r, Visitor&& visit) const
+{
+  if (m_Nodes.empty()) {
+    return;
+  }
+
+  const float origin[3] = { r.origin.x, r.origin.y, r.origin.z };
+  const float invDirection[3] = { 1.0f / r.direction.x,
+                                  1.0f / r.direction.y,
+                                  1.0f / r.direction.z };
+
+  std::uint32_t stack[MaxDepth + 1];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const auto index = stack[--top];
+    const Node& node = m_Nodes[index];
+    float tnear = -INFINITY;
+    float tfar = INFINITY;
+    if (!intersects_slabs(
+          node.min, node.max, origin, invDirection, tnear, tfar)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (auto slot = node.offset; slot < node.offset + node.count; ++slot) {
+        visit(slot);
+      }
+    } else {
+      stack[top++] = node.offset;
+      stack[top++] = index + 1;
+    }
+  }
+}
+
+template<typename Visitor>
+void BVH::TraverseClosest(const Ray& r,
+                          float tmin,
+                          float& tmax,
+                          Visitor&& visit) const
+{
+  if (m_Nodes.empty()) {
+    return;
+  }
+  TraverseClosestFrom(0, r, tmin, tmax, std::forward<Visitor>(visit));
+}
+
+template<std::size_t N, typename Visitor>
+void BVH::TraverseClosest(const RayPacket<N>& packet,
+                          float tmin,
+                          float (&tmax)[N],
+                          Visitor&& visit) const
+{
+  if (m_Nodes.empty() || packet.active == 0) {
+    return;
+  }
+
+  alignas(64) float invX[N];
+  alignas(64) float invY[N];
+  alignas(64) float invZ[N];
+  for (std::size_t i = 0; i < N; ++i) {
+    invX[i] = 1.0f / packet.directionX[i];
+    invY[i] = 1.0f / packet.directionY[i];
+    invZ[i] = 1.0f / packet.directionZ[i];
+  }
+
+  // the lanes whose [tmin, tmax] overlaps node's box
+  const auto reach = [&](const Node& node, LaneMask lanes) {
+    LaneMask reached = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      const auto x0 = (node.min[0] - packet.originX[i]) * invX[i];
+      const auto x1 = (node.max[0] - packet.originX[i]) * invX[i];
+      const auto y0 = (node.min[1] - packet.originY[i]) * invY[i];
+      const auto y1 = (node.max[1] - packet.originY[i]) * invY[i];
+      const auto z0 = (node.min[2] - packet.originZ[i]) * invZ[i];
+      const auto z1 = (node.max[2] - packet.originZ[i]) * invZ[i];
+      auto tnear = std::max(tmin, std::min(x0, x1));
+      tnear = std::max(tnear, std::min(y0, y1));
+      tnear = std::max(tnear, std::min(z0, z1));
+      auto tfar = std::min(tmax[i], std::max(x0, x1));
+      tfar = std::min(tfar, std::max(y0, y1));
+      tfar = std::min(tfar, std::max(z0, z1));
+      reached |= LaneMask{ tnear <= tfar } << i;
+    }
+    return reached & lanes;
+  };
+  const float* directions[3] = { packet.directionX,
+                                 packet.directionY,
+                                 packet.directionZ };
+
+  // boxes are tested when popped, against the tmax of that moment
+  struct Entry
+  {
+    std::uint32_t node;
+    LaneMask lanes;
+  };
+  Entry stack[MaxDepth + 1];
+  int top = 0;
+  stack[top++] = { 0, packet.active };
+
+  while (top > 0) {
+    const auto entry = stack[--top];
+    const Node& node = m_Nodes[entry.node];
+    const auto lanes = reach(node, entry.lanes);
+    if (lanes == 0) {
+      continue;
+    }
+
+    if (std::has_single_bit(lanes)) {
+      const auto lane = std::countr_zero(lanes);
+      TraverseClosestFrom(entry.node,
+                          packet.Get(lane),
+                          tmin,
+                          tmax[lane],
+                          [&](std::uint32_t slot) { visit(slot, lanes); });
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (auto slot = node.offset; slot < node.offset + node.count; ++slot) {
+        visit(slot, lanes);
+      }
+      continue;
+    }
+
+    // the nearer child, along the axis their centers are furthest apart on
+    const auto leftIndex = entry.node + 1;
+    const auto rightIndex = node.offset;
+    const Node& left = m_Nodes[leftIndex];
+    const Node& right = m_Nodes[rightIndex];
+    int axis = 0;
+    float widest = -1.0f;
+    for (int a = 0; a < 3; ++a) {
+      const auto gap = (right.min[a] + right.max[a]) - //
+                       (left.min[a] + left.max[a]);
+      if (std::abs(gap) > widest) {
+        widest = std::abs(gap);
+        axis = a;
+      }
+    }
+    const auto gap = (right.min[axis] + right.max[axis]) - //
+                     (left.min[axis] + left.max[axis]);
+    const auto direction = directions[axis][std::countr_zero(lanes)];
+    if ((gap >= 0) == (direction >= 0)) {
+      stack[top++] = { rightIndex, lanes };
+      stack[top++] = { leftIndex, lanes };
+    } else {
+      stack[top++] = { leftIndex, lanes };
+      stack[top++] = { rightIndex, lanes };
+    }
+  }
+}
+
+template<typename Visitor>
+void BVH::TraverseClosestFrom(std::uint32_t start,
+                              const Ray& r,
+                              float tmin,
+                              float& tmax,
+                              Visitor&& visit) const
+{
+  const float origin[3] = { r.origin.x, r.origin.y, r.origin.z };
+  const float invDirection[3] = { 1.0f / r.direction.x,
+                                  1.0f / r.direction.y,
+                                  1.0f / r.direction.z };
+
+  // each entry remembers where the ray enters its box, so that it can be
+  // dropped once a hit closer than that has been found
+  struct Entry
+  {
+    std::uint32_t node;
+    float tnear;
+  };
+  Entry stack[MaxDepth + 1];
+  int top = 0;
+
+  float rootNear = tmin;
+  float rootFar = tmax;
+  const Node& root = m_Nodes[start];
+  if (!intersects_slabs(
+        root.min, root.max, origin, invDirection, rootNear, rootFar)) {
+    return;
+  }
+  stack[top++] = { start, rootNear };
+
+  while (top > 0) {
+    const auto entry = stack[--top];
+    if (entry.tnear > tmax) {
+      continue;
+    }
+
+    const Node& node = m_Nodes[entry.node];
+    if (node.IsLeaf()) {
+      for (auto slot = node.offset; slot < node.offset + node.count; ++slot) {
+        visit(slot);
+      }
+      continue;
+    }
+
+    const auto leftIndex = entry.node + 1;
+    const auto rightIndex = node.offset;
+    const Node& left = m_Nodes[leftIndex];
+    const Node& right = m_Nodes[rightIndex];
+    float leftNear = tmin;
+    float leftFar = tmax;
+    float rightNear = tmin;
+    float rightFar = tmax;
+    const bool hitLeft = intersects_slabs(
+      left.min, left.max, origin, invDirection, leftNear, leftFar);
+    const bool hitRight = intersects_slabs(
+      right.min, right.max, origin, invDirection, rightNear, rightFar);
+
+    // push the farther child first so the nearer one is popped next
+    if (hitLeft && hitRight) {
+      if (leftNear <= rightNear) {
+        stack[top++] = { rightIndex, rightNear };
+        stack[top++] = { leftIndex, leftNear };
+      } else {
+        stack[top++] = { leftIndex, leftNear };
+        stack[top++] = { rightIndex, rightNear };
+      }
+    } else if (hitLeft) {
+      stack[top++] = { leftIndex, leftNear };
+    } else if (hitRight) {
+      stack[top++] = { rightIndex, rightNear };
+    }
+  }
+}
+
+template<typename Visitor>
+bool BVH::TraverseAny(const Ray& r,
+                      float tmin,
+                      float tmax,
+                      Visitor&& visit) const
+{
+  if (m_Nodes.empty()) {
+    return false;
+  }
+
+  const float origin[3] = { r.origin.x, r.origin.y, r.origin.z };
+  const float invDirection[3] = { 1.0f / r.direction.x,
+                                  1.0f / r.direction.y,
+                                  1.0f / r.direction.z };
+
+  std::uint32_t stack[MaxDepth + 1];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const auto index = stack[--top];
+    const Node& node = m_Nodes[index];
+    float tnear = tmin;
+    float tfar = tmax;
+    if (!intersects_slabs(
+          node.min, node.max, origin, invDirection, tnear, tfar)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (auto slot = node.offset; slot < node.offset + node.count; ++slot) {
+        if (visit(slot)) {
+          return true;
+        }
+      }
+    } else {
+      stack[top++] = node.offset;
+      stack[top++] = index + 1;
+    }
+  }
+  return false;
+}
+
+} // namespace RayTracer::Rendering::Acceleration
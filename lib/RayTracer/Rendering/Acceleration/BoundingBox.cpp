@@ -0,0 +1,130 @@
+#include "RayTracer/Rendering/Acceleration/BoundingBox.hpp"
+
+namespace RayTracer::Rendering::Acceleration {
+
+/// ===========================================================================
+/// @section Non-member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+bool is_empty(const BoundingBox& box)
+{
+  return box.min.x > box.max.x || box.min.y > box.max.y ||
+         box.min.z > box.max.z;
+}
+
+bool is_bounded(const BoundingBox& box)
+{
+  return std::isfinite(box.min.x) && std::isfinite(box.min.y) &&
+         std::isfinite(box.min.z) && std::isfinite(box.max.x) &&
+         std::isfinite(box.max.y) && std::isfinite(box.max.z);
+}
+
+bool box_contains_point(const BoundingBox& box, const Tuple& point)
+{
+  return box.min.x <= point.x && point.x <= box.max.x && //
+         box.min.y <= point.y && point.y <= box.max.y && //
+         box.min.z <= point.z && point.z <= box.max.z;
+}
+
+bool box_contains_box(const BoundingBox& box, const BoundingBox& other)
+{
+  return box_contains_point(box, other.min) &&
+         box_contains_point(box, other.max);
+}
+
+Tuple centroid(const BoundingBox& box)
+{
+  const auto center = [](float lo, float hi) {
+    const float c = 0.5f * (lo + hi);
+    return std::isfinite(c) ? c : 0.0f;
+  };
+  return Point(center(box.min.x, box.max.x),
+               center(box.min.y, box.max.y),
+               center(box.min.z, box.max.z));
+}
+
+float surface_area(const BoundingBox& box)
+{
+  if (is_empty(box)) {
+    return 0.0f;
+  }
+  if (!is_bounded(box)) {
+    return INFINITY;
+  }
+  const auto d = box.max - box.min;
+  return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+void add_point(BoundingBox& box, const Tuple& point)
+{
+  box.min = Point(std::min(box.min.x, point.x),
+                  std::min(box.min.y, point.y),
+                  std::min(box.min.z, point.z));
+  box.max = Point(std::max(box.max.x, point.x),
+                  std::max(box.max.y, point.y),
+                  std::max(box.max.z, point.z));
+}
+
+void add_box(BoundingBox& box, const BoundingBox& other)
+{
+  if (is_empty(other)) {
+    return;
+  }
+  add_point(box, other.min);
+  add_point(box, other.max);
+}
+
+BoundingBox transform(const BoundingBox& box, const mat4& m)
+{
+  if (is_empty(box)) {
+    return box;
+  }
+
+  // Arvo's method: each output axis is the translation plus, per input axis,
+  // the smaller/larger of the two scaled extents. Zero entries are skipped so
+  // unbounded axes do not turn into 0 * inf = NaN.
+  const float lo[3] = { box.min.x, box.min.y, box.min.z };
+  const float hi[3] = { box.max.x, box.max.y, box.max.z };
+  float resultMin[3];
+  float resultMax[3];
+  for (int row = 0; row < 3; ++row) {
+    resultMin[row] = resultMax[row] = m[row][3];
+    for (int col = 0; col < 3; ++col) {
+      if (m[row][col] == 0.0f) {
+        continue;
+      }
+      const float a = m[row][col] * lo[col];
+      const float b = m[row][col] * hi[col];
+      resultMin[row] += std::min(a, b);
+      resultMax[row] += std::max(a, b);
+    }
+  }
+
+  return BoundingBox{ Point(resultMin[0], resultMin[1], resultMin[2]),
+                      Point(resultMax[0], resultMax[1], resultMax[2]) };
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Ray queries
+/// ---------------------------------------------------------------------------
+
+bool intersects(const BoundingBox& box, const Ray& r)
+{
+  const float origin[3] = { r.origin.x, r.origin.y, r.origin.z };
+  const float invDirection[3] = { 1.0f / r.direction.x,
+                                  1.0f / r.direction.y,
+                                  1.0f / r.direction.z };
+  float tnear = -INFINITY;
+  float tfar = INFINITY;
+  return intersects_slabs(box, origin, invDirection, tnear, tfar);
+}
+
+} // namespace RayTracer::Rendering::Acceleration
@@ -0,0 +1,86 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Math/Matrix.hpp"
+#include "RayTracer/Math/Tuple.hpp"
+#include "RayTracer/Rendering/Lighting/Ray.hpp"
+
+namespace RayTracer::Rendering::Acceleration {
+
+using namespace Math;
+using namespace Lighting;
+
+/**
+ * @brief Axis-aligned bounding box
+ * @details Default constructed boxes are empty (min > max). Unbounded shapes
+ * such as planes use infinite extents.
+ */
+struct BoundingBox
+{
+  Tuple min{ Point(INFINITY, INFINITY, INFINITY) };
+  Tuple max{ Point(-INFINITY, -INFINITY, -INFINITY) };
+};
+
+/// @section Non-member functions
+
+/// @subsection Observers
+bool is_empty(const BoundingBox& box);
+bool is_bounded(const BoundingBox& box);
+bool box_contains_point(const BoundingBox& box, const Tuple& point);
+bool box_contains_box(const BoundingBox& box, const BoundingBox& other);
+
+/// @return the center of box, with unbounded axes collapsed to 0
+Tuple centroid(const BoundingBox& box);
+
+/// @return 0 for an empty box and INFINITY for an unbounded one
+float surface_area(const BoundingBox& box);
+
+/// @subsection Modifiers
+void add_point(BoundingBox& box, const Tuple& point);
+void add_box(BoundingBox& box, const BoundingBox& other);
+
+/// @return the bounds of box after transformation by m
+BoundingBox transform(const BoundingBox& box, const mat4& m);
+
+/// @subsection Ray queries
+bool intersects(const BoundingBox& box, const Ray& r);
+
+/**
+ * @brief Slab test against a precomputed 1 / direction
+ * @details Clips [tnear, tfar] to the box and returns false if it becomes
+ * empty. An axis that yields NaN (origin on the slab of a ray parallel to it)
+ * is ignored, so the test errs on the side of reporting a hit.
+ */
+inline bool intersects_slabs(const float min[3],
+                             const float max[3],
+                             const float origin[3],
+                             const float invDirection[3],
+                             float& tnear,
+                             float& tfar)
+{
+  const auto clip = [&](float lo, float hi, int axis) {
+    float t0 = (lo - origin[axis]) * invDirection[axis];
+    float t1 = (hi - origin[axis]) * invDirection[axis];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    tnear = t0 > tnear ? t0 : tnear;
+    tfar = t1 < tfar ? t1 : tfar;
+  };
+  clip(min[0], max[0], 0);
+  clip(min[1], max[1], 1);
+  clip(min[2], max[2], 2);
+  return tnear <= tfar;
+}
+
+inline bool intersects_slabs(const BoundingBox& box,
+                             const float origin[3],
+                             const float invDirection[3],
+                             float& tnear,
+                             float& tfar)
+{
+  return intersects_slabs(
+    &box.min.x, &box.max.x, origin, invDirection, tnear, tfar);
+}
+
+} // namespace RayTracer::Rendering::Acceleration
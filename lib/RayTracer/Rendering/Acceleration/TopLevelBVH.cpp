@@ -0,0 +1,164 @@
+#include "RayTracer/Rendering/Acceleration/TopLevelBVH.hpp"
+
+namespace RayTracer::Rendering::Acceleration {
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Special member functions
+/// ---------------------------------------------------------------------------
+
+TopLevelBVH::TopLevelBVH(const TopLevelBVH& other)
+  : m_BuildSettings(other.m_BuildSettings)
+  , m_Revision(other.m_Revision)
+{}
+
+TopLevelBVH& TopLevelBVH::operator=(const TopLevelBVH& other)
+{
+  m_BuildSettings = other.m_BuildSettings;
+  m_Revision = other.m_Revision;
+  Invalidate();
+  return *this;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+const BVH& TopLevelBVH::GetBVH(
+  const std::vector<std::shared_ptr<Shape>>& objects) const
+{
+  const auto revision = m_Revision->bounds.load(std::memory_order_acquire);
+  if (m_BuiltRevision.load(std::memory_order_acquire) == revision) {
+    return m_BVH;
+  }
+
+  std::lock_guard lock(m_BuildMutex);
+  const auto built = m_BuiltRevision.load(std::memory_order_relaxed);
+  if (built == revision) {
+    return m_BVH;
+  }
+
+  // only the bounds moved since the last build: keep the topology if it
+  // still fits and has not degraded too far
+  const bool refitted = built != Stale && Refit(objects) &&
+                        !m_BVH.IsDegraded(m_BuildSettings.refitCostLimit);
+  if (!refitted) {
+    Build(objects);
+  }
+  Collapse();
+  m_BuiltRevision.store(revision, std::memory_order_release);
+  return m_BVH;
+}
+
+std::size_t TopLevelBVH::GetUnboundedCount() const
+{
+  return m_Unbounded.size();
+}
+
+std::size_t TopLevelBVH::GetBuildCount() const
+{
+  return m_BuildCount;
+}
+
+std::size_t TopLevelBVH::GetRefitCount() const
+{
+  return m_RefitCount;
+}
+
+const BVH::BuildSettings& TopLevelBVH::GetBuildSettings() const
+{
+  return m_BuildSettings;
+}
+
+const std::shared_ptr<SceneRevision>& TopLevelBVH::GetRevision() const
+{
+  return m_Revision;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+void TopLevelBVH::Invalidate()
+{
+  m_BuiltRevision.store(Stale, std::memory_order_release);
+}
+
+void TopLevelBVH::SetBuildSettings(const BVH::BuildSettings& settings)
+{
+  m_BuildSettings = settings;
+  Invalidate();
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+void TopLevelBVH::Build(
+  const std::vector<std::shared_ptr<Shape>>& objects) const
+{
+  // Bounds() builds every nested Group's own hierarchy on the way
+  std::vector<BoundingBox> bounds;
+  m_Bounded.clear();
+  m_Unbounded.clear();
+  for (std::uint32_t i = 0; i < objects.size(); ++i) {
+    auto box = objects[i]->Bounds();
+    if (is_bounded(box)) {
+      bounds.push_back(box);
+      m_Bounded.push_back(i);
+    } else {
+      m_Unbounded.push_back(i);
+    }
+  }
+  m_BVH.Build(bounds, m_BuildSettings);
+
+  // store the objects in slot order, so a leaf reads consecutive entries
+  const auto buildOrder = m_Bounded;
+  const auto& slots = m_BVH.GetPrimitiveIndices();
+  for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+    m_Bounded[slot] = buildOrder[slots[slot]];
+  }
+  ++m_BuildCount;
+}
+
+bool TopLevelBVH::Refit(
+  const std::vector<std::shared_ptr<Shape>>& objects) const
+{
+  if (m_Bounded.size() + m_Unbounded.size() != objects.size()) {
+    return false;
+  }
+  for (auto index : m_Unbounded) {
+    if (is_bounded(objects[index]->Bounds())) {
+      return false;
+    }
+  }
+
+  std::vector<BoundingBox> slotBounds;
+  slotBounds.reserve(m_Bounded.size());
+  for (auto index : m_Bounded) {
+    auto box = objects[index]->Bounds();
+    if (!is_bounded(box)) {
+      return false;
+    }
+    slotBounds.push_back(box);
+  }
+  m_BVH.Refit(slotBounds);
+  ++m_RefitCount;
+  return true;
+}
+
+void TopLevelBVH::Collapse() const
+{
+  m_BVH4.Clear();
+  m_BVH8.Clear();
+  if (m_BuildSettings.width == 4) {
+    m_BVH4.Build(m_BVH);
+  } else if (m_BuildSettings.width == 8) {
+    m_BVH8.Build(m_BVH);
+  }
+}
+
+} // namespace RayTracer::Rendering::Acceleration
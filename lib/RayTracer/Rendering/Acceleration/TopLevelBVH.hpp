@@ -0,0 +1,191 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+#include "RayTracer/Rendering/Acceleration/WideBVH.hpp"
+#include "RayTracer/Rendering/Primitives/Shape.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace RayTracer::Rendering::Acceleration {
+
+using Primitives::SceneRevision;
+using Primitives::Shape;
+
+/**
+ * @brief Top level of a two-level hierarchy over a list of placed objects
+ * @details A BVH over the bounds of the bounded objects; each object then
+ * intersects through its own bottom-level structure (e.g. a Group's BVH).
+ * Unbounded objects such as planes sit in a side list every ray visits.
+ * The hierarchy is updated lazily: rebuilt when invalidated, refitted when
+ * only the bounds of shapes attached to its SceneRevision changed (see
+ * GetRevision()), unless refitting has degraded it past
+ * BuildSettings::refitCostLimit.
+ */
+class TopLevelBVH
+{
+public:
+  /// @section Member functions
+  /// @subsection Special member functions
+  TopLevelBVH() = default;
+  /// Copies share only the revision, as they hold the same objects; they
+  /// rebuild on first use
+  TopLevelBVH(const TopLevelBVH& other);
+  TopLevelBVH& operator=(const TopLevelBVH& other);
+
+  /// @subsection Observers
+  /// @brief The hierarchy over the bounded objects, up to date with objects
+  const BVH& GetBVH(const std::vector<std::shared_ptr<Shape>>& objects) const;
+  std::size_t GetUnboundedCount() const;
+  /// @brief Full builds and refits done so far
+  std::size_t GetBuildCount() const;
+  std::size_t GetRefitCount() const;
+  const BVH::BuildSettings& GetBuildSettings() const;
+  /// @brief The counters the objects are to be attached to
+  const std::shared_ptr<SceneRevision>& GetRevision() const;
+
+  /// @subsection Modifiers
+  /// @brief Forces a full build on the next query, as for a new object list
+  void Invalidate();
+  void SetBuildSettings(const BVH::BuildSettings& settings);
+
+  /// @subsection Traversal
+  /**
+   * @brief Calls visit(object) for every object the ray's line may reach
+   */
+  template<typename Visitor>
+  void Traverse(const std::vector<std::shared_ptr<Shape>>& objects,
+                const Ray& r,
+                Visitor&& visit) const;
+
+  /**
+   * @brief Closest-first variant of Traverse(), limited to [tmin, tmax]
+   * @details visit(object) may lower tmax; see BVH::TraverseClosest().
+   * Unbounded objects are visited last, when tmax is already at its tightest.
+   */
+  template<typename Visitor>
+  void TraverseClosest(const std::vector<std::shared_ptr<Shape>>& objects,
+                       const Ray& r,
+                       float tmin,
+                       float& tmax,
+                       Visitor&& visit) const;
+
+  /**
+   * @brief Any-hit variant of Traverse(), limited to [tmin, tmax]
+   * @details Stops as soon as visit(object) returns true; see
+   * BVH::TraverseAny().
+   */
+  template<typename Visitor>
+  bool TraverseAny(const std::vector<std::shared_ptr<Shape>>& objects,
+                   const Ray& r,
+                   float tmin,
+                   float tmax,
+                   Visitor&& visit) const;
+
+private:
+  static constexpr std::uint64_t Stale = ~std::uint64_t{ 0 };
+
+  /// @brief Calls traverse(hierarchy) with the one BuildSettings::width selects
+  template<typename Traversal>
+  decltype(auto) WithHierarchy(
+    const std::vector<std::shared_ptr<Shape>>& objects,
+    Traversal&& traverse) const;
+
+  void Build(const std::vector<std::shared_ptr<Shape>>& objects) const;
+  /// @return false if the objects no longer fit the hierarchy's topology
+  bool Refit(const std::vector<std::shared_ptr<Shape>>& objects) const;
+  void Collapse() const;
+
+  BVH::BuildSettings m_BuildSettings{};
+  std::shared_ptr<SceneRevision> m_Revision{
+    std::make_shared<SceneRevision>()
+  };
+  mutable BVH m_BVH;
+  mutable BVH4 m_BVH4; // collapsed from m_BVH when width is 4
+  mutable BVH8 m_BVH8; // collapsed from m_BVH when width is 8
+  mutable std::vector<std::uint32_t> m_Bounded;   // BVH slot -> object
+  mutable std::vector<std::uint32_t> m_Unbounded; // objects outside the BVH
+  mutable std::atomic<std::uint64_t> m_BuiltRevision{ Stale };
+  mutable std::mutex m_BuildMutex;
+  mutable std::size_t m_BuildCount{ 0 };
+  mutable std::size_t m_RefitCount{ 0 };
+};
+
+/// ===========================================================================
+/// @section Template member functions
+/// ===========================================================================
+
+template<typename Traversal>
+decltype(auto) TopLevelBVH::WithHierarchy(
+  const std::vector<std::shared_ptr<Shape>>& objects,
+  Traversal&& traverse) const
+{
+  const auto& bvh = GetBVH(objects);
+  switch (m_BuildSettings.width) {
+    case 4:
+      return traverse(m_BVH4);
+    case 8:
+      return traverse(m_BVH8);
+    default:
+      return traverse(bvh);
+  }
+}
+
+template<typename Visitor>
+void TopLevelBVH::Traverse(const std::vector<std::shared_ptr<Shape>>& objects,
+                           const Ray& r,
+                           Visitor&& visit) const
+{
+  WithHierarchy(objects, [&](const auto& bvh) {
+    bvh.Traverse(
+      r, [&](std::uint32_t slot) { visit(*objects[m_Bounded[slot]]); });
+  });
+  for (auto index : m_Unbounded) {
+    visit(*objects[index]);
+  }
+}
+
+template<typename Visitor>
+void TopLevelBVH::TraverseClosest(
+  const std::vector<std::shared_ptr<Shape>>& objects,
+  const Ray& r,
+  float tmin,
+  float& tmax,
+  Visitor&& visit) const
+{
+  WithHierarchy(objects, [&](const auto& bvh) {
+    bvh.TraverseClosest(r, tmin, tmax, [&](std::uint32_t slot) {
+      visit(*objects[m_Bounded[slot]]);
+    });
+  });
+  for (auto index : m_Unbounded) {
+    visit(*objects[index]);
+  }
+}
+
+template<typename Visitor>
+bool TopLevelBVH::TraverseAny(
+  const std::vector<std::shared_ptr<Shape>>& objects,
+  const Ray& r,
+  float tmin,
+  float tmax,
+  Visitor&& visit) const
+{
+  const bool found = WithHierarchy(objects, [&](const auto& bvh) {
+    return bvh.TraverseAny(r, tmin, tmax, [&](std::uint32_t slot) {
+      return visit(*objects[m_Bounded[slot]]);
+    });
+  });
+  if (found) {
+    return true;
+  }
+  for (auto index : m_Unbounded) {
+    if (visit(*objects[index])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace RayTracer::Rendering::Acceleration
@@ -0,0 +1,123 @@
+#include "RayTracer/Rendering/Acceleration/WideBVH.hpp"
+
+namespace RayTracer::Rendering::Acceleration {
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+template<std::size_t Width>
+bool WideBVH<Width>::IsEmpty() const
+{
+  return m_Nodes.empty();
+}
+
+template<std::size_t Width>
+auto WideBVH<Width>::GetNodes() const -> const std::vector<Node>&
+{
+  return m_Nodes;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+template<std::size_t Width>
+void WideBVH<Width>::Build(const BVH& binary)
+{
+  Clear();
+  const auto& nodes = binary.GetNodes();
+  if (nodes.empty()) {
+    return;
+  }
+
+  // a binary node, and the wide node that will hold its descendants
+  struct Pending
+  {
+    std::uint32_t binaryIndex;
+    std::uint32_t wideIndex;
+  };
+  std::vector<Pending> pending{ { 0, 0 } };
+  m_Nodes.emplace_back();
+
+  while (!pending.empty()) {
+    const auto current = pending.back();
+    pending.pop_back();
+
+    // start from the binary node's two children (or the lone root leaf) and
+    // keep opening the largest interior one until Width lanes are filled
+    std::uint32_t lanes[Width];
+    std::uint32_t laneCount = 0;
+    const auto& parent = nodes[current.binaryIndex];
+    if (parent.IsLeaf()) {
+      lanes[laneCount++] = current.binaryIndex;
+    } else {
+      lanes[laneCount++] = current.binaryIndex + 1;
+      lanes[laneCount++] = parent.offset;
+    }
+
+    while (laneCount < Width) {
+      int widest = -1;
+      float widestArea = -1.0f;
+      for (std::uint32_t i = 0; i < laneCount; ++i) {
+        const auto& lane = nodes[lanes[i]];
+        if (lane.IsLeaf()) {
+          continue;
+        }
+        const auto area = surface_area(lane.Bounds());
+        if (area > widestArea) {
+          widestArea = area;
+          widest = static_cast<int>(i);
+        }
+      }
+      if (widest < 0) {
+        break;
+      }
+      const auto opened = lanes[widest];
+      lanes[widest] = opened + 1;
+      lanes[laneCount++] = nodes[opened].offset;
+    }
+
+    // unused lanes stay zeroed; traversal masks them out by childCount
+    Node node{};
+    node.childCount = laneCount;
+    for (std::uint32_t i = 0; i < laneCount; ++i) {
+      const auto& lane = nodes[lanes[i]];
+      node.minX[i] = lane.min[0];
+      node.minY[i] = lane.min[1];
+      node.minZ[i] = lane.min[2];
+      node.maxX[i] = lane.max[0];
+      node.maxY[i] = lane.max[1];
+      node.maxZ[i] = lane.max[2];
+      if (lane.IsLeaf()) {
+        node.child[i] = lane.offset;
+        node.count[i] = lane.count;
+      } else {
+        node.child[i] = static_cast<std::uint32_t>(m_Nodes.size());
+        node.count[i] = 0;
+        pending.push_back({ lanes[i], node.child[i] });
+        m_Nodes.emplace_back();
+      }
+    }
+    m_Nodes[current.wideIndex] = node;
+  }
+}
+
+template<std::size_t Width>
+void WideBVH<Width>::Clear()
+{
+  m_Nodes.clear();
+}
+
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template class WideBVH<4>;
+template class WideBVH<8>;
+
+} // namespace RayTracer::Rendering::Acceleration
@@ -0,0 +1,281 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Math/SIMD.hpp"
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+
+namespace RayTracer::Rendering::Acceleration {
+
+/**
+ * @brief Bounding-volume hierarchy with up to Width children per node
+ * @details Collapsed from a binary BVH, whose slots it shares: the visitor
+ * receives the same slots as BVH's traversals. Each node stores its children's
+ * boxes in structure-of-arrays layout, so one ray is tested against four of
+ * them per Float4 operation, and hit children are visited near to far.
+ */
+template<std::size_t Width>
+class WideBVH
+{
+  static_assert(Width == 4 || Width == 8, "Width must be 4 or 8");
+
+public:
+  /// @section Member types
+  struct alignas(32) Node
+  {
+    float minX[Width];
+    float minY[Width];
+    float minZ[Width];
+    float maxX[Width];
+    float maxY[Width];
+    float maxZ[Width];
+    /// interior children: node index; leaves: first slot
+    std::uint32_t child[Width];
+    std::uint32_t count[Width]; // slots in a leaf, 0 for interior children
+    std::uint32_t childCount;
+  };
+
+  /// @section Member functions
+  /// @subsection Observers
+  bool IsEmpty() const;
+  const std::vector<Node>& GetNodes() const;
+
+  /// @subsection Modifiers
+  void Build(const BVH& binary);
+  void Clear();
+
+  /// @subsection Traversal
+  /// @brief Same contracts as BVH::Traverse(), TraverseClosest(), TraverseAny()
+  template<typename Visitor>
+  void Traverse(const Ray& r, Visitor&& visit) const;
+
+  template<typename Visitor>
+  void TraverseClosest(const Ray& r,
+                       float tmin,
+                       float& tmax,
+                       Visitor&& visit) const;
+
+  template<typename Visitor>
+  bool TraverseAny(const Ray& r,
+                   float tmin,
+                   float tmax,
+                   Visitor&& visit) const;
+
+private:
+  /// @brief Node or leaf still to be visited
+  struct Entry
+  {
+    std::uint32_t child;
+    std::uint32_t count;
+    float tnear;
+  };
+
+  /// each node pushes at most Width - 1 entries more than it pops
+  static constexpr std::size_t StackSize = BVH::MaxDepth * (Width - 1) + 2;
+
+  struct RayLanes
+  {
+    Math::Float4 origin[3];
+    Math::Float4 invDirection[3];
+  };
+
+  static RayLanes MakeRayLanes(const Ray& r);
+
+  /**
+   * @brief Slab test of r against every child of node
+   * @param tEntry receives, per child, the distance at which r enters it
+   * @return a bit mask of the children hit within [tmin, tmax]
+   */
+  static int IntersectChildren(const Node& node,
+                               const RayLanes& ray,
+                               float tmin,
+                               float tmax,
+                               float* tEntry);
+
+  std::vector<Node> m_Nodes; // the root first
+};
+
+using BVH4 = WideBVH<4>;
+using BVH8 = WideBVH<8>;
+
+// defined in WideBVH.cpp
+extern template class WideBVH<4>;
+extern template class WideBVH<8>;
+
+/// ===========================================================================
+/// @section Template member functions
+/// ===========================================================================
+
+template<std::size_t Width>
+auto WideBVH<Width>::MakeRayLanes(const Ray& r) -> RayLanes
+{
+  using Math::Float4;
+  return { { Float4::Splat(r.origin.x),
+             Float4::Splat(r.origin.y),
+             Float4::Splat(r.origin.z) },
+           { Float4::Splat(1.0f / r.direction.x),
+             Float4::Splat(1.0f / r.direction.y),
+             Float4::Splat(1.0f / r.direction.z) } };
+}
+
+template<std::size_t Width>
+int WideBVH<Width>::IntersectChildren(const Node& node,
+                                      const RayLanes& ray,
+                                      float tmin,
+                                      float tmax,
+                                      float* tEntry)
+{
+  using Math::Float4;
+  const auto lo = Float4::Splat(tmin);
+  const auto hi = Float4::Splat(tmax);
+
+  int hits = 0;
+  for (std::size_t i = 0; i < Width; i += 4) {
+    const auto tx0 = (Float4::Load(node.minX + i) - ray.origin[0]) *
+                     ray.invDirection[0];
+    const auto tx1 = (Float4::Load(node.maxX + i) - ray.origin[0]) *
+                     ray.invDirection[0];
+    const auto ty0 = (Float4::Load(node.minY + i) - ray.origin[1]) *
+                     ray.invDirection[1];
+    const auto ty1 = (Float4::Load(node.maxY + i) - ray.origin[1]) *
+                     ray.invDirection[1];
+    const auto tz0 = (Float4::Load(node.minZ + i) - ray.origin[2]) *
+                     ray.invDirection[2];
+    const auto tz1 = (Float4::Load(node.maxZ + i) - ray.origin[2]) *
+                     ray.invDirection[2];
+
+    const auto tnear = Max(Max(Min(tx0, tx1), Min(ty0, ty1)), //
+                           Max(Min(tz0, tz1), lo));
+    const auto tfar = Min(Min(Max(tx0, tx1), Max(ty0, ty1)), //
+                          Min(Max(tz0, tz1), hi));
+
+    tnear.Store(tEntry + i);
+    hits |= LessEqualMask(tnear, tfar) << i;
+  }
+  // unused lanes hold empty boxes, which the slab test cannot reject
+  return hits & ((1 << node.childCount) - 1);
+}
+
+template<std::size_t Width>
+template<typename Visitor>
+void WideBVH<Width>::Traverse(const Ray& r, Visitor&& visit) const
+{
+  if (m_Nodes.empty()) {
+    return;
+  }
+
+  const auto ray = MakeRayLanes(r);
+  std::uint32_t stack[StackSize];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const Node& node = m_Nodes[stack[--top]];
+    alignas(16) float tEntry[Width];
+    auto hits = IntersectChildren(node, ray, -INFINITY, INFINITY, tEntry);
+
+    for (std::size_t i = 0; hits != 0; ++i, hits >>= 1) {
+      if ((hits & 1) == 0) {
+        continue;
+      }
+      if (node.count[i] > 0) {
+        for (auto slot = node.child[i]; slot < node.child[i] + node.count[i];
+             ++slot) {
+          visit(slot);
+        }
+      } else {
+        stack[top++] = node.child[i];
+      }
+    }
+  }
+}
+
+template<std::size_t Width>
+template<typename Visitor>
+void WideBVH<Width>::TraverseClosest(const Ray& r,
+                                     float tmin,
+                                     float& tmax,
+                                     Visitor&& visit) const
+{
+  if (m_Nodes.empty()) {
+    return;
+  }
+
+  const auto ray = MakeRayLanes(r);
+  Entry stack[StackSize];
+  int top = 0;
+  stack[top++] = { 0, 0, tmin };
+
+  while (top > 0) {
+    const auto entry = stack[--top];
+    if (entry.tnear > tmax) {
+      continue;
+    }
+
+    if (entry.count > 0) {
+      for (auto slot = entry.child; slot < entry.child + entry.count; ++slot) {
+        visit(slot);
+      }
+      continue;
+    }
+
+    const Node& node = m_Nodes[entry.child];
+    alignas(16) float tEntry[Width];
+    auto hits = IntersectChildren(node, ray, tmin, tmax, tEntry);
+
+    // push the hit children farthest first, so the nearest is popped next
+    const auto first = top;
+    for (std::size_t i = 0; hits != 0; ++i, hits >>= 1) {
+      if ((hits & 1) == 0) {
+        continue;
+      }
+      Entry child{ node.child[i], node.count[i], tEntry[i] };
+      auto j = top++;
+      for (; j > first && stack[j - 1].tnear < child.tnear; --j) {
+        stack[j] = stack[j - 1];
+      }
+      stack[j] = child;
+    }
+  }
+}
+
+template<std::size_t Width>
+template<typename Visitor>
+bool WideBVH<Width>::TraverseAny(const Ray& r,
+                                 float tmin,
+                                 float tmax,
+                                 Visitor&& visit) const
+{
+  if (m_Nodes.empty()) {
+    return false;
+  }
+
+  const auto ray = MakeRayLanes(r);
+  std::uint32_t stack[StackSize];
+  int top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const Node& node = m_Nodes[stack[--top]];
+    alignas(16) float tEntry[Width];
+    auto hits = IntersectChildren(node, ray, tmin, tmax, tEntry);
+
+    for (std::size_t i = 0; hits != 0; ++i, hits >>= 1) {
+      if ((hits & 1) == 0) {
+        continue;
+      }
+      if (node.count[i] > 0) {
+        for (auto slot = node.child[i]; slot < node.child[i] + node.count[i];
+             ++slot) {
+          if (visit(slot)) {
+            return true;
+          }
+        }
+      } else {
+        stack[top++] = node.child[i];
+      }
+    }
+  }
+  return false;
+}
+
+} // namespace RayTracer::Rendering::Acceleration
@@ -3,9 +3,95 @@
 namespace RayTracer::Rendering::Cameras {
 using namespace Math;
 
+namespace {
+
+/// @brief Interleaves the bits of x and y, x taking the even ones
+std::uint32_t MortonCode(std::uint32_t x, std::uint32_t y)
+{
+  const auto spread = [](std::uint32_t v) {
+    v &= 0x0000ffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+  };
+  return spread(x) | (spread(y) << 1);
+}
+
+/**
+ * @brief Shares the camera's tiles out to pool, coloring each pixel with
+ * shader(ray, hit), where shader = makeShader(tile index) is made per tile
+ */
+template<typename MakeShader>
+Canvas RenderTiles(const Camera& camera,
+                   const World& world,
+                   Core::ThreadPool& pool,
+                   MakeShader&& makeShader)
+{
+  auto image = Canvas(camera.hsize, camera.vsize);
+  const int hsize = camera.hsize;
+  const int vsize = camera.vsize;
+
+  // build the hierarchies up front, where the build itself can go parallel
+  world.Commit();
+
+  // tiles are clipped to the canvas, so their pixels are written unchecked
+  const auto tiles = morton_ordered_tiles(hsize, vsize);
+  auto* pixels = image.data();
+  pool.ParallelFor(tiles.size(), [&](std::size_t i) {
+    const auto [x0, y0] = tiles[i];
+    const auto x1 = std::min(x0 + TileSize, hsize);
+    const auto y1 = std::min(y0 + TileSize, vsize);
+    auto shader = makeShader(i);
+    RayPacket<TileSize> packet;
+    PacketHits<TileSize> hits;
+    for (int y = y0; y < y1; ++y) {
+      ray_packet_for_row(camera, x0, y, x1 - x0, packet);
+      world.IntersectClosest(packet, hits);
+      auto* row = pixels + y * hsize + x0;
+      for_each_lane(packet.active, [&](std::size_t x) {
+        row[x] = shader(packet.Get(x), hits[x]);
+      });
+    }
+  });
+
+  return image;
+}
+
+} // namespace
+
+std::vector<Tile> morton_ordered_tiles(int width, int height)
+{
+  std::vector<Tile> tiles;
+  for (int y = 0; y < height; y += TileSize) {
+    for (int x = 0; x < width; x += TileSize) {
+      tiles.push_back({ x, y });
+    }
+  }
+  std::sort(tiles.begin(), tiles.end(), [](const Tile& a, const Tile& b) {
+    return MortonCode(a.x / TileSize, a.y / TileSize) <
+           MortonCode(b.x / TileSize, b.y / TileSize);
+  });
+  return tiles;
+}
+
+CameraTransform::CameraTransform()
+  : m_Matrix(mat4::Identity())
+  , m_Inverse(mat4::Identity())
+  , m_Origin(Point(0, 0, 0))
+{}
+
+CameraTransform& CameraTransform::operator=(const mat4& m)
+{
+  m_Matrix = m;
+  m_Inverse = inverse(m);
+  m_Origin = m_Inverse * Point(0, 0, 0);
+  return *this;
+}
+
 Camera::Camera(float h, float v, float fov)
-  : transform(mat4::Identity())
-  , hsize(h)
+  : hsize(h)
   , vsize(v)
   , field_of_view(fov)
 {
@@ -35,31 +121,120 @@ Ray ray_for_pixel(const Camera& c, float px, float py)
   // using the camera matrix, transform the canvas point and the origin,
   // and then compute the ray's direction vector.
   // (remember that the canvas is at z=-1)
-  auto pixel = inverse(c.transform) * Point(world_x, world_y, -1);
-  auto origin = inverse(c.transform) * Point(0, 0, 0);
+  const auto& origin = c.transform.GetOrigin();
+  auto pixel = c.transform.GetInverse() * Point(world_x, world_y, -1);
   auto direction = normalize(pixel - origin);
 
   return { origin, direction };
 }
 
-Canvas render(const Camera& camera, const World& world)
+void rays_for_row(const Camera& c,
+                  float px,
+                  float py,
+                  std::size_t count,
+                  std::vector<Ray>& rays)
 {
-  auto image = Canvas(camera.hsize, camera.vsize);
-  const int hsize = camera.hsize;
-  const int vsize = camera.vsize;
+  const auto& toWorld = c.transform.GetInverse();
+  const auto& origin = c.transform.GetOrigin();
+  const auto xoffset = (px + 0.5f) * c.pixel_size;
+  const auto yoffset = (py + 0.5f) * c.pixel_size;
 
-#if defined(_OPENMP)
-#pragma omp parallel for schedule(dynamic, 1) shared(camera, world, image)
-#endif
-  for (int y = 0; y < vsize; ++y) {
-    for (int x = 0; x < hsize; ++x) {
-      const auto ray = ray_for_pixel(camera, x, y);
-      const auto color = color_at(world, ray);
-      write_pixel(image, x, y, color);
-    }
+  // the canvas point moves by -pixel_size along x from one pixel to the next,
+  // so its transform moves by the transformed step
+  const auto first =
+    toWorld * Point(c.half_width - xoffset, c.half_height - yoffset, -1);
+  const auto base = first - origin;
+  const auto step = toWorld * Vector(-c.pixel_size, 0, 0);
+
+  rays.clear();
+  for (std::size_t i = 0; i < count; ++i) {
+    rays.push_back({ origin, base + step * static_cast<float>(i) });
+  }
+  for (auto& ray : rays) {
+    ray.direction = normalize(ray.direction);
   }
+}
 
-  return image;
+template<std::size_t N>
+void ray_packet_for_row(const Camera& c,
+                        float px,
+                        float py,
+                        std::size_t count,
+                        RayPacket<N>& packet)
+{
+  const auto& toWorld = c.transform.GetInverse();
+  const auto& origin = c.transform.GetOrigin();
+  const auto xoffset = (px + 0.5f) * c.pixel_size;
+  const auto yoffset = (py + 0.5f) * c.pixel_size;
+
+  const auto first =
+    toWorld * Point(c.half_width - xoffset, c.half_height - yoffset, -1);
+  const auto base = first - origin;
+  const auto step = toWorld * Vector(-c.pixel_size, 0, 0);
+
+  for (std::size_t i = 0; i < N; ++i) {
+    const auto s = static_cast<float>(i);
+    const auto x = base.x + step.x * s;
+    const auto y = base.y + step.y * s;
+    const auto z = base.z + step.z * s;
+    const auto length = std::sqrt(x * x + y * y + z * z);
+    packet.originX[i] = origin.x;
+    packet.originY[i] = origin.y;
+    packet.originZ[i] = origin.z;
+    packet.directionX[i] = x / length;
+    packet.directionY[i] = y / length;
+    packet.directionZ[i] = z / length;
+  }
+  packet.active = static_cast<LaneMask>(
+    count >= N ? RayPacket<N>::AllLanes : (LaneMask{ 1 } << count) - 1);
 }
 
+Canvas render(const Camera& camera, const World& world)
+{
+  return render(camera, world, Core::ThreadPool::GetDefault());
+}
+
+Canvas render(const Camera& camera, const World& world, Core::ThreadPool& pool)
+{
+  return RenderTiles(camera, world, pool, [&](std::size_t) {
+    return [&](const Ray& r, const std::optional<Intersection>& hit) {
+      return color_at(world, r, hit);
+    };
+  });
+}
+
+Canvas render(const Camera& camera,
+              const World& world,
+              const Integrator::Settings& settings,
+              Core::ThreadPool& pool)
+{
+  return RenderTiles(camera, world, pool, [&](std::size_t tile) {
+    const auto stream = static_cast<std::uint32_t>(tile);
+    return [&world, integrator = Integrator(settings, stream)](
+             const Ray& r, const auto& hit) mutable {
+      return integrator.Trace(world, r, hit);
+    };
+  });
+}
+
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template void ray_packet_for_row(const Camera&,
+                                 float,
+                                 float,
+                                 std::size_t,
+                                 RayPacket<4>&);
+template void ray_packet_for_row(const Camera&,
+                                 float,
+                                 float,
+                                 std::size_t,
+                                 RayPacket<8>&);
+template void ray_packet_for_row(const Camera&,
+                                 float,
+                                 float,
+                                 std::size_t,
+                                 RayPacket<16>&);
+
 } // namespace RayTracer::Rendering::Cameras
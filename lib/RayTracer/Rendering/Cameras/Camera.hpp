@@ -1,9 +1,12 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Core/ThreadPool.hpp"
 #include "RayTracer/Math/Matrix.hpp"
 #include "RayTracer/Rendering/Canvas.hpp"
 #include "RayTracer/Rendering/Lighting/Ray.hpp"
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
+#include "RayTracer/Rendering/Scene/Integrator.hpp"
 #include "RayTracer/Rendering/Scene/World.hpp"
 
 namespace RayTracer {
@@ -14,10 +17,44 @@ using namespace Math;
 using namespace Lighting;
 using namespace Scene;
 
+/**
+ * @brief A camera's view transform, with its inverse and the world-space
+ * position of the eye kept alongside
+ * @details Assigning a matrix recomputes both, so generating a ray only
+ * transforms the canvas point and never inverts anything.
+ */
+class CameraTransform
+{
+public:
+  /// @section Member functions
+  /// @subsection Special member functions
+  CameraTransform();
+  CameraTransform& operator=(const mat4& m);
+
+  /// @subsection Element access
+  float const* operator[](std::size_t row) const { return m_Matrix[row]; }
+  operator const mat4&() const { return m_Matrix; }
+
+  /// @subsection Observers
+  const mat4& GetInverse() const { return m_Inverse; }
+  /// @return the inverse applied to point(0, 0, 0)
+  const Tuple& GetOrigin() const { return m_Origin; }
+
+private:
+  mat4 m_Matrix;
+  mat4 m_Inverse;
+  Tuple m_Origin;
+};
+
+inline bool operator==(const CameraTransform& lhs, const mat4& rhs)
+{
+  return static_cast<const mat4&>(lhs) == rhs;
+}
+
 struct Camera
 {
   Camera(float h, float v, float fov);
-  mat4 transform;
+  CameraTransform transform;
   float hsize;
   float vsize;
   float field_of_view;
@@ -28,8 +65,65 @@ struct Camera
 
 Ray ray_for_pixel(const Camera& c, float px, float py);
 
+/**
+ * @brief The rays through count consecutive pixels of row py, from column px
+ * @details Only the first canvas point is transformed; the others are one
+ * transformed pixel step apart. The directions are normalized in a second
+ * pass over rays, which is cleared first.
+ */
+void rays_for_row(const Camera& c,
+                  float px,
+                  float py,
+                  std::size_t count,
+                  std::vector<Ray>& rays);
+
+/**
+ * @brief rays_for_row() into the lanes of packet, count <= N of them
+ * @details The lanes from count on are left inactive.
+ */
+template<std::size_t N>
+void ray_packet_for_row(const Camera& c,
+                        float px,
+                        float py,
+                        std::size_t count,
+                        RayPacket<N>& packet);
+
+/// @brief Renders on ThreadPool::GetDefault()
 Canvas render(const Camera& c, const World& w);
 
+/**
+ * @brief Renders in tiles of TileSize x TileSize pixels, shared out by pool
+ * @details Tiles are ordered along a Z-order (Morton) curve, so the tiles a
+ * thread is dealt, and those it steals, cover compact regions of the image
+ * rather than strips. Each row of a tile is traced as one RayPacket.
+ */
+Canvas render(const Camera& c, const World& w, Core::ThreadPool& pool);
+
+/**
+ * @brief render() with each pixel colored by an Integrator::Trace()
+ * @details Each tile has an Integrator of its own, seeded by the tile's
+ * index, so the image does not depend on how the pool deals the tiles out.
+ */
+Canvas render(const Camera& c,
+              const World& w,
+              const Integrator::Settings& settings,
+              Core::ThreadPool& pool);
+
+/// @brief Edge of the square tiles render() shares out, in pixels, and so
+/// the width of the packets it traces
+inline constexpr int TileSize = 16;
+
+/// @brief Top-left pixel of a TileSize x TileSize tile
+struct Tile
+{
+  int x;
+  int y;
+};
+
+/// @return the tiles covering width x height pixels, in Z-order; those on
+/// the right and bottom edges may reach past the image
+std::vector<Tile> morton_ordered_tiles(int width, int height);
+
 } // namespace Cameras
 } // namespace Rendering
 } // namespace RayTracer
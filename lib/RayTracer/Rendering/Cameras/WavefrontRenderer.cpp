@@ -0,0 +1,273 @@
+#include "RayTracer/Rendering/Cameras/WavefrontRenderer.hpp"
+
+#include "RayTracer/Rendering/Materials/Material.hpp"
+
+namespace RayTracer::Rendering::Cameras {
+using namespace Math;
+using namespace Materials;
+
+namespace {
+
+constexpr std::size_t PacketWidth = TileSize;
+
+/// @brief A ray to intersect, and what its color is worth in its pixel
+struct PathRay
+{
+  Ray ray;
+  float weight;
+  std::size_t pixel;
+  int depth; // bounces left after this one
+};
+
+/// @brief A hit waiting on its shadow ray to be lit
+struct ShadowRay
+{
+  Ray ray;
+  float distance; // to the light
+  float weight;
+  std::size_t pixel;
+  const Material* material;
+  const Shape* object;
+  Tuple point;
+  Tuple eyev;
+  Tuple normalv;
+};
+
+/// @brief Every ray's closest hit, PacketWidth rays at a time
+void Intersect(const World& w,
+               const std::vector<PathRay>& rays,
+               std::vector<std::optional<Intersection>>& hits)
+{
+  RayPacket<PacketWidth> packet;
+  PacketHits<PacketWidth> packetHits;
+  hits.resize(rays.size());
+  for (std::size_t first = 0; first < rays.size(); first += PacketWidth) {
+    const auto count = std::min(PacketWidth, rays.size() - first);
+    packet.active = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      packet.Set(i, rays[first + i].ray);
+    }
+    w.IntersectClosest(packet, packetHits);
+    std::copy_n(packetHits.begin(), count, hits.begin() + first);
+  }
+}
+
+/// @brief shade_hit() up to its recursion: queues each hit's shadow ray, and
+/// its reflection and refraction rays as the next bounce
+void Shade(const World& w,
+           const PointLight& light,
+           const std::vector<PathRay>& rays,
+           const std::vector<std::optional<Intersection>>& hits,
+           std::vector<ShadowRay>& shadows,
+           std::vector<PathRay>& next,
+           WavefrontRenderer::Stats& stats)
+{
+  Intersections xs;
+  std::vector<const Shape*> containers;
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    if (!hits[i]) {
+      continue;
+    }
+    ++stats.hits;
+    const auto& path = rays[i];
+    const auto& hit = *hits[i];
+    const auto& material = hit.object->GetMaterial();
+
+    // as in color_at(), refraction needs every crossing along the ray to
+    // find n1 and n2; opaque surfaces only need the hit
+    const auto comps = [&] {
+      if (material.transparency > 0) {
+        intersect_world(w, path.ray, xs);
+        return prepare_computations(hit, path.ray, &xs, &containers);
+      }
+      return prepare_computations(hit, path.ray);
+    }();
+
+    const auto toLight = light.position - comps.over_point;
+    shadows.push_back({ Ray{ comps.over_point, normalize(toLight) },
+                        magnitude(toLight),
+                        path.weight,
+                        path.pixel,
+                        &material,
+                        comps.object,
+                        comps.over_point,
+                        comps.eyev,
+                        comps.normalv });
+
+    if (path.depth < 1) {
+      continue;
+    }
+    auto reflectance = 1.0f;
+    auto transmittance = 1.0f;
+    if (material.reflective > 0 && material.transparency > 0) {
+      reflectance = schlick(comps);
+      transmittance = 1 - reflectance;
+    }
+    if (material.reflective != 0) {
+      next.push_back({ Ray{ comps.over_point, comps.reflectv },
+                       path.weight * material.reflective * reflectance,
+                       path.pixel,
+                       path.depth - 1 });
+      ++stats.reflectionRays;
+    }
+    if (material.transparency != 0) {
+      if (const auto ray = refracted_ray(comps)) {
+        next.push_back({ *ray,
+                         path.weight * material.transparency * transmittance,
+                         path.pixel,
+                         path.depth - 1 });
+        ++stats.refractionRays;
+      }
+    }
+  }
+}
+
+/// @brief Lights each queued hit, as its shadow ray finds it
+void LightHits(const World& w,
+               const PointLight& light,
+               const std::vector<ShadowRay>& shadows,
+               Color* pixels)
+{
+  for (const auto& shadow : shadows) {
+    const auto occluded = w.Occluded(shadow.ray, shadow.distance);
+    const auto surface = lighting(*shadow.material,
+                                  light,
+                                  shadow.point,
+                                  shadow.eyev,
+                                  shadow.normalv,
+                                  occluded,
+                                  shadow.object);
+    pixels[shadow.pixel] = pixels[shadow.pixel] + surface * shadow.weight;
+  }
+}
+
+void Accumulate(WavefrontRenderer::Stats& total,
+                const WavefrontRenderer::Stats& batch)
+{
+  total.primaryRays += batch.primaryRays;
+  total.hits += batch.hits;
+  total.shadowRays += batch.shadowRays;
+  total.reflectionRays += batch.reflectionRays;
+  total.refractionRays += batch.refractionRays;
+  if (total.raysPerBounce.size() < batch.raysPerBounce.size()) {
+    total.raysPerBounce.resize(batch.raysPerBounce.size(), 0);
+  }
+  for (std::size_t i = 0; i < batch.raysPerBounce.size(); ++i) {
+    total.raysPerBounce[i] += batch.raysPerBounce[i];
+  }
+  total.peakRayQueue = std::max(total.peakRayQueue, batch.peakRayQueue);
+  total.peakShadowQueue =
+    std::max(total.peakShadowQueue, batch.peakShadowQueue);
+}
+
+} // namespace
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Special member functions
+/// ---------------------------------------------------------------------------
+
+WavefrontRenderer::WavefrontRenderer(const Settings& settings)
+  : m_Settings(settings)
+{}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+const WavefrontRenderer::Settings& WavefrontRenderer::GetSettings() const
+{
+  return m_Settings;
+}
+
+const WavefrontRenderer::Stats& WavefrontRenderer::GetStats() const
+{
+  return m_Stats;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Operations
+/// ---------------------------------------------------------------------------
+
+Canvas WavefrontRenderer::Render(const Camera& c, const World& w)
+{
+  return Render(c, w, Core::ThreadPool::GetDefault());
+}
+
+Canvas WavefrontRenderer::Render(const Camera& camera,
+                                 const World& world,
+                                 Core::ThreadPool& pool)
+{
+  auto image = Canvas(camera.hsize, camera.vsize);
+  const int hsize = camera.hsize;
+  const int vsize = camera.vsize;
+  m_Stats = {};
+
+  world.Commit();
+
+  const auto tiles = morton_ordered_tiles(hsize, vsize);
+  const auto batchSize = std::max<std::size_t>(m_Settings.tilesPerBatch, 1);
+  const auto batchCount = (tiles.size() + batchSize - 1) / batchSize;
+  std::vector<Stats> batchStats(batchCount);
+  auto* pixels = image.data();
+  const auto light = world.GetLightSource();
+
+  // a batch's pixels are its own, so batches accumulate into them unchecked
+  pool.ParallelFor(batchCount, [&](std::size_t batch) {
+    auto& stats = batchStats[batch];
+    std::vector<PathRay> rays;
+    std::vector<PathRay> next;
+    std::vector<ShadowRay> shadows;
+    std::vector<std::optional<Intersection>> hits;
+
+    // primary rays, a tile row at a time
+    std::vector<Ray> row;
+    const auto first = batch * batchSize;
+    const auto last = std::min(tiles.size(), first + batchSize);
+    for (auto tile = first; tile < last; ++tile) {
+      const auto [x0, y0] = tiles[tile];
+      const auto x1 = std::min(x0 + TileSize, hsize);
+      const auto y1 = std::min(y0 + TileSize, vsize);
+      for (int y = y0; y < y1; ++y) {
+        rays_for_row(camera, x0, y, x1 - x0, row);
+        for (std::size_t i = 0; i < row.size(); ++i) {
+          const auto pixel = static_cast<std::size_t>(y) * hsize + x0 + i;
+          rays.push_back({ row[i], 1.0f, pixel, m_Settings.depth });
+        }
+      }
+    }
+    stats.primaryRays = rays.size();
+
+    while (!rays.empty()) {
+      stats.raysPerBounce.push_back(rays.size());
+      stats.peakRayQueue = std::max(stats.peakRayQueue, rays.size());
+
+      Intersect(world, rays, hits);
+      if (!light) {
+        // shade_hit() is black without a light, reflections and all
+        stats.hits += std::count_if(
+          hits.begin(), hits.end(), [](const auto& hit) { return hit; });
+        break;
+      }
+      Shade(world, *light, rays, hits, shadows, next, stats);
+
+      stats.shadowRays += shadows.size();
+      stats.peakShadowQueue = std::max(stats.peakShadowQueue, shadows.size());
+      LightHits(world, *light, shadows, pixels);
+
+      shadows.clear();
+      rays.swap(next);
+      next.clear();
+    }
+  });
+
+  for (const auto& stats : batchStats) {
+    Accumulate(m_Stats, stats);
+  }
+  return image;
+}
+
+} // namespace RayTracer::Rendering::Cameras
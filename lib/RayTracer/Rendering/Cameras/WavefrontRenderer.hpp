@@ -0,0 +1,73 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Core/ThreadPool.hpp"
+#include "RayTracer/Rendering/Cameras/Camera.hpp"
+#include "RayTracer/Rendering/Canvas.hpp"
+#include "RayTracer/Rendering/Scene/World.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+namespace Cameras {
+
+/**
+ * @brief Breadth-first alternative to render()
+ * @details render() follows each pixel's rays depth-first, through
+ * color_at(), shade_hit() and the reflected and refracted colors. This
+ * renderer takes a batch of tiles through one stage at a time instead: it
+ * generates all their primary rays, intersects them in packets, shades every
+ * hit, tests the shadow rays the shading queued, and carries on with the
+ * reflection and refraction rays it queued as the next bounce. Each ray
+ * carries the weight its color has in its pixel, the product the recursion
+ * would have applied on the way back, so the image matches render()'s up to
+ * rounding.
+ *
+ * Batches run in parallel, each through queues of its own. What the last
+ * Render() traced is kept in GetStats().
+ */
+class WavefrontRenderer
+{
+public:
+  /// @section Member types
+  struct Settings
+  {
+    std::size_t tilesPerBatch{ 16 };
+    int depth{ 5 }; // bounces after the primary rays, as color_at()'s
+  };
+
+  /// @brief Counts summed over a frame's batches; peaks are per batch
+  struct Stats
+  {
+    std::size_t primaryRays{ 0 };
+    std::size_t hits{ 0 };
+    std::size_t shadowRays{ 0 };
+    std::size_t reflectionRays{ 0 };
+    std::size_t refractionRays{ 0 };
+    /// rays intersected in each bounce, the primary rays first
+    std::vector<std::size_t> raysPerBounce;
+    std::size_t peakRayQueue{ 0 };
+    std::size_t peakShadowQueue{ 0 };
+  };
+
+  /// @section Member functions
+  /// @subsection Special member functions
+  WavefrontRenderer() = default;
+  explicit WavefrontRenderer(const Settings& settings);
+
+  /// @subsection Observers
+  const Settings& GetSettings() const;
+  const Stats& GetStats() const;
+
+  /// @subsection Operations
+  /// @brief Renders on ThreadPool::GetDefault()
+  Canvas Render(const Camera& c, const World& w);
+  Canvas Render(const Camera& c, const World& w, Core::ThreadPool& pool);
+
+private:
+  Settings m_Settings{};
+  Stats m_Stats{};
+};
+
+} // namespace Cameras
+} // namespace Rendering
+} // namespace RayTracer
@@ -2,6 +2,7 @@
 
 // TODO: include Core.hpp instead
 #include "RayTracer/Core/Assertions.hpp"
+#include "RayTracer/Core/Cpu.hpp"
 
 #include "RayTracer/Rendering/Color.hpp"
 
@@ -45,6 +46,16 @@ std::size_t Canvas::size() const
   return pixels.size();
 }
 
+const Color* Canvas::data() const
+{
+  return pixels.data();
+}
+
+Color* Canvas::data()
+{
+  return pixels.data();
+}
+
 /// ---------------------------------------------------------------------------
 /// @subsection Observers
 /// ---------------------------------------------------------------------------
@@ -90,17 +101,19 @@ std::string canvas_to_ppm(const Canvas& c)
   result += std::to_string(c.width) + " " + std::to_string(c.height) + "\n";
   result += std::to_string(255) + "\n";
 
+  // Quantize the whole canvas at once, four bytes (r, g, b, padding) a pixel
+  std::vector<std::uint8_t> bytes(c.size() * 4);
+  Cpu::ActiveKernels().encodeColors(&c.data()->r, c.size(), bytes.data());
+
   // PPM Body
   for (auto row = 0U; row < c.height; ++row) {
     int currentWidth = 0;
     std::string line = "";
     for (auto col = 0U; col < c.width; ++col) {
-      const auto& color = c.pixel_at(col, row);
-      line +=
-        std::to_string((int)(std::clamp(color.r * 256, 0.0f, 255.0f))) + " ";
-      line +=
-        std::to_string((int)(std::clamp(color.g * 256, 0.0f, 255.0f))) + " ";
-      line += std::to_string((int)(std::clamp(color.b * 256, 0.0f, 255.0f)));
+      const auto* rgb = &bytes[(row * c.width + col) * 4];
+      line += std::to_string(rgb[0]) + " ";
+      line += std::to_string(rgb[1]) + " ";
+      line += std::to_string(rgb[2]);
 
       if (col < c.width - 1) {
         line += " ";
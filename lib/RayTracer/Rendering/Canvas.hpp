@@ -19,6 +19,11 @@ public:
   /// @subsection Capacity
   std::size_t size() const;
 
+  /// @brief Pixels in row-major order
+  const Color* data() const;
+  /// @brief Unchecked writes, for renderers that clip to the canvas
+  Color* data();
+
   /// @subsection Observers
   const Color& pixel_at(int w, int h) const;
 
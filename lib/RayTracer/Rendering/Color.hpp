@@ -1,29 +1,67 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Math/Constants.hpp"
+#include "RayTracer/Math/SIMD.hpp"
+
 namespace RayTracer::Rendering::Colors {
 
-struct Color
+/**
+ * @brief Linear RGB color
+ * @details Padded to four 16-byte aligned lanes so the arithmetic below maps
+ * onto one Math::Float4. The padding lane is not an alpha channel.
+ */
+struct alignas(16) Color
 {
   float r{ 1.0f };
   float g{ 1.0f };
   float b{ 1.0f };
-  // float a{ 1.0f };
+  float unused{ 0.0f };
+
+  Math::Float4 Lanes() const { return Math::Float4::Load(&r); }
+  static Color FromLanes(Math::Float4 v)
+  {
+    Color c;
+    v.Store(&c.r);
+    return c;
+  }
 };
 
 /// @section Non-member functions
 
 /// @subsection Arithmetic operators
 
-Color operator+(const Color& lhs, const Color& rhs);
-Color operator-(const Color& lhs, const Color& rhs);
-Color operator*(const Color& lhs, const Color& rhs);
-Color operator*(const Color& lhs, float scalar);
+inline Color operator+(const Color& lhs, const Color& rhs)
+{
+  return Color::FromLanes(lhs.Lanes() + rhs.Lanes());
+}
+
+inline Color operator-(const Color& lhs, const Color& rhs)
+{
+  return Color::FromLanes(lhs.Lanes() - rhs.Lanes());
+}
+
+inline Color operator*(const Color& lhs, const Color& rhs)
+{
+  return Color::FromLanes(lhs.Lanes() * rhs.Lanes());
+}
+
+inline Color operator*(const Color& lhs, float scalar)
+{
+  return Color::FromLanes(lhs.Lanes() * Math::Float4::Splat(scalar));
+}
+
 std::ostream& operator<<(std::ostream& os, const Color& c);
 
 /// @subsection Logic operators
 
-bool operator==(const Color& lhs, const Color& rhs);
+inline bool operator==(const Color& lhs, const Color& rhs)
+{
+  using namespace Math::Constants;
+  return std::abs(lhs.r - rhs.r) < EPSILON &&
+         std::abs(lhs.g - rhs.g) < EPSILON &&
+         std::abs(lhs.b - rhs.b) < EPSILON; //
+}
 
 /// @subsection Color API
 
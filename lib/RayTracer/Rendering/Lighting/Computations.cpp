@@ -40,39 +40,32 @@ Computations prepare_computations(const Intersection& i,
     return comps;
   }
 
-  if (auto hit = xs->Hit(); hit) {
-    /// -----------------------------------------------------------------------
-    /// Helper functions
-    const auto has = [&objects](const Shape* obj) {
-      return std::find(objects->begin(), objects->end(), obj) != objects->end();
-    };
-    const auto remove = [&objects](const Shape* obj) {
-      objects->erase(std::remove(objects->begin(), objects->end(), obj));
-    };
-    const auto add = [&objects](const Shape* obj) { objects->push_back(obj); };
-    /// -----------------------------------------------------------------------
-
-    for (const auto& intersection : xs->GetIntersectionPoints()) {
-      const auto* object = i.object;
-
-      if (intersection == *hit) {
-        if (!objects->empty()) {
-          comps.n1 = objects->back()->GetMaterial().refractiveIndex;
-        }
-      }
+  // Replay the crossings up to the hit, tracking the objects the ray is
+  // inside; n1 and n2 are those of the innermost one before and after it.
+  // The hit is matched by object and t rather than compared exactly, as it
+  // may come from a closest-hit query rounding slightly differently.
+  objects->clear();
+  for (const auto& intersection : xs->GetIntersectionPoints()) {
+    const bool isHit =
+      intersection.object == i.object && intersection.t >= i.t - EPSILON;
+
+    if (isHit && !objects->empty()) {
+      comps.n1 = objects->back()->GetMaterial().refractiveIndex;
+    }
 
-      if (has(object)) {
-        remove(object);
-      } else {
-        add(object);
-      }
+    const auto it =
+      std::find(objects->begin(), objects->end(), intersection.object);
+    if (it != objects->end()) {
+      objects->erase(it);
+    } else {
+      objects->push_back(intersection.object);
+    }
 
-      if (intersection == *hit) {
-        if (!objects->empty()) {
-          comps.n2 = objects->back()->GetMaterial().refractiveIndex;
-        }
-        break;
+    if (isHit) {
+      if (!objects->empty()) {
+        comps.n2 = objects->back()->GetMaterial().refractiveIndex;
       }
+      break;
     }
   }
 
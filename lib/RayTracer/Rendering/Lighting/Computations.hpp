@@ -36,6 +36,11 @@ class Intersections;
 struct Intersection;
 struct Ray;
 
+/**
+ * @brief The state shading needs at the hit i of r
+ * @details n1 and n2 are only found when both xs, every crossing along r in
+ * order, and objects are given; objects is scratch storage, cleared first.
+ */
 Computations prepare_computations(const Intersection& i,
                                   const Ray& r,
                                   const Intersections* xs = nullptr,
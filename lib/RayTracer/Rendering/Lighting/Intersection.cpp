@@ -19,38 +19,95 @@ using namespace Math;
 Intersections::Intersections() = default;
 
 Intersections::Intersections(std::initializer_list<Intersection> points)
-  : intersectionPoints(points)
-{}
+{
+  Reserve(points.size());
+  for (const auto& point : points) {
+    Add(point);
+  }
+}
 
 Intersections::Intersections(std::vector<Intersection>&& points)
-  : intersectionPoints(points)
-{}
+  : count(points.size())
+{
+  if (count <= InlineCapacity) {
+    std::copy(points.begin(), points.end(), inlinePoints);
+  } else {
+    heapPoints = std::move(points);
+    onHeap = true;
+  }
+}
 
 Intersections::Intersections(float t, const Shape* shapePtr)
-  : intersectionPoints()
 {
-  intersectionPoints.emplace_back(t, shapePtr);
+  Add({ t, shapePtr });
+}
+
+Intersections::Intersections(const Intersections& other)
+  : count(other.count)
+  , onHeap(other.onHeap)
+  , heapPoints(other.heapPoints)
+{
+  if (!onHeap) {
+    std::copy_n(other.inlinePoints, count, inlinePoints);
+  }
+}
+
+Intersections::Intersections(Intersections&& other)
+  : count(other.count)
+  , onHeap(other.onHeap)
+  , heapPoints(std::move(other.heapPoints))
+{
+  if (!onHeap) {
+    std::copy_n(other.inlinePoints, count, inlinePoints);
+  }
+  other.count = 0;
+  other.onHeap = false;
 }
 
-Intersections::Intersections(const Intersections& other) = default;
-Intersections::Intersections(Intersections&& other) = default;
 Intersections::~Intersections() = default;
-Intersections& Intersections::operator=(const Intersections& other) = default;
-Intersections& Intersections::operator=(Intersections&& other) = default;
+
+Intersections& Intersections::operator=(const Intersections& other)
+{
+  if (this != &other) {
+    count = other.count;
+    onHeap = other.onHeap;
+    heapPoints = other.heapPoints;
+    if (!onHeap) {
+      std::copy_n(other.inlinePoints, count, inlinePoints);
+    }
+  }
+  return *this;
+}
+
+Intersections& Intersections::operator=(Intersections&& other)
+{
+  if (this != &other) {
+    count = other.count;
+    onHeap = other.onHeap;
+    heapPoints = std::move(other.heapPoints);
+    if (!onHeap) {
+      std::copy_n(other.inlinePoints, count, inlinePoints);
+    }
+    other.heapPoints.clear();
+    other.count = 0;
+    other.onHeap = false;
+  }
+  return *this;
+}
 
 /// ---------------------------------------------------------------------------
 /// @subsubsection Element access
 /// ---------------------------------------------------------------------------
 Intersection& Intersections::operator[](std::size_t index)
 {
-  assert(index >= 0 && index < intersectionPoints.size());
-  return intersectionPoints[index];
+  assert(index < count);
+  return Storage()[index];
 }
 
 Intersection Intersections::operator[](std::size_t index) const
 {
-  assert(index >= 0 && index < intersectionPoints.size());
-  return intersectionPoints[index];
+  assert(index < count);
+  return Storage()[index];
 }
 
 /// ---------------------------------------------------------------------------
@@ -59,40 +116,87 @@ Intersection Intersections::operator[](std::size_t index) const
 
 std::size_t Intersections::Count() const
 {
-  return intersectionPoints.size();
+  return count;
 }
 
 void Intersections::Reserve(std::size_t newCapacity)
 {
-  intersectionPoints.reserve(newCapacity);
+  if (onHeap) {
+    heapPoints.reserve(newCapacity);
+  } else if (newCapacity > InlineCapacity) {
+    Spill(newCapacity);
+  }
 }
 
-void Intersections::Sort()
+void Intersections::Sort(std::size_t first)
 {
-  std::sort(intersectionPoints.begin(), intersectionPoints.end());
+  if (first < count) {
+    std::sort(Storage() + first, Storage() + count);
+  }
 }
 
 /// ---------------------------------------------------------------------------
 /// @subsubsection Observers
 /// ---------------------------------------------------------------------------
 
-const std::vector<Intersection>& Intersections::GetIntersectionPoints() const
+std::span<const Intersection> Intersections::GetIntersectionPoints() const
 {
-  return intersectionPoints;
+  return { Storage(), count };
+}
+
+bool Intersections::IsInline() const
+{
+  return !onHeap;
 }
 
 /// ---------------------------------------------------------------------------
 /// @subsubsection Modifiers
 /// ---------------------------------------------------------------------------
 
-std::vector<Intersection>& Intersections::Data()
+std::span<Intersection> Intersections::Data()
 {
-  return intersectionPoints;
+  return { Storage(), count };
 }
 
 void Intersections::Add(Intersection i)
 {
-  intersectionPoints.push_back(i);
+  if (onHeap) {
+    heapPoints.push_back(i);
+  } else if (count < InlineCapacity) {
+    inlinePoints[count] = i;
+  } else {
+    Spill(2 * InlineCapacity);
+    heapPoints.push_back(i);
+  }
+  ++count;
+}
+
+void Intersections::Clear()
+{
+  // a spilled list keeps its heap buffer, to be refilled without allocating
+  heapPoints.clear();
+  count = 0;
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+Intersection* Intersections::Storage()
+{
+  return onHeap ? heapPoints.data() : inlinePoints;
+}
+
+const Intersection* Intersections::Storage() const
+{
+  return onHeap ? heapPoints.data() : inlinePoints;
+}
+
+void Intersections::Spill(std::size_t newCapacity)
+{
+  heapPoints.reserve(newCapacity);
+  heapPoints.assign(inlinePoints, inlinePoints + count);
+  onHeap = true;
 }
 
 /// ===========================================================================
@@ -106,17 +210,17 @@ const Intersection* Intersections::Hit() const
   // NOTE: basic benchmark tells two loops is faster
   // first loop gets result to non-nullptr
   std::size_t start = 0;
-  for (; start < Count(); ++start) {
-    if (intersectionPoints[start].t >= 0) {
-      result = &intersectionPoints[start++];
+  const auto* points = Storage();
+  for (; start < count; ++start) {
+    if (points[start].t >= 0) {
+      result = &points[start++];
       break;
     }
   }
   // second loop completes the search
-  for (; start < Count(); ++start) {
-    if (intersectionPoints[start].t >= 0 &&
-        intersectionPoints[start].t < result->t) {
-      result = &intersectionPoints[start];
+  for (; start < count; ++start) {
+    if (points[start].t >= 0 && points[start].t < result->t) {
+      result = &points[start];
     }
   }
 
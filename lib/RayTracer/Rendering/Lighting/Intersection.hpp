@@ -26,6 +26,8 @@ struct Intersection
   const Shape* object;
   float u{ 0.0 };
   float v{ 0.0 };
+  std::uint32_t primitive{ 0 }; // which triangle of a TriangleMesh was hit
+  const Shape* leaf{ nullptr }; // for an Instance, the geometry's shape hit
 };
 
 inline bool operator<(const Intersection& lhs, const Intersection& rhs)
@@ -35,16 +37,25 @@ inline bool operator<(const Intersection& lhs, const Intersection& rhs)
 
 inline bool operator==(const Intersection& lhs, const Intersection& rhs)
 {
-  return lhs.t == rhs.t && lhs.object == rhs.object;
+  return lhs.t == rhs.t && lhs.object == rhs.object &&
+         lhs.primitive == rhs.primitive;
 }
 
 /// ===========================================================================
 /// @section Intersections
 /// ===========================================================================
 
+/**
+ * @brief List of intersections along one ray
+ * @details The first InlineCapacity entries live inside the object, so the
+ * common cases (a primitive's two crossings, the hits of a small scene) never
+ * touch the heap. Longer lists move to a heap buffer once.
+ */
 class Intersections
 {
 public:
+  static constexpr std::size_t InlineCapacity = 16;
+
   /// @section Member functions
   Intersections();
   explicit Intersections(std::initializer_list<Intersection> points);
@@ -65,22 +76,32 @@ public:
   void Reserve(std::size_t newCapacity);
 
   /// @subsection Observers
-  const std::vector<Intersection>& GetIntersectionPoints() const;
+  std::span<const Intersection> GetIntersectionPoints() const;
+  bool IsInline() const;
 
   /// @subsection Modifiers
-  std::vector<Intersection>& Data();
+  std::span<Intersection> Data();
   template<typename... Args>
   void EmplaceBack(Args&&... args)
   {
-    intersectionPoints.emplace_back(std::forward<Args>(args)...);
+    Add(Intersection{ std::forward<Args>(args)... });
   }
   void Add(Intersection i);
+  void Clear();
 
-  void Sort();
+  /// @brief Sorts the entries from index first onward
+  void Sort(std::size_t first = 0);
   const Intersection* Hit() const;
 
 private:
-  std::vector<Intersection> intersectionPoints;
+  Intersection* Storage();
+  const Intersection* Storage() const;
+  void Spill(std::size_t newCapacity);
+
+  std::size_t count{ 0 };
+  bool onHeap{ false };
+  std::vector<Intersection> heapPoints; // every entry, once onHeap
+  Intersection inlinePoints[InlineCapacity];
 };
 
 } // namespace Lighting
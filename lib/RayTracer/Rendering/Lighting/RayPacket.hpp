@@ -0,0 +1,107 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Core/Cpu.hpp"
+#include "RayTracer/Math/Matrix.hpp"
+#include "RayTracer/Rendering/Lighting/Intersection.hpp"
+#include "RayTracer/Rendering/Lighting/Ray.hpp"
+
+#include <bit>
+
+namespace RayTracer {
+namespace Rendering {
+namespace Lighting {
+
+using namespace Math;
+
+/// @brief One bit per lane of a RayPacket, lane i in bit i
+using LaneMask = std::uint32_t;
+
+/**
+ * @brief N rays in structure-of-arrays layout, traced together
+ * @details Kernels over a packet run one plain loop per step across all N
+ * lanes, which the compiler maps to whatever vector width it targets, and
+ * report their results as a LaneMask. The primitive kernels are compiled for
+ * every Cpu::KernelSet and picked at runtime. Lanes outside active hold no
+ * ray; their values are kept finite but are meaningless.
+ */
+template<std::size_t N>
+struct RayPacket
+{
+  static_assert(N == 4 || N == 8 || N == 16, "N must be 4, 8 or 16");
+  static constexpr LaneMask AllLanes = (LaneMask{ 1 } << N) - 1;
+
+  alignas(64) float originX[N]{};
+  alignas(64) float originY[N]{};
+  alignas(64) float originZ[N]{};
+  alignas(64) float directionX[N]{};
+  alignas(64) float directionY[N]{};
+  alignas(64) float directionZ[N]{};
+  LaneMask active{ 0 };
+
+  /// @brief Stores r in lane and marks the lane active
+  void Set(std::size_t lane, const Ray& r)
+  {
+    originX[lane] = r.origin.x;
+    originY[lane] = r.origin.y;
+    originZ[lane] = r.origin.z;
+    directionX[lane] = r.direction.x;
+    directionY[lane] = r.direction.y;
+    directionZ[lane] = r.direction.z;
+    active |= LaneMask{ 1 } << lane;
+  }
+
+  Ray Get(std::size_t lane) const
+  {
+    return { Point(originX[lane], originY[lane], originZ[lane]),
+             Vector(directionX[lane], directionY[lane], directionZ[lane]) };
+  }
+
+  /// @brief Every lane, as the Cpu::Kernels take them
+  Cpu::RayLanes Lanes() const
+  {
+    return { originX, originY, originZ, directionX, directionY, directionZ, N };
+  }
+};
+
+/// @brief The closest hit of each lane of a RayPacket<N>, if any
+template<std::size_t N>
+using PacketHits = std::array<std::optional<Intersection>, N>;
+
+/// @brief Calls f(lane) for every lane set in mask, lowest first
+template<typename F>
+void for_each_lane(LaneMask mask, F&& f)
+{
+  for (; mask != 0; mask &= mask - 1) {
+    f(static_cast<std::size_t>(std::countr_zero(mask)));
+  }
+}
+
+/// @brief transform() of every lane; the directions are not renormalized
+template<std::size_t N>
+RayPacket<N> transform(const RayPacket<N>& p, const mat4& m)
+{
+  RayPacket<N> result;
+  for (std::size_t i = 0; i < N; ++i) {
+    const auto ox = p.originX[i];
+    const auto oy = p.originY[i];
+    const auto oz = p.originZ[i];
+    result.originX[i] = m[0][0] * ox + m[0][1] * oy + m[0][2] * oz + m[0][3];
+    result.originY[i] = m[1][0] * ox + m[1][1] * oy + m[1][2] * oz + m[1][3];
+    result.originZ[i] = m[2][0] * ox + m[2][1] * oy + m[2][2] * oz + m[2][3];
+  }
+  for (std::size_t i = 0; i < N; ++i) {
+    const auto dx = p.directionX[i];
+    const auto dy = p.directionY[i];
+    const auto dz = p.directionZ[i];
+    result.directionX[i] = m[0][0] * dx + m[0][1] * dy + m[0][2] * dz;
+    result.directionY[i] = m[1][0] * dx + m[1][1] * dy + m[1][2] * dz;
+    result.directionZ[i] = m[2][0] * dx + m[2][1] * dy + m[2][2] * dz;
+  }
+  result.active = p.active;
+  return result;
+}
+
+} // namespace Lighting
+} // namespace Rendering
+} // namespace RayTracer
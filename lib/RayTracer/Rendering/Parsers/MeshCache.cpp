@@ -0,0 +1,352 @@
+#include "RayTracer/Rendering/Parsers/MeshCache.hpp"
+
+#include "RayTracer/Rendering/Parsers/OBJParser.hpp"
+#include "RayTracer/Rendering/Primitives/TriangleMesh.hpp"
+#include "RayTracer/Utils/OBJFile.hpp"
+
+#include <random>
+
+namespace RayTracer {
+namespace Rendering {
+namespace Parsers {
+using namespace RayTracer::Math;
+using namespace RayTracer::Utils;
+using namespace RayTracer::Rendering::Acceleration;
+using namespace RayTracer::Rendering::Primitives;
+
+namespace {
+
+/// bumped whenever the layout of an entry, a Node or a Tuple changes
+constexpr std::uint32_t FormatVersion = 1;
+constexpr char Magic[8] = { 'R', 'T', 'M', 'E', 'S', 'H', '\0', '\0' };
+
+/// @brief Fixed-size start of an entry; the arrays follow in field order
+struct EntryHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t depth;
+  std::uint64_t key;
+  std::uint64_t vertexCount;
+  std::uint64_t normalCount;
+  std::uint64_t indexCount;
+  std::uint64_t normalIndexCount;
+  std::uint64_t nodeCount;
+  std::uint64_t leafCount;
+  double milliseconds;
+  float sahCost;
+  std::uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<Tuple>);
+static_assert(std::is_trivially_copyable_v<BVH::Node>);
+static_assert(std::is_trivially_copyable_v<EntryHeader>);
+
+std::string ReadBytes(const std::filesystem::path& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Unable to open file");
+  }
+  return { std::istreambuf_iterator<char>(file),
+           std::istreambuf_iterator<char>() };
+}
+
+/// @brief 64-bit FNV-1a
+class Hasher
+{
+public:
+  void Add(const void* data, std::size_t size)
+  {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      m_Hash = (m_Hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+  }
+
+  template<typename T>
+  void Add(const T& value)
+  {
+    Add(&value, sizeof(value));
+  }
+
+  std::uint64_t Get() const { return m_Hash; }
+
+private:
+  std::uint64_t m_Hash{ 0xcbf29ce484222325ull };
+};
+
+/// @brief Only the settings the binary hierarchy depends on; the width is
+/// applied by collapsing it after a load
+std::uint64_t KeyOf(const std::string& contents,
+                    const BVH::BuildSettings& settings)
+{
+  Hasher hasher;
+  hasher.Add(contents.data(), contents.size());
+  hasher.Add(FormatVersion);
+  hasher.Add(static_cast<std::uint32_t>(settings.splitMethod));
+  hasher.Add(settings.maxLeafSize);
+  hasher.Add(settings.binCount);
+  return hasher.Get();
+}
+
+std::string EntryNameOf(std::uint64_t key)
+{
+  char name[32];
+  std::snprintf(name,
+                sizeof(name),
+                "%016llx.rtmesh",
+                static_cast<unsigned long long>(key));
+  return name;
+}
+
+/// @param fill placeholder for the elements about to be read over
+template<typename T>
+bool ReadArray(std::ifstream& file,
+               std::vector<T>& array,
+               std::uint64_t count,
+               const T& fill = {})
+{
+  array.assign(count, fill);
+  const auto size = static_cast<std::streamsize>(count * sizeof(T));
+  return static_cast<bool>(
+    file.read(reinterpret_cast<char*>(array.data()), size));
+}
+
+template<typename T>
+void WriteArray(std::ofstream& file, const std::vector<T>& array)
+{
+  file.write(reinterpret_cast<const char*>(array.data()),
+             static_cast<std::streamsize>(array.size() * sizeof(T)));
+}
+
+bool AllBelow(const std::vector<std::uint32_t>& indices, std::uint64_t bound)
+{
+  return std::all_of(indices.begin(), indices.end(), [&](std::uint32_t i) {
+    return i < bound;
+  });
+}
+
+/// @brief Checks that traversing nodes stays within nodes and slotCount
+/// slots, and within the depth a traversal stack can hold
+bool IsTraversable(const std::vector<BVH::Node>& nodes,
+                   std::uint64_t slotCount)
+{
+  // children follow their parent, so depths are known before they are needed
+  std::vector<std::uint32_t> depth(nodes.size(), 0);
+  for (std::size_t index = 0; index < nodes.size(); ++index) {
+    const auto& node = nodes[index];
+    if (depth[index] > BVH::MaxDepth) {
+      return false;
+    }
+    if (node.IsLeaf()) {
+      if (std::uint64_t{ node.offset } + node.count > slotCount) {
+        return false;
+      }
+      continue;
+    }
+    if (node.offset <= index + 1 || node.offset >= nodes.size()) {
+      return false;
+    }
+    depth[index + 1] = std::max(depth[index + 1], depth[index] + 1);
+    depth[node.offset] = std::max(depth[node.offset], depth[index] + 1);
+  }
+  return true;
+}
+
+} // namespace
+
+/// ==========================================================================
+/// @section Member functions
+/// ==========================================================================
+
+/// --------------------------------------------------------------------------
+/// @subsection Special member functions
+/// --------------------------------------------------------------------------
+
+MeshCache::MeshCache(std::filesystem::path directory)
+  : m_Directory(std::move(directory))
+{}
+
+/// --------------------------------------------------------------------------
+/// @subsection Observers
+/// --------------------------------------------------------------------------
+
+const std::filesystem::path& MeshCache::GetDirectory() const
+{
+  return m_Directory;
+}
+
+std::size_t MeshCache::GetHitCount() const
+{
+  return m_Hits;
+}
+
+std::size_t MeshCache::GetMissCount() const
+{
+  return m_Misses;
+}
+
+std::filesystem::path MeshCache::GetEntryPath(
+  const std::filesystem::path& objFile,
+  const BVH::BuildSettings& settings) const
+{
+  return m_Directory / EntryNameOf(KeyOf(ReadBytes(objFile), settings));
+}
+
+/// --------------------------------------------------------------------------
+/// @subsection Creation Methods
+/// --------------------------------------------------------------------------
+
+std::shared_ptr<TriangleMesh> MeshCache::Load(
+  const std::filesystem::path& objFile,
+  const BVH::BuildSettings& settings)
+{
+  const auto key = KeyOf(ReadBytes(objFile), settings);
+  const auto entry = m_Directory / EntryNameOf(key);
+  if (auto mesh = Read(entry, key, settings)) {
+    ++m_Hits;
+    return mesh;
+  }
+
+  ++m_Misses;
+  const OBJParser parser(OBJFile(objFile.string().c_str()));
+  auto mesh = parser.GetMesh(settings);
+  Write(entry, key, *mesh);
+  return mesh;
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+std::shared_ptr<TriangleMesh> MeshCache::Read(
+  const std::filesystem::path& entry,
+  std::uint64_t key,
+  const BVH::BuildSettings& settings) const
+{
+  std::ifstream file(entry, std::ios::binary);
+  if (!file.is_open()) {
+    return nullptr;
+  }
+
+  EntryHeader header{};
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+      header.version != FormatVersion || header.key != key) {
+    return nullptr;
+  }
+
+  // a truncated or padded entry is as good as a missing one
+  std::error_code error;
+  const auto expectedSize =
+    sizeof(header) +
+    (header.vertexCount + header.normalCount) * sizeof(Tuple) +
+    (header.indexCount + header.normalIndexCount + header.indexCount / 3) *
+      sizeof(std::uint32_t) +
+    header.nodeCount * sizeof(BVH::Node);
+  if (std::filesystem::file_size(entry, error) != expectedSize || error) {
+    return nullptr;
+  }
+
+  std::vector<Tuple> vertices;
+  std::vector<Tuple> normals;
+  std::vector<std::uint32_t> indices;
+  std::vector<std::uint32_t> normalIndices;
+  std::vector<BVH::Node> nodes;
+  std::vector<std::uint32_t> slots;
+  const auto triangleCount = header.indexCount / 3;
+  const auto origin = Point(0, 0, 0);
+  if (!ReadArray(file, vertices, header.vertexCount, origin) ||
+      !ReadArray(file, normals, header.normalCount, origin) ||
+      !ReadArray(file, indices, header.indexCount) ||
+      !ReadArray(file, normalIndices, header.normalIndexCount) ||
+      !ReadArray(file, nodes, header.nodeCount) ||
+      !ReadArray(file, slots, triangleCount)) {
+    return nullptr;
+  }
+
+  if (header.indexCount % 3 != 0 ||
+      (!normalIndices.empty() && normalIndices.size() != indices.size()) ||
+      nodes.empty() != slots.empty() || !AllBelow(indices, vertices.size()) ||
+      !AllBelow(normalIndices, normals.size()) ||
+      !AllBelow(slots, triangleCount) || !IsTraversable(nodes, slots.size())) {
+    return nullptr;
+  }
+
+  BVH::BuildStats stats{};
+  stats.milliseconds = header.milliseconds;
+  stats.nodeCount = nodes.size();
+  stats.leafCount = header.leafCount;
+  stats.depth = header.depth;
+  stats.sahCost = header.sahCost;
+  BVH bvh;
+  bvh.Assign(std::move(nodes), std::move(slots), stats);
+
+  return std::make_shared<TriangleMesh>(std::move(vertices),
+                                        std::move(indices),
+                                        std::move(normals),
+                                        std::move(normalIndices),
+                                        settings,
+                                        std::move(bvh));
+}
+
+bool MeshCache::Write(const std::filesystem::path& entry,
+                      std::uint64_t key,
+                      const TriangleMesh& mesh) const
+{
+  std::error_code error;
+  std::filesystem::create_directories(m_Directory, error);
+  if (error) {
+    return false;
+  }
+
+  const auto& bvh = mesh.GetBVH();
+  const auto& stats = bvh.GetBuildStats();
+  EntryHeader header{};
+  std::memcpy(header.magic, Magic, sizeof(Magic));
+  header.version = FormatVersion;
+  header.depth = stats.depth;
+  header.key = key;
+  header.vertexCount = mesh.GetVertices().size();
+  header.normalCount = mesh.GetNormals().size();
+  header.indexCount = mesh.GetIndices().size();
+  header.normalIndexCount = mesh.GetNormalIndices().size();
+  header.nodeCount = bvh.GetNodes().size();
+  header.leafCount = stats.leafCount;
+  header.milliseconds = stats.milliseconds;
+  header.sahCost = stats.sahCost;
+
+  // write beside the entry and rename, so that processes sharing the cache
+  // never read a half-written entry
+  auto temporary = entry;
+  temporary += "." + std::to_string(std::random_device{}()) + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteArray(file, mesh.GetVertices());
+    WriteArray(file, mesh.GetNormals());
+    WriteArray(file, mesh.GetIndices());
+    WriteArray(file, mesh.GetNormalIndices());
+    WriteArray(file, bvh.GetNodes());
+    WriteArray(file, bvh.GetPrimitiveIndices());
+    if (!file.flush()) {
+      file.close();
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+  std::filesystem::rename(temporary, entry, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+} // namespace Parsers
+} // namespace Rendering
+} // namespace RayTracer
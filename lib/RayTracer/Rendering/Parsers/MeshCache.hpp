@@ -0,0 +1,72 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+
+// Forward declaration
+namespace Primitives {
+class TriangleMesh;
+}
+
+namespace Parsers {
+using namespace RayTracer::Rendering::Primitives;
+
+/**
+ * @brief Directory of OBJ meshes already parsed and built, one file each
+ * @details An entry holds a TriangleMesh's buffers and its binary hierarchy,
+ * written as raw arrays behind a fixed header, so a load is a handful of bulk
+ * reads. Entries are named after a hash of the OBJ file's bytes and the build
+ * settings that shape the hierarchy; editing the file or changing those
+ * settings simply misses. The format is the writing machine's native one and
+ * is only meant to be read back there.
+ */
+class MeshCache
+{
+public:
+  /// @section Member functions
+  /// @subsection Special member functions
+  /// @param directory created on the first store if it does not exist
+  explicit MeshCache(std::filesystem::path directory);
+
+  /// @subsection Observers
+  const std::filesystem::path& GetDirectory() const;
+  std::size_t GetHitCount() const;
+  std::size_t GetMissCount() const;
+
+  /// @return the entry objFile would be stored in under settings
+  std::filesystem::path GetEntryPath(
+    const std::filesystem::path& objFile,
+    const Acceleration::BVH::BuildSettings& settings = {}) const;
+
+  /// @subsection Creation Methods
+  /**
+   * @brief Every face of objFile as one mesh, read from the cache if possible
+   * @details On a miss, or if the entry is unreadable, the file is parsed and
+   * built as OBJParser::GetMesh() would, and the entry is (re)written. A
+   * failure to write only costs the next load its hit.
+   * @throw std::runtime_error if objFile cannot be read
+   */
+  std::shared_ptr<TriangleMesh> Load(
+    const std::filesystem::path& objFile,
+    const Acceleration::BVH::BuildSettings& settings = {});
+
+private:
+  std::shared_ptr<TriangleMesh> Read(
+    const std::filesystem::path& entry,
+    std::uint64_t key,
+    const Acceleration::BVH::BuildSettings& settings) const;
+  bool Write(const std::filesystem::path& entry,
+             std::uint64_t key,
+             const TriangleMesh& mesh) const;
+
+  std::filesystem::path m_Directory;
+  std::size_t m_Hits{ 0 };
+  std::size_t m_Misses{ 0 };
+};
+
+} // namespace Parsers
+} // namespace Rendering
+} // namespace RayTracer
@@ -4,6 +4,7 @@
 #include "RayTracer/Math/Tuple.hpp"
 #include "RayTracer/Rendering/Primitives/SmoothTriangle.hpp"
 #include "RayTracer/Rendering/Primitives/Triangle.hpp"
+#include "RayTracer/Rendering/Primitives/TriangleMesh.hpp"
 #include "RayTracer/Utils/OBJFile.hpp"
 
 namespace RayTracer {
@@ -74,20 +75,68 @@ const std::vector<Tuple>& OBJParser::GetNormals() const
 
 const OBJGroup& OBJParser::GetDefaultGroup() const
 {
-  return m_Groups.at("root");
+  return GetGroupsMap().at("root");
 }
 
 const OBJGroup& OBJParser::GetGroupByName(const std::string& name) const
 {
   const static std::vector<std::shared_ptr<Triangle>> nil{};
-  return m_Groups.contains(name) ? m_Groups.at(name) : nil;
+  const auto& groups = GetGroupsMap();
+  return groups.contains(name) ? groups.at(name) : nil;
 }
 
 const OBJGroupMap& OBJParser::GetGroupsMap() const
 {
+  if (m_Groups.size() == m_Faces.size()) {
+    return m_Groups;
+  }
+  for (const auto& [name, faces] : m_Faces) {
+    auto& group = m_Groups[name];
+    const auto& vi = faces.vertexIndices;
+    const auto& ni = faces.normalIndices;
+    for (std::size_t i = 0; i < vi.size(); i += 3) {
+      auto p1 = m_Vertices[vi[i]];
+      auto p2 = m_Vertices[vi[i + 1]];
+      auto p3 = m_Vertices[vi[i + 2]];
+      // if parsing Triangles or Smooth Triangles
+      if (ni[i] == 0) {
+        group.push_back(std::make_shared<Triangle>(p1, p2, p3));
+      } else {
+        auto n1 = m_Normals[ni[i]];
+        auto n2 = m_Normals[ni[i + 1]];
+        auto n3 = m_Normals[ni[i + 2]];
+        group.push_back(
+          std::make_shared<SmoothTriangle>(p1, p2, p3, n1, n2, n3));
+      }
+    }
+  }
   return m_Groups;
 }
 
+/// --------------------------------------------------------------------------
+/// @subsection Creation Methods
+/// --------------------------------------------------------------------------
+
+std::shared_ptr<TriangleMesh> OBJParser::GetMesh(
+  const Acceleration::BVH::BuildSettings& settings) const
+{
+  std::vector<const OBJFaces*> groups;
+  for (const auto& [name, faces] : m_Faces) {
+    groups.push_back(&faces);
+  }
+  return MakeMesh(groups, settings);
+}
+
+std::shared_ptr<TriangleMesh> OBJParser::GetMeshByName(
+  const std::string& name,
+  const Acceleration::BVH::BuildSettings& settings) const
+{
+  if (!m_Faces.contains(name)) {
+    return nullptr;
+  }
+  return MakeMesh({ &m_Faces.at(name) }, settings);
+}
+
 ///
 /// @subsubsection Private member functions
 ///
@@ -172,21 +221,20 @@ void OBJParser::ParseFaces(const std::string& line)
     }
   }
 
+  if (vertexsIndices.size() < 3) {
+    return;
+  }
+
   // Fan Triangulation
+  auto& faces = m_Faces[m_CurrentGroup];
   for (auto i = 1U; i < vertexsIndices.size() - 1; ++i) {
-    auto p1 = m_Vertices[vertexsIndices[0]];
-    auto p2 = m_Vertices[vertexsIndices[i]];
-    auto p3 = m_Vertices[vertexsIndices[i + 1]];
-    // if parsing Triangles or Smooth Triangles
-    if (normalsIndices.empty()) {
-      auto tri = std::make_shared<Triangle>(p1, p2, p3);
-      m_Groups[m_CurrentGroup].push_back(std::move(tri));
-    } else {
-      auto n1 = m_Normals[normalsIndices[0]];
-      auto n2 = m_Normals[normalsIndices[i]];
-      auto n3 = m_Normals[normalsIndices[i + 1]];
-      auto tri = std::make_shared<SmoothTriangle>(p1, p2, p3, n1, n2, n3);
-      m_Groups[m_CurrentGroup].push_back(std::move(tri));
+    for (auto corner : { 0U, i, i + 1 }) {
+      faces.vertexIndices.push_back(
+        static_cast<std::uint32_t>(vertexsIndices[corner]));
+      faces.normalIndices.push_back(
+        normalsIndices.empty()
+          ? 0U
+          : static_cast<std::uint32_t>(normalsIndices[corner]));
     }
   }
 }
@@ -199,6 +247,35 @@ void OBJParser::ParseGroup(const std::string& line)
   m_CurrentGroup = groupView;
 }
 
+std::shared_ptr<TriangleMesh> OBJParser::MakeMesh(
+  const std::vector<const OBJFaces*>& groups,
+  const Acceleration::BVH::BuildSettings& settings) const
+{
+  std::vector<std::uint32_t> indices;
+  std::vector<std::uint32_t> normalIndices;
+  for (const auto* faces : groups) {
+    indices.insert(
+      indices.end(), faces->vertexIndices.begin(), faces->vertexIndices.end());
+    normalIndices.insert(normalIndices.end(),
+                         faces->normalIndices.begin(),
+                         faces->normalIndices.end());
+  }
+
+  // smooth shading needs a normal at every corner
+  const bool smooth = std::none_of(normalIndices.begin(),
+                                   normalIndices.end(),
+                                   [](std::uint32_t n) { return n == 0; });
+  if (!smooth) {
+    normalIndices.clear();
+  }
+  auto normals = smooth ? m_Normals : std::vector<Tuple>{};
+  return std::make_shared<TriangleMesh>(m_Vertices,
+                                        std::move(indices),
+                                        std::move(normals),
+                                        std::move(normalIndices),
+                                        settings);
+}
+
 } // namespace Parsers
 } // namespace Rendering
 } // namespace RayTracer
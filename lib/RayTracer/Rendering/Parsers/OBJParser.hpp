@@ -1,6 +1,8 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+
 #include <unordered_map>
 
 namespace RayTracer {
@@ -20,6 +22,7 @@ namespace Rendering {
 // Forward declaration
 namespace Primitives {
 class Triangle;
+class TriangleMesh;
 }
 
 namespace Parsers {
@@ -30,6 +33,13 @@ using namespace RayTracer::Rendering::Primitives;
 using OBJGroup = std::vector<std::shared_ptr<Triangle>>;
 using OBJGroupMap = std::unordered_map<std::string, OBJGroup>;
 
+/// @brief Fan-triangulated faces of one group, three indices per triangle
+struct OBJFaces
+{
+  std::vector<std::uint32_t> vertexIndices;
+  std::vector<std::uint32_t> normalIndices; // 0 where a face has no normals
+};
+
 class OBJParser
 {
 public:
@@ -41,21 +51,35 @@ public:
   int GetLinesIgnored() const;
   const std::vector<Tuple>& GetVertices() const;
   const std::vector<Tuple>& GetNormals() const;
+  /// @brief One Triangle per face, created on first use
   const OBJGroup& GetDefaultGroup() const;
   const OBJGroup& GetGroupByName(const std::string& name) const;
   const OBJGroupMap& GetGroupsMap() const;
 
+  /// @subsection Creation Methods
+  /// @brief Every face of the file as one indexed mesh
+  std::shared_ptr<TriangleMesh> GetMesh(
+    const Acceleration::BVH::BuildSettings& settings = {}) const;
+  /// @return the faces of group name as a mesh, or nullptr if there are none
+  std::shared_ptr<TriangleMesh> GetMeshByName(
+    const std::string& name,
+    const Acceleration::BVH::BuildSettings& settings = {}) const;
+
 private:
   void ParseVertex(const std::string& line);
   void ParseNormal(const std::string& line);
   void ParseFaces(const std::string& line);
   void ParseGroup(const std::string& line);
+  std::shared_ptr<TriangleMesh> MakeMesh(
+    const std::vector<const OBJFaces*>& groups,
+    const Acceleration::BVH::BuildSettings& settings) const;
 
   std::string m_CurrentGroup{ "root" };
   int m_LinesIgnored{};
   std::vector<Tuple> m_Vertices{};
   std::vector<Tuple> m_Normals{};
-  OBJGroupMap m_Groups;
+  std::unordered_map<std::string, OBJFaces> m_Faces;
+  mutable OBJGroupMap m_Groups; // built from m_Faces on first use
 };
 
 } // namespace Parsers
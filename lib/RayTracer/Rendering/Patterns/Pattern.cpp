@@ -44,7 +44,7 @@ mat4 Pattern::GetTransform() const
 
 Color Pattern::AtShape(const Shape* object, Tuple point) const
 {
-  auto object_point = inverse(object->GetTransform()) * point;
+  auto object_point = object->GetInverseTransform() * point;
   auto pattern_point = inverse(GetTransform()) * object_point;
   return At(pattern_point);
 }
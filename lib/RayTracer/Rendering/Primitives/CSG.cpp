@@ -1,8 +1,59 @@
 #include "RayTracer/Rendering/Primitives/CSG.hpp"
 
+#include "RayTracer/Rendering/Primitives/Group.hpp"
+
 namespace RayTracer::Rendering::Primitives {
 using namespace Math;
 
+namespace {
+
+/// @brief Appends the shapes hits can report, i.e. all but groups and CSGs
+void CollectLeaves(const Shape& shape, std::vector<const Shape*>& leaves)
+{
+  if (const auto* group = dynamic_cast<const Group*>(&shape)) {
+    for (const auto& child : group->GetChildren()) {
+      CollectLeaves(*child, leaves);
+    }
+    return;
+  }
+  if (const auto* csg = dynamic_cast<const CSG*>(&shape)) {
+    CollectLeaves(*csg->GetLeft(), leaves);
+    CollectLeaves(*csg->GetRight(), leaves);
+    return;
+  }
+  leaves.push_back(&shape);
+}
+
+/**
+ * @brief Appends the crossings of the sorted left and right that survive op
+ * @details Walks both in order of t, as filter_intersections() does over
+ * their merge, but knows each crossing's side from the list it came from.
+ */
+void Merge(CSGOperation op,
+           std::span<const Intersection> left,
+           std::span<const Intersection> right,
+           Intersections& result)
+{
+  bool inl{ false };
+  bool inr{ false };
+  auto l = left.begin();
+  auto r = right.begin();
+  while (l != left.end() || r != right.end()) {
+    const auto lhit = r == right.end() || (l != left.end() && l->t <= r->t);
+    const auto& intersection = lhit ? *l++ : *r++;
+    if (intersection_allowed(op, lhit, inl, inr)) {
+      result.Add(intersection);
+    }
+    if (lhit) {
+      inl = !inl;
+    } else {
+      inr = !inr;
+    }
+  }
+}
+
+} // namespace
+
 /// ===========================================================================
 /// @section Member functions
 /// ===========================================================================
@@ -33,6 +84,18 @@ const SharedShape& CSG::GetRight() const
   return m_Right;
 }
 
+bool CSG::IsLeftLeaf(const Shape& leaf) const
+{
+  const auto& layout = GetLayout();
+  const auto found = std::lower_bound(
+    layout.leafIds.begin(),
+    layout.leafIds.end(),
+    &leaf,
+    [](const auto& entry, const Shape* key) { return entry.first < key; });
+  return found != layout.leafIds.end() && found->first == &leaf &&
+         found->second < layout.leftLeafCount;
+}
+
 ///
 /// @subsubsection Virtual member functions
 ///
@@ -45,29 +108,130 @@ bool CSG::Contains(const Shape& shape) const
   return false;
 }
 
+void CSG::Bake(const mat4& worldToParent) const
+{
+  Shape::Bake(worldToParent);
+  const auto worldToObject = GetInverseTransform() * worldToParent;
+  m_Left->Bake(worldToObject);
+  m_Right->Bake(worldToObject);
+}
+
 Tuple CSG::GetLocalNormalAt(Tuple point, const Intersection*) const
 {
   return Point(0, 0, 1);
 }
 
-Intersections CSG::GetLocalIntersect(const Ray& r) const
+void CSG::GetLocalIntersect(const Ray& r, Intersections& xs) const
 {
-  auto leftXS = m_Left->Intersect(r);
-  auto rightXS = m_Right->Intersect(r);
+  const auto& layout = GetLayout();
 
-  Intersections xs(leftXS);
-  for (auto intersection : rightXS.GetIntersectionPoints()) {
-    xs.Add(std::move(intersection));
+  // the filter needs each child's crossings, and only theirs, in order
+  Intersections left{};
+  if (intersects(layout.leftBounds, r)) {
+    m_Left->Intersect(r, left);
   }
-  xs.Sort();
-  auto result = filter_intersections(*this, xs);
-  return result;
+  // without the left shape, only a union has anything left
+  if (left.Count() == 0 && m_Operation != CSGOperation::Union) {
+    return;
+  }
+
+  Intersections right{};
+  if (intersects(layout.rightBounds, r)) {
+    m_Right->Intersect(r, right);
+  }
+  // without one of the shapes, the operation keeps the other one whole,
+  // or nothing for an intersection
+  if (right.Count() == 0 || left.Count() == 0) {
+    if (m_Operation != CSGOperation::Intersection) {
+      for (const auto& i : (left.Count() == 0 ? right : left)
+                             .GetIntersectionPoints()) {
+        xs.Add(i);
+      }
+    }
+    return;
+  }
+
+  left.Sort();
+  right.Sort();
+  Merge(m_Operation,
+        left.GetIntersectionPoints(),
+        right.GetIntersectionPoints(),
+        xs);
+}
+
+bool CSG::GetLocalOccluded(const Ray& r, float tmin, float tmax) const
+{
+  // every surface of the result is a surface of a child, so a segment that
+  // crosses neither child cannot cross the result
+  if (!m_Left->Occluded(r, tmin, tmax) && !m_Right->Occluded(r, tmin, tmax)) {
+    return false;
+  }
+
+  // which crossings survive depends on every crossing before them
+  Intersections xs{};
+  GetLocalIntersect(r, xs);
+  for (const auto& i : xs.GetIntersectionPoints()) {
+    if (i.t >= tmin && i.t < tmax) {
+      return true;
+    }
+  }
+  return false;
+}
+
+BoundingBox CSG::GetLocalBounds() const
+{
+  const auto& layout = GetLayout();
+  auto box = layout.leftBounds;
+  add_box(box, layout.rightBounds);
+  return box;
+}
+
+void CSG::OnChildBoundsChanged()
+{
+  m_LayoutReady.store(false, std::memory_order_release);
+  Shape::OnChildBoundsChanged();
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+const CSG::Layout& CSG::GetLayout() const
+{
+  // built lazily, like a Group's hierarchy, as operands change in bursts
+  if (!m_LayoutReady.load(std::memory_order_acquire)) {
+    std::lock_guard lock(m_LayoutMutex);
+    if (!m_LayoutReady.load(std::memory_order_relaxed)) {
+      m_Layout.leftBounds = m_Left->Bounds();
+      m_Layout.rightBounds = m_Right->Bounds();
+
+      std::vector<const Shape*> leaves;
+      CollectLeaves(*m_Left, leaves);
+      m_Layout.leftLeafCount = static_cast<std::uint32_t>(leaves.size());
+      CollectLeaves(*m_Right, leaves);
+      m_Layout.leafIds.clear();
+      m_Layout.leafIds.reserve(leaves.size());
+      for (std::uint32_t id = 0; id < leaves.size(); ++id) {
+        m_Layout.leafIds.emplace_back(leaves[id], id);
+      }
+      std::sort(m_Layout.leafIds.begin(), m_Layout.leafIds.end());
+      m_LayoutReady.store(true, std::memory_order_release);
+    }
+  }
+  return m_Layout;
 }
 
 /// ---------------------------------------------------------------------------
 /// @subsection Modifiers
 /// ---------------------------------------------------------------------------
 
+void CSG::Unbake()
+{
+  Shape::Unbake();
+  m_Left->Unbake();
+  m_Right->Unbake();
+}
+
 /// ===========================================================================
 /// @section Non-member functions
 /// ===========================================================================
@@ -105,16 +269,23 @@ bool intersection_allowed(CSGOperation op, bool lhit, bool inl, bool inr)
 }
 
 Intersections filter_intersections(const CSG& csg, const Intersections& xs)
+{
+  // prepare a list to receive the filtered intersections
+  Intersections result{};
+  filter_intersections(csg, xs, result);
+  return result;
+}
+
+void filter_intersections(const CSG& csg,
+                          const Intersections& xs,
+                          Intersections& result)
 {
   // begin outside of both children
   bool inl{ false }; // true if the hit occurs inside the left shape
   bool inr{ false }; // true if the hit occurs inside the right shape
 
-  // prepare a list to receive the filtered intersections
-  Intersections result{};
-
   for (const auto& intersection : xs.GetIntersectionPoints()) {
-    auto lhit = csg.GetLeft()->Contains(*intersection.object);
+    auto lhit = csg.IsLeftLeaf(*intersection.object);
 
     if (intersection_allowed(csg.GetOperation(), lhit, inl, inr)) {
       result.Add(intersection);
@@ -127,8 +298,6 @@ Intersections filter_intersections(const CSG& csg, const Intersections& xs)
       inr = !inr;
     }
   }
-
-  return result;
 }
 
 } // namespace RayTracer::Rendering::Primitives
@@ -4,6 +4,9 @@
 #include "RayTracer/Rendering/Lighting/Intersection.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace RayTracer {
 namespace Rendering {
 namespace Primitives {
@@ -16,6 +19,15 @@ enum class CSGOperation
   Difference
 };
 
+/**
+ * @brief Union, intersection or difference of two shapes
+ * @details A ray is only tested against the operands whose bounds it
+ * crosses, and not at all against the right one when the left one's
+ * crossings already decide the result. Which operand a hit belongs to is
+ * known from the side that produced it, or looked up in a table of leaf IDs
+ * numbered left operand first. Both are rebuilt lazily after an operand
+ * changes.
+ */
 class CSG
   : public Shape
   , public std::enable_shared_from_this<CSG>
@@ -29,19 +41,47 @@ public:
   const CSGOperation& GetOperation() const;
   const SharedShape& GetLeft() const;
   const SharedShape& GetRight() const;
+  /// @return true if leaf, a shape hits can report, is in the left operand
+  bool IsLeftLeaf(const Shape& leaf) const;
 
   /// @subsubsection Virtual member functions
   bool Contains(const Shape& shape) const override;
+  /// @brief Bakes this shape, then both operands
+  void Bake(const mat4& worldToParent = mat4::Identity()) const override;
+
+  /// @subsection Modifiers
+  void Unbake() override;
 
 protected:
   Tuple GetLocalNormalAt(Tuple point,
                          const Intersection* i = nullptr) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  bool GetLocalOccluded(const Ray& r, float tmin, float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
+  void OnChildBoundsChanged() override;
 
 private:
+  /// @brief What evaluation needs of the operands, cached
+  struct Layout
+  {
+    BoundingBox leftBounds;
+    BoundingBox rightBounds;
+    /// (leaf, ID) pairs sorted by address; IDs number the leaves depth
+    /// first, the left operand's before the right one's
+    std::vector<std::pair<const Shape*, std::uint32_t>> leafIds;
+    /// IDs below it belong to the left operand
+    std::uint32_t leftLeafCount{ 0 };
+  };
+
+  const Layout& GetLayout() const;
+
   CSGOperation m_Operation;
-  const SharedShape& m_Left;
-  const SharedShape& m_Right;
+  SharedShape m_Left;
+  SharedShape m_Right;
+
+  mutable Layout m_Layout;
+  mutable std::atomic<bool> m_LayoutReady{ false };
+  mutable std::mutex m_LayoutMutex;
 };
 
 /// @section Non-member functions
@@ -62,6 +102,10 @@ bool intersection_allowed(CSGOperation op, bool lhit, bool inl, bool inr);
 
 
 Intersections filter_intersections(const CSG& csg, const Intersections& xs);
+/// @brief Appends the intersections of xs that survive to result
+void filter_intersections(const CSG& csg,
+                          const Intersections& xs,
+                          Intersections& result);
 
 } // namespace Primitives
 } // namespace Rendering
@@ -46,8 +46,33 @@ Tuple Cone::GetLocalNormalAt(Tuple point, const Intersection*) const
   return Vector(point.x, 0, point.z);
 }
 
-Intersections Cone::GetLocalIntersect(const Ray& r) const
+void Cone::GetLocalIntersect(const Ray& r, Intersections& xs) const
 {
+  float ts[4];
+  const auto count = Solve(r, m_Minimum, m_Maximum, m_Closed, ts);
+  for (int i = 0; i < count; ++i) {
+    xs.EmplaceBack(ts[i], this);
+  }
+}
+
+BoundingBox Cone::GetLocalBounds() const
+{
+  // the radius at any height equals the distance from the apex
+  const auto limit = std::max(std::abs(m_Minimum), std::abs(m_Maximum));
+  return { Point(-limit, m_Minimum, -limit), Point(limit, m_Maximum, limit) };
+}
+
+///
+/// @subsubsection Intersection kernels
+///
+
+int Cone::Solve(const Ray& r,
+                float minimum,
+                float maximum,
+                bool closed,
+                float ts[4])
+{
+  int count = 0;
   const auto o = r.origin;
   const auto d = r.direction;
 
@@ -55,22 +80,25 @@ Intersections Cone::GetLocalIntersect(const Ray& r) const
   const auto b = (2 * o.x * d.x) - (2 * o.y * d.y) + (2 * o.z * d.z);
   auto c = (o.x * o.x) - (o.y * o.y) + (o.z * o.z);
 
-  // ray is parallel to one of the cone's halves
+  // ray is parallel to one of the cone's halves, so it crosses the other
+  // one at most once; like any crossing, it must lie between the ends
   if (a == 0) {
-    if (b == 0) {
-      return {};
+    if (b != 0) {
+      const auto t = -c / (2 * b);
+      const auto y = r.origin.y + t * r.direction.y;
+      if (minimum < y && y < maximum) {
+        ts[count++] = t;
+      }
     }
-
-    auto t = -c / (2 * b);
-    return Intersections{ { t, this } };
+    SolveCaps(r, minimum, maximum, closed, ts, count);
+    return count;
   }
 
-  Intersections xs{};
   auto disc = (b * b) - 4 * a * c;
 
   // ray does not intersect the cylinder
   if (disc < 0) {
-    return {};
+    return count;
   }
 
   auto sqrtd = std::sqrt(disc);
@@ -82,48 +110,53 @@ Intersections Cone::GetLocalIntersect(const Ray& r) const
   }
 
   auto y0 = r.origin.y + t0 * r.direction.y;
-  if (m_Minimum < y0 && y0 < m_Maximum) {
-    xs.EmplaceBack(t0, this);
+  if (minimum < y0 && y0 < maximum) {
+    ts[count++] = t0;
   }
 
   auto y1 = r.origin.y + t1 * r.direction.y;
-  if (m_Minimum < y1 && y1 < m_Maximum) {
-    xs.EmplaceBack(t1, this);
+  if (minimum < y1 && y1 < maximum) {
+    ts[count++] = t1;
   }
 
-  IntersectCaps(r, xs);
-
-  return xs;
+  SolveCaps(r, minimum, maximum, closed, ts, count);
+  return count;
 }
 
-bool Cone::CheckCap(const Ray& r, float t) const
+bool Cone::CheckCap(const Ray& r, float t, float radius)
 {
   auto x = r.origin.x + t * r.direction.x;
   auto z = r.origin.z + t * r.direction.z;
 
-  return (x * x + z * z) <= 1;
+  return (x * x + z * z) <= radius * radius;
 }
 
-void Cone::IntersectCaps(const Ray& r, Intersections& xs) const
+void Cone::SolveCaps(const Ray& r,
+                     float minimum,
+                     float maximum,
+                     bool closed,
+                     float ts[4],
+                     int& count)
 {
   // caps only matter if the cylinder is closed, and might possibly be
   // intersected by the ray
-  if (!m_Closed || r.direction.y == 0) {
+  if (!closed || r.direction.y == 0) {
     return;
   }
 
   // check for an intersection with the lower end cap by intersecting the ray
   // with the plane at y=cyl.minimum
-  auto t = (m_Minimum - r.origin.y) / r.direction.y;
-  if (CheckCap(r, t)) {
-    xs.EmplaceBack(t, this);
+  // the radius of a cone at any height equals the distance from the apex
+  auto t = (minimum - r.origin.y) / r.direction.y;
+  if (CheckCap(r, t, std::abs(minimum))) {
+    ts[count++] = t;
   }
 
   // check for an intersection with the upper end cap by intersecting the ray
   // with the plane at y=cyl.maximum
-  t = (m_Maximum - r.origin.y) / r.direction.y;
-  if (CheckCap(r, t)) {
-    xs.EmplaceBack(t, this);
+  t = (maximum - r.origin.y) / r.direction.y;
+  if (CheckCap(r, t, std::abs(maximum))) {
+    ts[count++] = t;
   }
 }
 
@@ -134,16 +167,20 @@ void Cone::IntersectCaps(const Ray& r, Intersections& xs) const
 void Cone::SetMinimum(float newMinimum)
 {
   m_Minimum = newMinimum;
+  NotifyBoundsChanged();
 }
 
 void Cone::SetMaximum(float newMaximum)
 {
   m_Maximum = newMaximum;
+  NotifyBoundsChanged();
 }
 
 void Cone::SetClosed(bool newClosed)
 {
   m_Closed = newClosed;
+  // not a change of bounds, but owners caching the shape need to know
+  NotifyBoundsChanged();
 }
 
 /// ===========================================================================
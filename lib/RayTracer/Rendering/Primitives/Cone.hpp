@@ -23,6 +23,20 @@ public:
   void SetMaximum(float newMaximum);
   void SetClosed(bool closed);
 
+  /// @subsection Intersection kernels
+  /**
+   * @brief Every t at which a local ray crosses a cone of this extent
+   * @details Shared with Scene::CompiledScene, which keeps the parameters
+   * out of the shape.
+   * @return how many of ts were written, in the order GetLocalIntersect()
+   * reports them
+   */
+  static int Solve(const Ray& r,
+                   float minimum,
+                   float maximum,
+                   bool closed,
+                   float ts[4]);
+
 #ifndef NDEBUG
   Tuple TestLocalNormalAt(Tuple point) const;
 #endif
@@ -30,11 +44,17 @@ public:
 protected:
   Tuple GetLocalNormalAt(Tuple point,
                          const Intersection* i = nullptr) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  BoundingBox GetLocalBounds() const override;
 
 private:
-  bool CheckCap(const Ray& r, float t) const;
-  void IntersectCaps(const Ray& r, Intersections& xs) const;
+  static bool CheckCap(const Ray& r, float t, float radius);
+  static void SolveCaps(const Ray& r,
+                        float minimum,
+                        float maximum,
+                        bool closed,
+                        float ts[4],
+                        int& count);
 
   float m_Minimum{ -INFINITY };
   float m_Maximum{ INFINITY };
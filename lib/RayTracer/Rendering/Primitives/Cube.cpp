@@ -24,20 +24,60 @@ Tuple Cube::GetLocalNormalAt(Tuple point, const Intersection*) const
   return Vector(0, 0, point.z);
 }
 
-Intersections Cube::GetLocalIntersect(const Ray& r) const
+void Cube::GetLocalIntersect(const Ray& r, Intersections& xs) const
+{
+  float tmin = 0.0f;
+  float tmax = 0.0f;
+  if (!Solve(r, tmin, tmax)) {
+    return;
+  }
+
+  xs.EmplaceBack(tmin, this);
+  xs.EmplaceBack(tmax, this);
+}
+
+std::optional<Intersection> Cube::GetLocalClosest(const Ray& r,
+                                                  float tmin,
+                                                  float tmax) const
+{
+  float tnear = 0.0f;
+  float tfar = 0.0f;
+  if (!Solve(r, tnear, tfar)) {
+    return std::nullopt;
+  }
+  if (tnear >= tmin && tnear < tmax) {
+    return Intersection{ tnear, this };
+  }
+  if (tfar >= tmin && tfar < tmax) {
+    return Intersection{ tfar, this };
+  }
+  return std::nullopt;
+}
+
+BoundingBox Cube::GetLocalBounds() const
+{
+  return { Point(-1, -1, -1), Point(1, 1, 1) };
+}
+
+///
+/// @subsubsection Intersection kernels
+///
+
+bool Cube::Solve(const Ray& r, float& tnear, float& tfar)
 {
   auto [xtmin, xtmax] = check_axis(r.origin.x, r.direction.x);
   auto [ytmin, ytmax] = check_axis(r.origin.y, r.direction.y);
   auto [ztmin, ztmax] = check_axis(r.origin.z, r.direction.z);
 
-  auto tmin = std::max(xtmin, std::max(ytmin, ztmin));
-  auto tmax = std::min(xtmax, std::min(ytmax, ztmax));
-
-  if (tmin > tmax) {
-    return {};
-  }
+  tnear = std::max(xtmin, std::max(ytmin, ztmin));
+  tfar = std::min(xtmax, std::min(ytmax, ztmax));
+  return tnear <= tfar;
+}
 
-  return Intersections{ { tmin, this }, { tmax, this } };
+template<std::size_t N>
+LaneMask Cube::Solve(const RayPacket<N>& r, float (&tnear)[N], float (&tfar)[N])
+{
+  return Cpu::ActiveKernels().solveCubes(r.Lanes(), tnear, tfar) & r.active;
 }
 
 /// ===========================================================================
@@ -63,4 +103,14 @@ std::tuple<float, float> check_axis(float origin, float direction)
   return { tmin, tmax };
 }
 
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template LaneMask Cube::Solve(const RayPacket<4>&, float (&)[4], float (&)[4]);
+template LaneMask Cube::Solve(const RayPacket<8>&, float (&)[8], float (&)[8]);
+template LaneMask Cube::Solve(const RayPacket<16>&,
+                              float (&)[16],
+                              float (&)[16]);
+
 } // namespace RayTracer::Rendering::Primitives
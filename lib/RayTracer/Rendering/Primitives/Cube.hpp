@@ -1,6 +1,7 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 
 namespace RayTracer {
@@ -11,12 +12,27 @@ using namespace Math;
 
 class Cube : public Shape
 {
-protected:
+public:
   /// @section Member functions
+  /// @subsection Intersection kernels
+  /// @brief Where a local ray enters and leaves the cube, if it does
+  static bool Solve(const Ray& r, float& tnear, float& tfar);
+  /// @brief Solve() of every lane, by Cpu::ActiveKernels()
+  /// @return the active lanes of r that enter the cube
+  template<std::size_t N>
+  static LaneMask Solve(const RayPacket<N>& r,
+                        float (&tnear)[N],
+                        float (&tfar)[N]);
+
+protected:
   /// @subsection Observers
   Tuple GetLocalNormalAt(Tuple point,
                          const Intersection* i = nullptr) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
 };
 
 /// @section Non-member functions
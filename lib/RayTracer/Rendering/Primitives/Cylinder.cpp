@@ -39,16 +39,37 @@ Tuple Cylinder::GetLocalNormalAt(Tuple point, const Intersection*) const
   return Vector(point.x, 0, point.z);
 }
 
-Intersections Cylinder::GetLocalIntersect(const Ray& r) const
+void Cylinder::GetLocalIntersect(const Ray& r, Intersections& xs) const
 {
-  auto a = (r.direction.x * r.direction.x) + (r.direction.z * r.direction.z);
+  float ts[4];
+  const auto count = Solve(r, m_Minimum, m_Maximum, m_Closed, ts);
+  for (int i = 0; i < count; ++i) {
+    xs.EmplaceBack(ts[i], this);
+  }
+}
+
+BoundingBox Cylinder::GetLocalBounds() const
+{
+  return { Point(-1, m_Minimum, -1), Point(1, m_Maximum, 1) };
+}
 
-  Intersections xs{};
+///
+/// @subsubsection Intersection kernels
+///
+
+int Cylinder::Solve(const Ray& r,
+                    float minimum,
+                    float maximum,
+                    bool closed,
+                    float ts[4])
+{
+  int count = 0;
+  auto a = (r.direction.x * r.direction.x) + (r.direction.z * r.direction.z);
 
   // ray is parallel to the y axis
   if (a == 0) {
-    IntersectCaps(r, xs);
-    return xs;
+    SolveCaps(r, minimum, maximum, closed, ts, count);
+    return count;
   }
 
   auto b = (2 * r.origin.x * r.direction.x) + (2 * r.origin.z * r.direction.z);
@@ -58,7 +79,7 @@ Intersections Cylinder::GetLocalIntersect(const Ray& r) const
 
   // ray does not intersect the cylinder
   if (disc < 0) {
-    return {};
+    return count;
   }
 
   auto sqrtd = std::sqrt(disc);
@@ -70,21 +91,20 @@ Intersections Cylinder::GetLocalIntersect(const Ray& r) const
   }
 
   auto y0 = r.origin.y + t0 * r.direction.y;
-  if (m_Minimum < y0 && y0 < m_Maximum) {
-    xs.EmplaceBack(t0, this);
+  if (minimum < y0 && y0 < maximum) {
+    ts[count++] = t0;
   }
 
   auto y1 = r.origin.y + t1 * r.direction.y;
-  if (m_Minimum < y1 && y1 < m_Maximum) {
-    xs.EmplaceBack(t1, this);
+  if (minimum < y1 && y1 < maximum) {
+    ts[count++] = t1;
   }
 
-  IntersectCaps(r, xs);
-
-  return xs;
+  SolveCaps(r, minimum, maximum, closed, ts, count);
+  return count;
 }
 
-bool Cylinder::CheckCap(const Ray& r, float t) const
+bool Cylinder::CheckCap(const Ray& r, float t)
 {
   auto x = r.origin.x + t * r.direction.x;
   auto z = r.origin.z + t * r.direction.z;
@@ -92,26 +112,31 @@ bool Cylinder::CheckCap(const Ray& r, float t) const
   return (x * x + z * z) <= 1;
 }
 
-void Cylinder::IntersectCaps(const Ray& r, Intersections& xs) const
+void Cylinder::SolveCaps(const Ray& r,
+                         float minimum,
+                         float maximum,
+                         bool closed,
+                         float ts[4],
+                         int& count)
 {
   // caps only matter if the cylinder is closed, and might possibly be
   // intersected by the ray
-  if (!m_Closed || r.direction.y == 0) {
+  if (!closed || r.direction.y == 0) {
     return;
   }
 
   // check for an intersection with the lower end cap by intersecting the ray
   // with the plane at y=cyl.minimum
-  auto t = (m_Minimum - r.origin.y) / r.direction.y;
+  auto t = (minimum - r.origin.y) / r.direction.y;
   if (CheckCap(r, t)) {
-    xs.EmplaceBack(t, this);
+    ts[count++] = t;
   }
 
   // check for an intersection with the upper end cap by intersecting the ray
   // with the plane at y=cyl.maximum
-  t = (m_Maximum - r.origin.y) / r.direction.y;
+  t = (maximum - r.origin.y) / r.direction.y;
   if (CheckCap(r, t)) {
-    xs.EmplaceBack(t, this);
+    ts[count++] = t;
   }
 }
 
@@ -122,16 +147,20 @@ void Cylinder::IntersectCaps(const Ray& r, Intersections& xs) const
 void Cylinder::SetMinimum(float newMinimum)
 {
   m_Minimum = newMinimum;
+  NotifyBoundsChanged();
 }
 
 void Cylinder::SetMaximum(float newMaximum)
 {
   m_Maximum = newMaximum;
+  NotifyBoundsChanged();
 }
 
 void Cylinder::SetClosed(bool newClosed)
 {
   m_Closed = newClosed;
+  // not a change of bounds, but owners caching the shape need to know
+  NotifyBoundsChanged();
 }
 
 /// ===========================================================================
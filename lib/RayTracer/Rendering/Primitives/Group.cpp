@@ -26,6 +26,61 @@ bool Group::Contains(const Shape& shape) const
   return false;
 }
 
+void Group::Bake(const mat4& worldToParent) const
+{
+  Shape::Bake(worldToParent);
+  const auto worldToObject = GetInverseTransform() * worldToParent;
+  for (const auto& child : m_Children) {
+    child->Bake(worldToObject);
+  }
+}
+
+const std::vector<std::shared_ptr<Shape>>& Group::GetChildren() const
+{
+  return m_Children;
+}
+
+const Acceleration::BVH& Group::GetBVH() const
+{
+  // built lazily, so that adding n children costs one build instead of n
+  if (!m_BVHReady.load(std::memory_order_acquire)) {
+    std::lock_guard lock(m_BVHMutex);
+    if (!m_BVHReady.load(std::memory_order_relaxed)) {
+      std::vector<BoundingBox> childBounds;
+      childBounds.reserve(m_Children.size());
+      if (!m_TopologyChanged) {
+        // only bounds changed: refit in slot order, keeping the tree
+        for (const auto* child : m_SlotChildren) {
+          childBounds.push_back(child->Bounds());
+        }
+        m_BVH.Refit(childBounds);
+        m_TopologyChanged = m_BVH.IsDegraded(m_BuildSettings.refitCostLimit);
+        childBounds.clear();
+      }
+      if (m_TopologyChanged) {
+        for (const auto& child : m_Children) {
+          childBounds.push_back(child->Bounds());
+        }
+        m_BVH.Build(childBounds, m_BuildSettings);
+        m_SlotChildren.clear();
+        for (auto index : m_BVH.GetPrimitiveIndices()) {
+          m_SlotChildren.push_back(m_Children[index].get());
+        }
+        m_TopologyChanged = false;
+      }
+      m_BVH4.Clear();
+      m_BVH8.Clear();
+      if (m_BuildSettings.width == 4) {
+        m_BVH4.Build(m_BVH);
+      } else if (m_BuildSettings.width == 8) {
+        m_BVH8.Build(m_BVH);
+      }
+      m_BVHReady.store(true, std::memory_order_release);
+    }
+  }
+  return m_BVH;
+}
+
 ///
 /// @subsubsection Virtual member functions
 ///
@@ -35,18 +90,50 @@ Tuple Group::GetLocalNormalAt(Tuple point, const Intersection*) const
   return Point(0, 0, 1);
 }
 
-Intersections Group::GetLocalIntersect(const Ray& r) const
+void Group::GetLocalIntersect(const Ray& r, Intersections& xs) const
 {
-  Intersections xs{};
-  for (auto child : m_Children) {
-    auto childXS = child->Intersect(r);
-    auto childPoints = childXS.GetIntersectionPoints();
-    for (auto point : childPoints) {
-      xs.Add(point);
-    }
-  }
-  xs.Sort();
-  return xs;
+  const auto first = xs.Count();
+  WithHierarchy([&](const auto& bvh) {
+    bvh.Traverse(
+      r, [&](std::uint32_t slot) { m_SlotChildren[slot]->Intersect(r, xs); });
+  });
+  xs.Sort(first);
+}
+
+std::optional<Intersection> Group::GetLocalClosest(const Ray& r,
+                                                   float tmin,
+                                                   float tmax) const
+{
+  std::optional<Intersection> closest{};
+  WithHierarchy([&](const auto& bvh) {
+    bvh.TraverseClosest(r, tmin, tmax, [&](std::uint32_t slot) {
+      if (auto hit = m_SlotChildren[slot]->IntersectClosest(r, tmin, tmax)) {
+        closest = hit;
+        tmax = hit->t;
+      }
+    });
+  });
+  return closest;
+}
+
+bool Group::GetLocalOccluded(const Ray& r, float tmin, float tmax) const
+{
+  return WithHierarchy([&](const auto& bvh) {
+    return bvh.TraverseAny(r, tmin, tmax, [&](std::uint32_t slot) {
+      return m_SlotChildren[slot]->Occluded(r, tmin, tmax);
+    });
+  });
+}
+
+BoundingBox Group::GetLocalBounds() const
+{
+  return GetBVH().GetBounds();
+}
+
+void Group::OnChildBoundsChanged()
+{
+  m_BVHReady.store(false, std::memory_order_release);
+  Shape::OnChildBoundsChanged();
 }
 
 /// ---------------------------------------------------------------------------
@@ -55,8 +142,28 @@ Intersections Group::GetLocalIntersect(const Ray& r) const
 
 void Group::AddChild(std::shared_ptr<Shape> newChild)
 {
+  if (newChild->GetParent().lock().get() == this) {
+    return;
+  }
   newChild->SetParent(shared_from_this());
-  m_Children.insert(newChild);
+  m_Children.push_back(std::move(newChild));
+  m_TopologyChanged = true;
+  OnChildBoundsChanged();
+}
+
+void Group::Unbake()
+{
+  Shape::Unbake();
+  for (const auto& child : m_Children) {
+    child->Unbake();
+  }
+}
+
+void Group::SetBuildSettings(const Acceleration::BVH::BuildSettings& settings)
+{
+  m_BuildSettings = settings;
+  m_TopologyChanged = true;
+  m_BVHReady.store(false, std::memory_order_release);
 }
 
 } // namespace RayTracer::Rendering::Primitives
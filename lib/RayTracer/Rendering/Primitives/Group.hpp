@@ -1,8 +1,13 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+#include "RayTracer/Rendering/Acceleration/WideBVH.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace RayTracer {
 namespace Rendering {
 namespace Primitives {
@@ -11,7 +16,10 @@ using namespace Math;
 /**
  * @brief Base class for all composite shapes
  * @implements Composite design pattern
- *
+ * @details Children are intersected through a BVH over their bounds, built on
+ * the first intersection. Adding a child rebuilds it; a descendant's new
+ * transform only refits it, unless that degrades it past
+ * BuildSettings::refitCostLimit.
  */
 class Group
   : public Shape
@@ -22,19 +30,64 @@ public:
   /// @subsection Observers
   bool IsEmpty() const;
   bool Contains(const Shape& shape) const override;
+  /// @brief Bakes this group, then every descendant
+  void Bake(const mat4& worldToParent = mat4::Identity()) const override;
+  const std::vector<std::shared_ptr<Shape>>& GetChildren() const;
+  /// @brief The hierarchy over the children, built on first use
+  const Acceleration::BVH& GetBVH() const;
 
   /// @subsection Modifiers
   void AddChild(std::shared_ptr<Shape> newChild);
+  void Unbake() override;
+  void SetBuildSettings(const Acceleration::BVH::BuildSettings& settings);
 
 protected:
   Tuple GetLocalNormalAt(Tuple point,
                          const Intersection* i = nullptr) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  bool GetLocalOccluded(const Ray& r, float tmin, float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
+  void OnChildBoundsChanged() override;
 
 private:
-  std::unordered_set<std::shared_ptr<Shape>> m_Children;
+  /// @brief Calls traverse(hierarchy) with the one BuildSettings::width selects
+  template<typename Traversal>
+  decltype(auto) WithHierarchy(Traversal&& traverse) const;
+
+  std::vector<std::shared_ptr<Shape>> m_Children;
+
+  Acceleration::BVH::BuildSettings m_BuildSettings{};
+  mutable Acceleration::BVH m_BVH;
+  mutable Acceleration::BVH4 m_BVH4; // collapsed from m_BVH when width is 4
+  mutable Acceleration::BVH8 m_BVH8; // collapsed from m_BVH when width is 8
+  /// children in BVH slot order, so a leaf reads one contiguous run
+  mutable std::vector<const Shape*> m_SlotChildren;
+  mutable std::atomic<bool> m_BVHReady{ false };
+  mutable bool m_TopologyChanged{ true }; // since m_BVH was built
+  mutable std::mutex m_BVHMutex;
 };
 
+/// ===========================================================================
+/// @section Template member functions
+/// ===========================================================================
+
+template<typename Traversal>
+decltype(auto) Group::WithHierarchy(Traversal&& traverse) const
+{
+  const auto& bvh = GetBVH();
+  switch (m_BuildSettings.width) {
+    case 4:
+      return traverse(m_BVH4);
+    case 8:
+      return traverse(m_BVH8);
+    default:
+      return traverse(bvh);
+  }
+}
+
 /// @section Non-member functions
 
 } // namespace Primitives
@@ -0,0 +1,86 @@
+#include "RayTracer/Rendering/Primitives/Instance.hpp"
+
+#include "RayTracer/Core/Assertions.hpp"
+
+namespace RayTracer::Rendering::Primitives {
+using namespace Math;
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Special member functions
+/// ---------------------------------------------------------------------------
+
+Instance::Instance(std::shared_ptr<const Shape> geometry)
+  : m_Geometry(std::move(geometry))
+{
+  DEBUG_ASSERT(m_Geometry != nullptr);
+  DEBUG_ASSERT(m_Geometry->GetParent().expired());
+  SetMaterial(m_Geometry->GetMaterial());
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+const std::shared_ptr<const Shape>& Instance::GetGeometry() const
+{
+  return m_Geometry;
+}
+
+///
+/// @subsubsection Virtual member functions
+///
+
+void Instance::Bake(const mat4& worldToParent) const
+{
+  Shape::Bake(worldToParent);
+  // the geometry's world is this local space, whichever instance bakes it
+  m_Geometry->Bake();
+}
+
+Tuple Instance::GetLocalNormalAt(Tuple point, const Intersection* hit) const
+{
+  DEBUG_ASSERT(hit != nullptr && hit->leaf != nullptr);
+  // the geometry has no parent, so its world space is this local space
+  auto leafHit = *hit;
+  leafHit.object = hit->leaf;
+  leafHit.leaf = nullptr;
+  return hit->leaf->GetNormalAt(point, &leafHit);
+}
+
+void Instance::GetLocalIntersect(const Ray& r, Intersections& xs) const
+{
+  const auto first = xs.Count();
+  m_Geometry->Intersect(r, xs);
+  for (auto& i : xs.Data().subspan(first)) {
+    i.leaf = i.object;
+    i.object = this;
+  }
+}
+
+std::optional<Intersection> Instance::GetLocalClosest(const Ray& r,
+                                                      float tmin,
+                                                      float tmax) const
+{
+  auto hit = m_Geometry->IntersectClosest(r, tmin, tmax);
+  if (hit) {
+    hit->leaf = hit->object;
+    hit->object = this;
+  }
+  return hit;
+}
+
+bool Instance::GetLocalOccluded(const Ray& r, float tmin, float tmax) const
+{
+  return m_Geometry->Occluded(r, tmin, tmax);
+}
+
+BoundingBox Instance::GetLocalBounds() const
+{
+  return m_Geometry->Bounds();
+}
+
+} // namespace RayTracer::Rendering::Primitives
@@ -0,0 +1,55 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Primitives/Shape.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+namespace Primitives {
+using namespace Math;
+
+/**
+ * @brief A placement of shared geometry with its own transform and material
+ * @details Any number of instances may reference one geometry (a
+ * TriangleMesh, a Group, ...) and the hierarchy it built once; an instance
+ * adds only a Shape's transform and material. Hits are reported with the
+ * instance as Intersection::object, so it shades with its own material, and
+ * the geometry's shape in Intersection::leaf for the normal. The material
+ * starts as a copy of the geometry's.
+ *
+ * The geometry must not have a parent, must not change while instanced and
+ * must not itself contain instances.
+ */
+class Instance : public Shape
+{
+public:
+  /// @section Member functions
+  /// @subsection Special member functions
+  explicit Instance(std::shared_ptr<const Shape> geometry);
+
+  /// @subsection Observers
+  const std::shared_ptr<const Shape>& GetGeometry() const;
+
+  /// @subsubsection Virtual member functions
+  /// @brief Bakes this instance, and the geometry in its own space
+  void Bake(const mat4& worldToParent = mat4::Identity()) const override;
+
+protected:
+  Tuple GetLocalNormalAt(Tuple point,
+                         const Intersection* i = nullptr) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  bool GetLocalOccluded(const Ray& r, float tmin, float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
+
+private:
+  std::shared_ptr<const Shape> m_Geometry;
+};
+
+/// @section Non-member functions
+
+} // namespace Primitives
+} // namespace Rendering
+} // namespace RayTracer
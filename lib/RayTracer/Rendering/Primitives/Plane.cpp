@@ -16,12 +16,60 @@ Tuple Plane::GetLocalNormalAt(Tuple point, const Intersection*) const
   return Vector(0, 1, 0); // m_Transform * Vector(0, 1, 0);
 }
 
-Intersections Plane::GetLocalIntersect(const Ray& r) const
+void Plane::GetLocalIntersect(const Ray& r, Intersections& xs) const
+{
+  float t = 0.0f;
+  if (Solve(r, t)) {
+    xs.EmplaceBack(t, this);
+  }
+}
+
+std::optional<Intersection> Plane::GetLocalClosest(const Ray& r,
+                                                   float tmin,
+                                                   float tmax) const
+{
+  float t = 0.0f;
+  if (Solve(r, t) && t >= tmin && t < tmax) {
+    return Intersection{ t, this };
+  }
+  return std::nullopt;
+}
+
+BoundingBox Plane::GetLocalBounds() const
+{
+  return { Point(-INFINITY, 0, -INFINITY), Point(INFINITY, 0, INFINITY) };
+}
+
+///
+/// @subsubsection Intersection kernels
+///
+
+bool Plane::Solve(const Ray& r, float& t)
 {
   if (std::abs(r.direction.y) < EPSILON) {
-    return {};
+    return false;
+  }
+  t = -r.origin.y / r.direction.y;
+  return true;
+}
+
+template<std::size_t N>
+LaneMask Plane::Solve(const RayPacket<N>& r, float (&t)[N])
+{
+  LaneMask hits = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    t[i] = -r.originY[i] / r.directionY[i];
+    hits |= LaneMask{ std::abs(r.directionY[i]) >= EPSILON } << i;
   }
-  return { -r.origin.y / r.direction.y, this };
+  return hits & r.active;
 }
 
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template LaneMask Plane::Solve(const RayPacket<4>&, float (&)[4]);
+template LaneMask Plane::Solve(const RayPacket<8>&, float (&)[8]);
+template LaneMask Plane::Solve(const RayPacket<16>&, float (&)[16]);
+
 } // namespace RayTracer::Rendering::Primitives
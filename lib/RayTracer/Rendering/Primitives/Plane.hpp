@@ -2,6 +2,7 @@
 #include "RayTracerPCH.hpp"
 
 #include "RayTracer/Rendering/Lighting/Intersection.hpp"
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 
 namespace RayTracer {
@@ -12,12 +13,25 @@ using namespace Math;
 
 class Plane : public Shape
 {
+public:
+  /// @section Member functions
+  /// @subsection Intersection kernels
+  /// @brief Where a local ray crosses y = 0, unless it runs parallel to it
+  static bool Solve(const Ray& r, float& t);
+  /// @return the active lanes of r that cross the plane
+  template<std::size_t N>
+  static LaneMask Solve(const RayPacket<N>& r, float (&t)[N]);
+
 protected:
   /// @section Member functions
   /// @subsection Observers
   Tuple GetLocalNormalAt(Tuple point,
                          const Intersection* i = nullptr) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
 };
 
 inline bool operator==(const Shape& lhs, const Plane& rhs)
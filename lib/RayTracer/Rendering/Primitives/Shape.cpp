@@ -19,9 +19,14 @@ using namespace Math;
 Shape::~Shape() = default;
 Shape::Shape()
   : m_Transform(mat4::Identity())
+  , m_InverseTransform(mat4::Identity())
+  , m_NormalTransform(mat4::Identity())
   , m_Material(Material())
   , m_Origin(Point(0, 0, 0))
   , m_Parent()
+  , m_WorldToObject(mat4::Identity())
+  , m_NormalToWorld(mat4::Identity())
+  , m_Baked(false)
 {}
 
 /// ---------------------------------------------------------------------------
@@ -33,7 +38,17 @@ mat4 Shape::GetTransform() const
   return m_Transform;
 }
 
-Material Shape::GetMaterial() const
+const mat4& Shape::GetInverseTransform() const
+{
+  return m_InverseTransform;
+}
+
+const mat4& Shape::GetNormalTransform() const
+{
+  return m_NormalTransform;
+}
+
+const Material& Shape::GetMaterial() const
 {
   return m_Material;
 }
@@ -50,15 +65,25 @@ std::weak_ptr<Shape> Shape::GetParent() const
 
 Tuple Shape::WorldToObject(Tuple point) const
 {
+  if (IsBaked()) {
+    return m_WorldToObject * point;
+  }
   if (!m_Parent.expired()) {
     point = m_Parent.lock()->WorldToObject(point);
   }
-  return inverse(m_Transform) * point;
+  return m_InverseTransform * point;
 }
 
 Tuple Shape::NormalToWorld(Tuple normal) const
 {
-  normal = transpose(inverse(m_Transform)) * normal;
+  if (IsBaked()) {
+    // normalizing once at the end gives the direction the walk would
+    normal = m_NormalToWorld * normal;
+    normal.w = 0;
+    return normalize(normal);
+  }
+
+  normal = m_NormalTransform * normal;
   normal.w = 0;
   normal = normalize(normal);
 
@@ -68,6 +93,16 @@ Tuple Shape::NormalToWorld(Tuple normal) const
   return normal;
 }
 
+bool Shape::IsBaked() const
+{
+  return m_Baked;
+}
+
+BoundingBox Shape::Bounds() const
+{
+  return transform(GetLocalBounds(), m_Transform);
+}
+
 Tuple Shape::GetNormalAt(Tuple worldPoint, const Intersection* i) const
 {
   auto localPoint = WorldToObject(worldPoint);
@@ -77,8 +112,30 @@ Tuple Shape::GetNormalAt(Tuple worldPoint, const Intersection* i) const
 
 Intersections Shape::Intersect(const Ray& ray) const
 {
-  auto localRay = transform(ray, inverse(m_Transform));
-  return GetLocalIntersect(localRay);
+  Intersections xs{};
+  Intersect(ray, xs);
+  return xs;
+}
+
+void Shape::Intersect(const Ray& ray, Intersections& xs) const
+{
+  auto localRay = transform(ray, m_InverseTransform);
+  GetLocalIntersect(localRay, xs);
+}
+
+std::optional<Intersection> Shape::IntersectClosest(const Ray& ray,
+                                                    float tmin,
+                                                    float tmax) const
+{
+  // t is preserved by the transform, as the direction is not renormalized
+  auto localRay = transform(ray, m_InverseTransform);
+  return GetLocalClosest(localRay, tmin, tmax);
+}
+
+bool Shape::Occluded(const Ray& ray, float tmin, float tmax) const
+{
+  auto localRay = transform(ray, m_InverseTransform);
+  return GetLocalOccluded(localRay, tmin, tmax);
 }
 
 ///
@@ -90,18 +147,52 @@ bool Shape::Contains(const Shape& shape) const
   return *this == shape;
 }
 
+void Shape::Bake(const mat4& worldToParent) const
+{
+  m_WorldToObject = m_InverseTransform * worldToParent;
+  m_NormalToWorld = transpose(m_WorldToObject);
+  m_Baked = true;
+}
+
+std::optional<Intersection> Shape::GetLocalClosest(const Ray& r,
+                                                   float tmin,
+                                                   float tmax) const
+{
+  std::optional<Intersection> closest{};
+  Intersections xs{};
+  GetLocalIntersect(r, xs);
+  for (const auto& i : xs.GetIntersectionPoints()) {
+    if (i.t >= tmin && i.t < tmax) {
+      closest = i;
+      tmax = i.t;
+    }
+  }
+  return closest;
+}
+
+bool Shape::GetLocalOccluded(const Ray& r, float tmin, float tmax) const
+{
+  return GetLocalClosest(r, tmin, tmax).has_value();
+}
+
 /// ---------------------------------------------------------------------------
 /// @subsection Modifiers
 /// ---------------------------------------------------------------------------
 
-mat4& Shape::SetTransform()
+Shape::TransformRef Shape::SetTransform()
 {
-  return m_Transform;
+  return TransformRef(*this);
 }
 
 void Shape::SetTransform(mat4 newTransform)
 {
+  // inverted first, so a singular matrix throws before anything changes
+  const auto inverseTransform = inverse(newTransform);
   m_Transform = newTransform;
+  m_InverseTransform = inverseTransform;
+  m_NormalTransform = transpose(m_InverseTransform);
+  Unbake();
+  NotifyBoundsChanged();
 }
 
 Material& Shape::SetMaterial()
@@ -127,6 +218,62 @@ void Shape::SetOrigin(Tuple newOrigin)
 void Shape::SetParent(std::shared_ptr<Shape> parent)
 {
   m_Parent = parent;
+  Unbake();
+  NotifyScenes(&SceneRevision::topology);
+}
+
+void Shape::Unbake()
+{
+  m_Baked = false;
+}
+
+void Shape::AttachTo(const std::shared_ptr<SceneRevision>& scene)
+{
+  auto& revisions = m_Scenes.revisions;
+  std::erase_if(revisions, [](const auto& r) { return r.expired(); });
+  for (const auto& revision : revisions) {
+    if (revision.lock() == scene) {
+      return;
+    }
+  }
+  revisions.push_back(scene);
+}
+
+///
+/// @subsubsection Protected member functions
+///
+
+void Shape::NotifyBoundsChanged()
+{
+  for (const auto& revision : m_Scenes.revisions) {
+    if (auto scene = revision.lock()) {
+      scene->bounds.fetch_add(1, std::memory_order_acq_rel);
+    }
+  }
+  if (auto parent = m_Parent.lock()) {
+    parent->OnChildBoundsChanged();
+  }
+}
+
+void Shape::OnChildBoundsChanged()
+{
+  NotifyBoundsChanged();
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+void Shape::NotifyScenes(std::atomic<std::uint64_t> SceneRevision::*counter)
+{
+  for (const auto& revision : m_Scenes.revisions) {
+    if (auto scene = revision.lock()) {
+      (scene.get()->*counter).fetch_add(1, std::memory_order_acq_rel);
+    }
+  }
+  if (auto parent = m_Parent.lock()) {
+    parent->NotifyScenes(counter);
+  }
 }
 
 /// ===========================================================================
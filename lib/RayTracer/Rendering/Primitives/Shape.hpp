@@ -3,9 +3,12 @@
 
 #include "RayTracer/Math/Matrix.hpp"
 #include "RayTracer/Math/Tuple.hpp"
+#include "RayTracer/Rendering/Acceleration/BoundingBox.hpp"
 #include "RayTracer/Rendering/Lighting/Intersection.hpp"
 #include "RayTracer/Rendering/Materials/Material.hpp"
 
+#include <atomic>
+
 namespace RayTracer {
 namespace Rendering {
 namespace Primitives {
@@ -13,6 +16,21 @@ namespace Primitives {
 using namespace Materials;
 using namespace Lighting;
 using namespace Math;
+using Acceleration::BoundingBox;
+
+/**
+ * @brief Change counters of one scene, bumped by the shapes it holds
+ * @details A World attaches its objects to one. A change anywhere below an
+ * object is passed up the parents, as OnChildBoundsChanged() is, and bumps
+ * the counters of the scenes holding the root, and of no other scene.
+ */
+struct SceneRevision
+{
+  /// Some shape's bounds or transform changed
+  std::atomic<std::uint64_t> bounds{ 0 };
+  /// Some shape gained a child or changed parent
+  std::atomic<std::uint64_t> topology{ 0 };
+};
 
 /**
  * @brief Base class for all shapes
@@ -21,33 +39,79 @@ using namespace Math;
 class Shape
 {
 public:
+  /// @section Member types
+  class TransformRef;
+
   /// @section Member functions
   /// @subsection Special member functions
   virtual ~Shape();
 
   /// @subsection Observers
   mat4 GetTransform() const;
-  Material GetMaterial() const;
+  const mat4& GetInverseTransform() const;
+  const mat4& GetNormalTransform() const;
+  const Material& GetMaterial() const;
   Tuple GetOrigin() const;
   std::weak_ptr<Shape> GetParent() const;
+  /// @brief One multiply when baked, else a walk up the parents
   Tuple WorldToObject(Tuple point) const;
+  /// @brief One multiply when baked, else a walk up the parents
   Tuple NormalToWorld(Tuple normal) const;
+  /// @return true if Bake() ran since the last change to the transform or
+  /// parent of this shape or of an ancestor
+  bool IsBaked() const;
+
+  /// @return the bounds of this shape in its parent's space
+  BoundingBox Bounds() const;
 
   // TODO: Should not be virtual
   virtual Tuple GetNormalAt(Tuple point, const Intersection* i = nullptr) const;
   virtual Intersections Intersect(const Ray& r) const;
+  /// @brief Appends the intersections to xs, for callers that own the storage
+  void Intersect(const Ray& r, Intersections& xs) const;
+
+  /**
+   * @brief Nearest intersection with tmin <= t < tmax, if any
+   * @details Unlike Intersect(), nothing farther than the nearest hit is
+   * gathered or sorted; use Intersect() when every crossing matters, as for
+   * refraction.
+   */
+  std::optional<Intersection> IntersectClosest(const Ray& r,
+                                               float tmin,
+                                               float tmax) const;
+
+  /// @return true if any intersection has tmin <= t < tmax
+  bool Occluded(const Ray& r, float tmin, float tmax) const;
 
   /// @subsubsection Virtual member functions
   virtual bool Contains(const Shape& shape) const;
 
+  /**
+   * @brief Folds the transforms from the world down to this shape into one
+   * world-to-object and one normal-to-world matrix
+   * @details Composites bake their children too, so calling it on each root
+   * of a scene, as World::Commit() does, makes WorldToObject() and
+   * NormalToWorld() independent of nesting depth. A later transform or
+   * parent change discards the baked matrices of the shape it is made to and
+   * of its descendants, see Unbake(), until the next Bake(); the parent walk
+   * is used meanwhile.
+   * @param worldToParent the parent's world-to-object matrix
+   */
+  virtual void Bake(const mat4& worldToParent = mat4::Identity()) const;
+
   /// @subsection Modifiers
-  mat4& SetTransform();
+  TransformRef SetTransform();
   void SetTransform(mat4 t);
   Material& SetMaterial();
   void SetMaterial(Material m);
   Tuple& SetOrigin();
   void SetOrigin(Tuple t);
   void SetParent(std::shared_ptr<Shape> parent);
+  /// @brief Drops the baked matrices of this shape and its descendants
+  virtual void Unbake();
+  /// @brief Makes changes to this shape and its descendants bump scene's
+  /// counters, for as long as scene lives
+  void AttachTo(const std::shared_ptr<SceneRevision>& scene);
 
   /// @section Friend functions
   bool operator==(const Shape& rhs) const;
@@ -56,13 +120,121 @@ protected:
   Shape();
   virtual Tuple GetLocalNormalAt(Tuple point,
                                  const Intersection* i = nullptr) const = 0;
-  virtual Intersections GetLocalIntersect(const Ray& r) const = 0;
+  /// @brief Appends the intersections of the local ray r to xs
+  virtual void GetLocalIntersect(const Ray& r, Intersections& xs) const = 0;
+  /// @brief Defaults to the nearest in-range entry of GetLocalIntersect()
+  virtual std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                                      float tmin,
+                                                      float tmax) const;
+  /// @brief Defaults to GetLocalClosest(), which is cheap for primitives
+  virtual bool GetLocalOccluded(const Ray& r, float tmin, float tmax) const;
+  virtual BoundingBox GetLocalBounds() const = 0;
+
+  /// @brief Tells the parent, if any, and the scenes holding this shape that
+  /// Bounds() has changed
+  void NotifyBoundsChanged();
+  /// @brief Called when a child's bounds have changed; forwards to the parent
+  virtual void OnChildBoundsChanged();
 
 private:
+  /// @brief The scenes holding the shape as an object, which its copies are
+  /// not in
+  struct Scenes
+  {
+    Scenes() = default;
+    Scenes(const Scenes&) {}
+    Scenes& operator=(const Scenes&) { return *this; }
+
+    std::vector<std::weak_ptr<SceneRevision>> revisions;
+  };
+
+  /// @brief Bumps counter in the scenes holding this shape or an ancestor
+  void NotifyScenes(std::atomic<std::uint64_t> SceneRevision::*counter);
+
   mat4 m_Transform;
+  mat4 m_InverseTransform; // cached inverse(m_Transform)
+  mat4 m_NormalTransform;  // cached transpose(inverse(m_Transform))
   Material m_Material;
   Tuple m_Origin;
   std::weak_ptr<Shape> m_Parent;
+  Scenes m_Scenes;
+
+  // every ancestor's transform folded in, current while m_Baked is set
+  mutable mat4 m_WorldToObject;
+  mutable mat4 m_NormalToWorld; // transpose(m_WorldToObject)
+  mutable bool m_Baked;
+};
+
+/**
+ * @brief Writable view of a shape's transform, returned by SetTransform()
+ * @details Every write, whole matrix or single element, goes through
+ * SetTransform(), so the cached inverse and inverse-transpose never lag.
+ * @throws std::runtime_error from the write that makes the transform
+ * singular, which leaves the shape as it was
+ */
+class Shape::TransformRef
+{
+public:
+  /// @brief One element of the transform
+  class Element
+  {
+  public:
+    Element(Shape& owner, std::size_t row, std::size_t col)
+      : m_Owner(owner)
+      , m_Row(row)
+      , m_Col(col)
+    {}
+    Element& operator=(float value)
+    {
+      auto m = m_Owner.m_Transform;
+      m[m_Row][m_Col] = value;
+      m_Owner.SetTransform(m);
+      return *this;
+    }
+    operator float() const { return m_Owner.m_Transform[m_Row][m_Col]; }
+
+  private:
+    Shape& m_Owner;
+    std::size_t m_Row;
+    std::size_t m_Col;
+  };
+
+  /// @brief One row of the transform
+  class Row
+  {
+  public:
+    Row(Shape& owner, std::size_t row)
+      : m_Owner(owner)
+      , m_Row(row)
+    {}
+    Element operator[](std::size_t col) { return { m_Owner, m_Row, col }; }
+
+  private:
+    Shape& m_Owner;
+    std::size_t m_Row;
+  };
+
+  explicit TransformRef(Shape& owner)
+    : m_Owner(owner)
+  {}
+  TransformRef(const TransformRef&) = delete;
+  TransformRef& operator=(const TransformRef&) = delete;
+
+  TransformRef& operator=(const mat4& m)
+  {
+    m_Owner.SetTransform(m);
+    return *this;
+  }
+  TransformRef& operator*=(const mat4& m)
+  {
+    m_Owner.SetTransform(m_Owner.m_Transform * m);
+    return *this;
+  }
+  Row operator[](std::size_t row) { return { m_Owner, row }; }
+  operator const mat4&() const { return m_Owner.m_Transform; }
+
+private:
+  Shape& m_Owner;
 };
 
 using SharedShape = std::shared_ptr<Shape>;
@@ -35,9 +35,12 @@ Tuple SmoothTriangle::GetLocalNormalAt(Tuple point,
   return (n2 * hit->u) + (n3 * hit->v) + (n1 * (1 - hit->u - hit->v));
 }
 
-Intersections SmoothTriangle::MakeIntersections(float t, float u, float v) const
+void SmoothTriangle::MakeIntersections(float t,
+                                       float u,
+                                       float v,
+                                       Intersections& xs) const
 {
-  return Intersections{ { t, this, u, v } };
+  xs.EmplaceBack(t, this, u, v);
 }
 
 /// ===========================================================================
@@ -20,7 +20,10 @@ public:
 
 protected:
   Tuple GetLocalNormalAt(Tuple point, const Intersection* i) const override;
-  Intersections MakeIntersections(float t, float u, float v) const override;
+  void MakeIntersections(float t,
+                         float u,
+                         float v,
+                         Intersections& xs) const override;
 
 public:
   Tuple n1;
@@ -34,10 +34,47 @@ Tuple Sphere::GetLocalNormalAt(Tuple localPoint, const Intersection*) const
   return (localPoint - Point(0, 0, 0));
 }
 
-Intersections Sphere::GetLocalIntersect(const Ray& r) const
+void Sphere::GetLocalIntersect(const Ray& r, Intersections& xs) const
 {
-  Intersections result{};
+  float t1 = 0.0f;
+  float t2 = 0.0f;
+  if (!Solve(r, t1, t2)) {
+    return;
+  }
+
+  xs.EmplaceBack(t1, this);
+  xs.EmplaceBack(t2, this);
+}
 
+std::optional<Intersection> Sphere::GetLocalClosest(const Ray& r,
+                                                    float tmin,
+                                                    float tmax) const
+{
+  float t1 = 0.0f;
+  float t2 = 0.0f;
+  if (!Solve(r, t1, t2)) {
+    return std::nullopt;
+  }
+  if (t1 >= tmin && t1 < tmax) {
+    return Intersection{ t1, this };
+  }
+  if (t2 >= tmin && t2 < tmax) {
+    return Intersection{ t2, this };
+  }
+  return std::nullopt;
+}
+
+BoundingBox Sphere::GetLocalBounds() const
+{
+  return { Point(-1, -1, -1), Point(1, 1, 1) };
+}
+
+///
+/// @subsubsection Intersection kernels
+///
+
+bool Sphere::Solve(const Ray& r, float& t1, float& t2)
+{
   // the vector from the sphere's center, to the ray origin
   // remember: the sphere is centered at the world origin
   auto sphere_to_ray = r.origin - Point(0, 0, 0);
@@ -48,17 +85,19 @@ Intersections Sphere::GetLocalIntersect(const Ray& r) const
 
   auto discriminant = (b * b) - (4 * a * c);
   if (discriminant < 0) {
-    return result;
+    return false;
   }
 
   auto sqrtd = std::sqrt(discriminant);
-  auto t1 = (-b - sqrtd) / (2 * a);
-  auto t2 = (-b + sqrtd) / (2 * a);
-
-  result.EmplaceBack(t1, this);
-  result.EmplaceBack(t2, this);
+  t1 = (-b - sqrtd) / (2 * a);
+  t2 = (-b + sqrtd) / (2 * a);
+  return true;
+}
 
-  return result;
+template<std::size_t N>
+LaneMask Sphere::Solve(const RayPacket<N>& r, float (&t1)[N], float (&t2)[N])
+{
+  return Cpu::ActiveKernels().solveSpheres(r.Lanes(), t1, t2) & r.active;
 }
 
 /// ===========================================================================
@@ -83,4 +122,18 @@ Sphere GlassSphere()
   return s;
 }
 
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template LaneMask Sphere::Solve(const RayPacket<4>&,
+                                float (&)[4],
+                                float (&)[4]);
+template LaneMask Sphere::Solve(const RayPacket<8>&,
+                                float (&)[8],
+                                float (&)[8]);
+template LaneMask Sphere::Solve(const RayPacket<16>&,
+                                float (&)[16],
+                                float (&)[16]);
+
 } // namespace RayTracer::Rendering::Primitives
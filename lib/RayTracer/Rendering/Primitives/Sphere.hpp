@@ -1,6 +1,7 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 
 namespace RayTracer::Rendering::Primitives {
@@ -16,6 +17,14 @@ public:
   /// @subsection Modifiers
   void SetRadius(float r);
 
+  /// @subsection Intersection kernels
+  /// @brief Roots of the ray-sphere quadratic, t1 <= t2, for a local ray
+  static bool Solve(const Ray& r, float& t1, float& t2);
+  /// @brief Solve() of every lane, by Cpu::ActiveKernels()
+  /// @return the active lanes of r whose quadratic has real roots
+  template<std::size_t N>
+  static LaneMask Solve(const RayPacket<N>& r, float (&t1)[N], float (&t2)[N]);
+
   /// @section Friend functions
   bool operator==(const Sphere& rhs) const;
   friend bool operator==(const Sphere& lhs, const Sphere& rhs);
@@ -23,7 +32,11 @@ public:
 protected:
   Tuple GetLocalNormalAt(Tuple point,
                          const Intersection* i = nullptr) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
 
 private:
   float m_Radius{ 1.0f };
@@ -28,35 +28,102 @@ Tuple Triangle::GetLocalNormalAt(Tuple point, const Intersection*) const
   return normal;
 }
 
-Intersections Triangle::GetLocalIntersect(const Ray& r) const
+void Triangle::GetLocalIntersect(const Ray& r, Intersections& xs) const
+{
+  float t = 0.0f;
+  float u = 0.0f;
+  float v = 0.0f;
+  if (!Solve(r, t, u, v)) {
+    return;
+  }
+  MakeIntersections(t, u, v, xs);
+}
+
+std::optional<Intersection> Triangle::GetLocalClosest(const Ray& r,
+                                                      float tmin,
+                                                      float tmax) const
+{
+  float t = 0.0f;
+  float u = 0.0f;
+  float v = 0.0f;
+  if (!Solve(r, t, u, v) || t < tmin || t >= tmax) {
+    return std::nullopt;
+  }
+  // u and v are only read by SmoothTriangle, and harmless elsewhere
+  return Intersection{ t, this, u, v };
+}
+
+BoundingBox Triangle::GetLocalBounds() const
+{
+  BoundingBox box{};
+  add_point(box, p1);
+  add_point(box, p2);
+  add_point(box, p3);
+  return box;
+}
+
+void Triangle::MakeIntersections(float t,
+                                 float,
+                                 float,
+                                 Intersections& xs) const
+{
+  xs.EmplaceBack(t, this);
+}
+
+bool Triangle::Solve(const Ray& r, float& t, float& u, float& v) const
+{
+  return Solve(p1, e1, e2, r, t, u, v);
+}
+
+///
+/// @subsubsection Intersection kernels
+///
+
+bool Triangle::Solve(const Tuple& p1,
+                     const Tuple& e1,
+                     const Tuple& e2,
+                     const Ray& r,
+                     float& t,
+                     float& u,
+                     float& v)
 {
   auto dir_cross_e2 = cross(r.direction, e2);
   auto det = dot(e1, dir_cross_e2);
   if (std::abs(det) < EPSILON) {
-    return {};
+    return false;
   }
 
   auto f = 1.0f / det;
 
   auto p1_to_origin = r.origin - p1;
-  auto u = f * dot(p1_to_origin, dir_cross_e2);
+  u = f * dot(p1_to_origin, dir_cross_e2);
   if (u < 0 || u > 1) {
-    return {};
+    return false;
   }
 
   auto origin_cross_e1 = cross(p1_to_origin, e1);
-  auto v = f * dot(r.direction, origin_cross_e1);
+  v = f * dot(r.direction, origin_cross_e1);
   if (v < 0 || (u + v) > 1) {
-    return {};
+    return false;
   }
 
-  auto t = f * dot(e2, origin_cross_e1);
-  return MakeIntersections(t, u, v);
+  t = f * dot(e2, origin_cross_e1);
+  return true;
 }
 
-Intersections Triangle::MakeIntersections(float t, float u, float v) const
+template<std::size_t N>
+LaneMask Triangle::Solve(const Tuple& p1,
+                         const Tuple& e1,
+                         const Tuple& e2,
+                         const RayPacket<N>& r,
+                         float (&t)[N],
+                         float (&u)[N],
+                         float (&v)[N])
 {
-  return Intersections{ { t, this } };
+  const float corner[9] = { p1.x, p1.y, p1.z, e1.x, e1.y,
+                            e1.z, e2.x, e2.y, e2.z };
+  return Cpu::ActiveKernels().solveTriangles(corner, r.Lanes(), t, u, v) &
+         r.active;
 }
 
 /// ===========================================================================
@@ -69,4 +136,30 @@ bool operator==(const Triangle& lhs, const Triangle& rhs)
          lhs.e1 == rhs.e1 && lhs.e2 == rhs.e2 && lhs.normal == rhs.normal;
 }
 
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template LaneMask Triangle::Solve(const Tuple&,
+                                  const Tuple&,
+                                  const Tuple&,
+                                  const RayPacket<4>&,
+                                  float (&)[4],
+                                  float (&)[4],
+                                  float (&)[4]);
+template LaneMask Triangle::Solve(const Tuple&,
+                                  const Tuple&,
+                                  const Tuple&,
+                                  const RayPacket<8>&,
+                                  float (&)[8],
+                                  float (&)[8],
+                                  float (&)[8]);
+template LaneMask Triangle::Solve(const Tuple&,
+                                  const Tuple&,
+                                  const Tuple&,
+                                  const RayPacket<16>&,
+                                  float (&)[16],
+                                  float (&)[16],
+                                  float (&)[16]);
+
 } // namespace RayTracer::Rendering::Primitives
@@ -1,6 +1,7 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
 
 namespace RayTracer {
@@ -15,12 +16,46 @@ public:
   /// @subsection Special member functions
   Triangle(Tuple p1, Tuple p2, Tuple p3);
 
+  /// @subsection Intersection kernels
+  /**
+   * @brief Moeller-Trumbore test against the triangle at p1 with edges e1
+   * and e2; u and v are the weights of p1 + e1 and p1 + e2
+   */
+  static bool Solve(const Tuple& p1,
+                    const Tuple& e1,
+                    const Tuple& e2,
+                    const Ray& r,
+                    float& t,
+                    float& u,
+                    float& v);
+  /// @brief Solve() of every lane, by Cpu::ActiveKernels()
+  /// @return the active lanes of r that hit the triangle
+  template<std::size_t N>
+  static LaneMask Solve(const Tuple& p1,
+                        const Tuple& e1,
+                        const Tuple& e2,
+                        const RayPacket<N>& r,
+                        float (&t)[N],
+                        float (&u)[N],
+                        float (&v)[N]);
+
 protected:
   /// @subsection Observers
   Tuple GetLocalNormalAt(Tuple point, const Intersection*) const override;
-  Intersections GetLocalIntersect(const Ray& r) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
+
+  virtual void MakeIntersections(float t,
+                                 float u,
+                                 float v,
+                                 Intersections& xs) const;
 
-  virtual Intersections MakeIntersections(float t, float u, float v) const;
+private:
+  /// @brief Moeller-Trumbore test; u and v are the weights of p2 and p3
+  bool Solve(const Ray& r, float& t, float& u, float& v) const;
 
 public:
   Tuple p1;
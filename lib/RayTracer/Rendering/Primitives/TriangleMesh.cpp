@@ -0,0 +1,242 @@
+#include "RayTracer/Rendering/Primitives/TriangleMesh.hpp"
+
+#include "RayTracer/Core/Assertions.hpp"
+#include "RayTracer/Rendering/Primitives/Triangle.hpp"
+
+namespace RayTracer::Rendering::Primitives {
+using namespace Math;
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Special member functions
+/// ---------------------------------------------------------------------------
+
+TriangleMesh::TriangleMesh(std::vector<Tuple> vertices,
+                           std::vector<std::uint32_t> indices,
+                           std::vector<Tuple> normals,
+                           std::vector<std::uint32_t> normalIndices,
+                           const Acceleration::BVH::BuildSettings& settings)
+  : m_Vertices(std::move(vertices))
+  , m_Normals(std::move(normals))
+  , m_Indices(std::move(indices))
+  , m_NormalIndices(std::move(normalIndices))
+  , m_BuildSettings(settings)
+{
+  DEBUG_ASSERT(m_Indices.size() % 3 == 0);
+  DEBUG_ASSERT(m_NormalIndices.empty() ||
+               m_NormalIndices.size() == m_Indices.size());
+  Build();
+}
+
+TriangleMesh::TriangleMesh(std::vector<Tuple> vertices,
+                           std::vector<std::uint32_t> indices,
+                           std::vector<Tuple> normals,
+                           std::vector<std::uint32_t> normalIndices,
+                           const Acceleration::BVH::BuildSettings& settings,
+                           Acceleration::BVH bvh)
+  : m_Vertices(std::move(vertices))
+  , m_Normals(std::move(normals))
+  , m_Indices(std::move(indices))
+  , m_NormalIndices(std::move(normalIndices))
+  , m_BuildSettings(settings)
+  , m_BVH(std::move(bvh))
+{
+  DEBUG_ASSERT(m_Indices.size() % 3 == 0);
+  DEBUG_ASSERT(m_NormalIndices.empty() ||
+               m_NormalIndices.size() == m_Indices.size());
+  DEBUG_ASSERT(m_BVH.GetPrimitiveIndices().size() == GetTriangleCount());
+  Collapse();
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+std::size_t TriangleMesh::GetTriangleCount() const
+{
+  return m_Indices.size() / 3;
+}
+
+bool TriangleMesh::IsSmooth() const
+{
+  return !m_NormalIndices.empty();
+}
+
+const std::vector<Tuple>& TriangleMesh::GetVertices() const
+{
+  return m_Vertices;
+}
+
+const std::vector<Tuple>& TriangleMesh::GetNormals() const
+{
+  return m_Normals;
+}
+
+const std::vector<std::uint32_t>& TriangleMesh::GetIndices() const
+{
+  return m_Indices;
+}
+
+const std::vector<std::uint32_t>& TriangleMesh::GetNormalIndices() const
+{
+  return m_NormalIndices;
+}
+
+const Acceleration::BVH& TriangleMesh::GetBVH() const
+{
+  return m_BVH;
+}
+
+const Acceleration::BVH::BuildSettings& TriangleMesh::GetBuildSettings() const
+{
+  return m_BuildSettings;
+}
+
+///
+/// @subsubsection Virtual member functions
+///
+
+Tuple TriangleMesh::GetLocalNormalAt(Tuple, const Intersection* hit) const
+{
+  DEBUG_ASSERT(hit != nullptr);
+  const auto first = 3 * hit->primitive;
+  if (IsSmooth()) {
+    const auto& n1 = m_Normals[m_NormalIndices[first]];
+    const auto& n2 = m_Normals[m_NormalIndices[first + 1]];
+    const auto& n3 = m_Normals[m_NormalIndices[first + 2]];
+    return (n2 * hit->u) + (n3 * hit->v) + (n1 * (1 - hit->u - hit->v));
+  }
+  const auto& p1 = m_Vertices[m_Indices[first]];
+  const auto e1 = m_Vertices[m_Indices[first + 1]] - p1;
+  const auto e2 = m_Vertices[m_Indices[first + 2]] - p1;
+  return normalize(cross(e2, e1));
+}
+
+void TriangleMesh::GetLocalIntersect(const Ray& r, Intersections& xs) const
+{
+  const auto first = xs.Count();
+  WithHierarchy([&](const auto& bvh) {
+    bvh.Traverse(r, [&](std::uint32_t triangle) {
+      float t = 0.0f;
+      float u = 0.0f;
+      float v = 0.0f;
+      if (Solve(triangle, r, t, u, v)) {
+        xs.Add(Intersection{ t, this, u, v, triangle });
+      }
+    });
+  });
+  xs.Sort(first);
+}
+
+std::optional<Intersection> TriangleMesh::GetLocalClosest(const Ray& r,
+                                                          float tmin,
+                                                          float tmax) const
+{
+  std::optional<Intersection> closest{};
+  WithHierarchy([&](const auto& bvh) {
+    bvh.TraverseClosest(r, tmin, tmax, [&](std::uint32_t triangle) {
+      float t = 0.0f;
+      float u = 0.0f;
+      float v = 0.0f;
+      if (Solve(triangle, r, t, u, v) && t >= tmin && t < tmax) {
+        closest = Intersection{ t, this, u, v, triangle };
+        tmax = t;
+      }
+    });
+  });
+  return closest;
+}
+
+bool TriangleMesh::GetLocalOccluded(const Ray& r, float tmin, float tmax) const
+{
+  return WithHierarchy([&](const auto& bvh) {
+    return bvh.TraverseAny(r, tmin, tmax, [&](std::uint32_t triangle) {
+      float t = 0.0f;
+      float u = 0.0f;
+      float v = 0.0f;
+      return Solve(triangle, r, t, u, v) && t >= tmin && t < tmax;
+    });
+  });
+}
+
+BoundingBox TriangleMesh::GetLocalBounds() const
+{
+  return m_BVH.GetBounds();
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+void TriangleMesh::SetBuildSettings(
+  const Acceleration::BVH::BuildSettings& settings)
+{
+  m_BuildSettings = settings;
+  Build();
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+void TriangleMesh::Build()
+{
+  std::vector<BoundingBox> triangleBounds;
+  triangleBounds.reserve(GetTriangleCount());
+  for (std::size_t first = 0; first < m_Indices.size(); first += 3) {
+    BoundingBox box{};
+    add_point(box, m_Vertices[m_Indices[first]]);
+    add_point(box, m_Vertices[m_Indices[first + 1]]);
+    add_point(box, m_Vertices[m_Indices[first + 2]]);
+    triangleBounds.push_back(box);
+  }
+  m_BVH.Build(triangleBounds, m_BuildSettings);
+
+  // store the triangles in slot order, so the slot is the triangle index
+  const auto reorder = [&](std::vector<std::uint32_t>& buildOrder) {
+    if (buildOrder.empty()) {
+      return;
+    }
+    std::vector<std::uint32_t> slotOrder(buildOrder.size());
+    const auto& slots = m_BVH.GetPrimitiveIndices();
+    for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        slotOrder[3 * slot + k] = buildOrder[3 * slots[slot] + k];
+      }
+    }
+    buildOrder = std::move(slotOrder);
+  };
+  reorder(m_Indices);
+  reorder(m_NormalIndices);
+  Collapse();
+}
+
+void TriangleMesh::Collapse()
+{
+  m_BVH4.Clear();
+  m_BVH8.Clear();
+  if (m_BuildSettings.width == 4) {
+    m_BVH4.Build(m_BVH);
+  } else if (m_BuildSettings.width == 8) {
+    m_BVH8.Build(m_BVH);
+  }
+  NotifyBoundsChanged();
+}
+
+bool TriangleMesh::Solve(std::uint32_t i,
+                         const Ray& r,
+                         float& t,
+                         float& u,
+                         float& v) const
+{
+  const auto first = 3 * i;
+  const auto& p1 = m_Vertices[m_Indices[first]];
+  const auto e1 = m_Vertices[m_Indices[first + 1]] - p1;
+  const auto e2 = m_Vertices[m_Indices[first + 2]] - p1;
+  return Triangle::Solve(p1, e1, e2, r, t, u, v);
+}
+
+} // namespace RayTracer::Rendering::Primitives
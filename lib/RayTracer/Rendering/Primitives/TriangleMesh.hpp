@@ -0,0 +1,123 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+#include "RayTracer/Rendering/Acceleration/WideBVH.hpp"
+#include "RayTracer/Rendering/Primitives/Shape.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+namespace Primitives {
+using namespace Math;
+
+/**
+ * @brief Triangles sharing one vertex buffer, transform and material
+ * @details Each triangle is three 32-bit indices into the vertex buffer (and,
+ * for smooth shading, three into the normal buffer), so a large model costs
+ * a few bytes per face instead of one Shape per face. The triangles are kept
+ * in the order of their hierarchy's slots: slot i is triangle i, and a leaf
+ * reads consecutive indices. Intersections report the triangle they hit in
+ * Intersection::primitive.
+ */
+class TriangleMesh : public Shape
+{
+public:
+  /// @section Member functions
+  /// @subsection Special member functions
+  /**
+   * @param indices three vertex indices per triangle
+   * @param normalIndices three normal indices per triangle, or empty for
+   * flat shading
+   */
+  TriangleMesh(std::vector<Tuple> vertices,
+               std::vector<std::uint32_t> indices,
+               std::vector<Tuple> normals = {},
+               std::vector<std::uint32_t> normalIndices = {},
+               const Acceleration::BVH::BuildSettings& settings = {});
+
+  /**
+   * @brief Adopts a hierarchy already built over these triangles
+   * @param indices and normalIndices in bvh's slot order, as GetIndices()
+   * and GetNormalIndices() return them
+   */
+  TriangleMesh(std::vector<Tuple> vertices,
+               std::vector<std::uint32_t> indices,
+               std::vector<Tuple> normals,
+               std::vector<std::uint32_t> normalIndices,
+               const Acceleration::BVH::BuildSettings& settings,
+               Acceleration::BVH bvh);
+
+  /// @subsection Observers
+  std::size_t GetTriangleCount() const;
+  bool IsSmooth() const;
+  const std::vector<Tuple>& GetVertices() const;
+  const std::vector<Tuple>& GetNormals() const;
+  /// @brief Three vertex indices per triangle, in slot order
+  const std::vector<std::uint32_t>& GetIndices() const;
+  const std::vector<std::uint32_t>& GetNormalIndices() const;
+  const Acceleration::BVH& GetBVH() const;
+  const Acceleration::BVH::BuildSettings& GetBuildSettings() const;
+
+  /// @subsection Modifiers
+  /// @brief Rebuilds the hierarchy, which may reorder the triangles
+  void SetBuildSettings(const Acceleration::BVH::BuildSettings& settings);
+
+protected:
+  Tuple GetLocalNormalAt(Tuple point,
+                         const Intersection* i = nullptr) const override;
+  void GetLocalIntersect(const Ray& r, Intersections& xs) const override;
+  std::optional<Intersection> GetLocalClosest(const Ray& r,
+                                              float tmin,
+                                              float tmax) const override;
+  bool GetLocalOccluded(const Ray& r, float tmin, float tmax) const override;
+  BoundingBox GetLocalBounds() const override;
+
+private:
+  void Build();
+  /// @brief Derives the wide hierarchy the settings select from m_BVH
+  void Collapse();
+
+  /// @brief Triangle::Solve() against triangle i
+  bool Solve(std::uint32_t i,
+             const Ray& r,
+             float& t,
+             float& u,
+             float& v) const;
+
+  /// @brief Calls traverse(hierarchy) with the one BuildSettings::width selects
+  template<typename Traversal>
+  decltype(auto) WithHierarchy(Traversal&& traverse) const;
+
+  std::vector<Tuple> m_Vertices;
+  std::vector<Tuple> m_Normals;
+  std::vector<std::uint32_t> m_Indices;
+  std::vector<std::uint32_t> m_NormalIndices;
+
+  Acceleration::BVH::BuildSettings m_BuildSettings;
+  Acceleration::BVH m_BVH;
+  Acceleration::BVH4 m_BVH4; // collapsed from m_BVH when width is 4
+  Acceleration::BVH8 m_BVH8; // collapsed from m_BVH when width is 8
+};
+
+/// ===========================================================================
+/// @section Template member functions
+/// ===========================================================================
+
+template<typename Traversal>
+decltype(auto) TriangleMesh::WithHierarchy(Traversal&& traverse) const
+{
+  switch (m_BuildSettings.width) {
+    case 4:
+      return traverse(m_BVH4);
+    case 8:
+      return traverse(m_BVH8);
+    default:
+      return traverse(m_BVH);
+  }
+}
+
+/// @section Non-member functions
+
+} // namespace Primitives
+} // namespace Rendering
+} // namespace RayTracer
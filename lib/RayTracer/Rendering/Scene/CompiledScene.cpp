@@ -0,0 +1,609 @@
+#include "RayTracer/Rendering/Scene/CompiledScene.hpp"
+
+#include "RayTracer/Core/Assertions.hpp"
+#include "RayTracer/Rendering/Primitives/Cone.hpp"
+#include "RayTracer/Rendering/Primitives/Cube.hpp"
+#include "RayTracer/Rendering/Primitives/Cylinder.hpp"
+#include "RayTracer/Rendering/Primitives/Group.hpp"
+#include "RayTracer/Rendering/Primitives/Plane.hpp"
+#include "RayTracer/Rendering/Primitives/Sphere.hpp"
+#include "RayTracer/Rendering/Primitives/Triangle.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+namespace Scene {
+using namespace Math;
+using namespace Acceleration;
+
+struct CompiledScene::Placement
+{
+  PrimitiveType type;
+  const Shape* shape;
+  mat4 worldToParent;
+  mat4 worldToObject;
+  BoundingBox bounds; // in world space
+};
+
+namespace {
+
+/// @return the first of ts[0, count) in [tmin, tmax), or tmax if none is
+float NearestIn(const float* ts, int count, float tmin, float tmax)
+{
+  auto nearest = tmax;
+  for (int i = 0; i < count; ++i) {
+    if (ts[i] >= tmin && ts[i] < nearest) {
+      nearest = ts[i];
+    }
+  }
+  return nearest;
+}
+
+} // namespace
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+bool CompiledScene::IsEmpty() const
+{
+  return m_Slots.empty() && m_Planes.shapes.empty() &&
+         m_Unbounded.shapes.empty();
+}
+
+bool CompiledScene::IsCurrent() const
+{
+  return m_Revision &&
+         m_BoundsRevision ==
+           m_Revision->bounds.load(std::memory_order_acquire) &&
+         m_TopologyRevision ==
+           m_Revision->topology.load(std::memory_order_acquire);
+}
+
+std::size_t CompiledScene::GetCount(PrimitiveType type) const
+{
+  switch (type) {
+    case PrimitiveType::Sphere:
+      return m_Spheres.shapes.size();
+    case PrimitiveType::Cube:
+      return m_Cubes.shapes.size();
+    case PrimitiveType::Cylinder:
+      return m_Cylinders.shapes.size();
+    case PrimitiveType::Cone:
+      return m_Cones.shapes.size();
+    case PrimitiveType::Triangle:
+      return m_Triangles.shapes.size();
+    case PrimitiveType::Plane:
+      return m_Planes.shapes.size();
+    default:
+      return m_Shapes.shapes.size();
+  }
+}
+
+std::size_t CompiledScene::GetBuildCount() const
+{
+  return m_BuildCount;
+}
+
+std::size_t CompiledScene::GetRefitCount() const
+{
+  return m_RefitCount;
+}
+
+std::size_t CompiledScene::GetUnboundedCount() const
+{
+  return m_Planes.shapes.size() + m_Unbounded.shapes.size();
+}
+
+const BVH& CompiledScene::GetBVH() const
+{
+  return m_BVH;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+void CompiledScene::Compile(const std::vector<std::shared_ptr<Shape>>& objects,
+                            std::shared_ptr<const SceneRevision> revision,
+                            const BVH::BuildSettings& settings)
+{
+  Clear();
+  // read first, so that a change made while compiling leaves it stale
+  const auto boundsRevision = revision->bounds.load(std::memory_order_acquire);
+  const auto topologyRevision =
+    revision->topology.load(std::memory_order_acquire);
+
+  const auto bounded = FileUnbounded(Place(objects));
+  std::vector<BoundingBox> bounds;
+  bounds.reserve(bounded.size());
+  for (const auto& placement : bounded) {
+    bounds.push_back(placement.bounds);
+  }
+  m_BVH.Build(bounds, settings);
+  StoreBounded(bounded);
+
+  m_Revision = std::move(revision);
+  m_BoundsRevision = boundsRevision;
+  m_TopologyRevision = topologyRevision;
+  ++m_BuildCount;
+}
+
+bool CompiledScene::Refit(const std::vector<std::shared_ptr<Shape>>& objects,
+                          float costLimit)
+{
+  if (!m_Revision || m_TopologyRevision != m_Revision->topology.load(
+                                              std::memory_order_acquire)) {
+    return false;
+  }
+  const auto boundsRevision =
+    m_Revision->bounds.load(std::memory_order_acquire);
+
+  // the same hierarchy yields the same leaves in the same order, so with
+  // the same unbounded ones the n-th bounded leaf is still BVH primitive n,
+  // and refilling the buffers in slot order gives the same references
+  const auto unbounded = m_Unbounded.shapes;
+  ClearBuffers();
+  const auto bounded = FileUnbounded(Place(objects));
+  if (m_Unbounded.shapes != unbounded || bounded.size() != m_Slots.size()) {
+    return false;
+  }
+  StoreBounded(bounded);
+
+  const auto& order = m_BVH.GetPrimitiveIndices();
+  std::vector<BoundingBox> slotBounds;
+  slotBounds.reserve(order.size());
+  for (auto primitive : order) {
+    slotBounds.push_back(bounded[primitive].bounds);
+  }
+  m_BVH.Refit(slotBounds);
+  if (m_BVH.IsDegraded(costLimit)) {
+    return false;
+  }
+
+  m_BoundsRevision = boundsRevision;
+  ++m_RefitCount;
+  return true;
+}
+
+void CompiledScene::Clear()
+{
+  ClearBuffers();
+  m_BVH.Clear();
+  m_Slots.clear();
+  m_Revision.reset();
+  m_BoundsRevision = Stale;
+  m_TopologyRevision = Stale;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Ray queries
+/// ---------------------------------------------------------------------------
+
+std::optional<Intersection> CompiledScene::IntersectClosest(const Ray& r,
+                                                            float tmin,
+                                                            float tmax) const
+{
+  std::optional<Intersection> closest{};
+  m_BVH.TraverseClosest(r, tmin, tmax, [&](std::uint32_t slot) {
+    if (auto hit = IntersectSlot(slot, r, tmin, tmax)) {
+      closest = hit;
+      tmax = hit->t;
+    }
+  });
+  for (std::uint32_t i = 0; i < m_Planes.shapes.size(); ++i) {
+    float t = 0.0f;
+    if (Plane::Solve(transform(r, m_Planes.worldToObject[i]), t) &&
+        t >= tmin && t < tmax) {
+      closest = Intersection{ t, m_Planes.shapes[i] };
+      tmax = t;
+    }
+  }
+  for (std::uint32_t i = 0; i < m_Unbounded.shapes.size(); ++i) {
+    if (auto hit = IntersectShape(m_Unbounded, i, r, tmin, tmax)) {
+      closest = hit;
+      tmax = hit->t;
+    }
+  }
+  return closest;
+}
+
+bool CompiledScene::Occluded(const Ray& r, float tmin, float tmax) const
+{
+  const auto any = m_BVH.TraverseAny(r, tmin, tmax, [&](std::uint32_t slot) {
+    return IntersectSlot(slot, r, tmin, tmax).has_value();
+  });
+  if (any) {
+    return true;
+  }
+  for (const auto& worldToObject : m_Planes.worldToObject) {
+    float t = 0.0f;
+    if (Plane::Solve(transform(r, worldToObject), t) && t >= tmin &&
+        t < tmax) {
+      return true;
+    }
+  }
+  for (std::uint32_t i = 0; i < m_Unbounded.shapes.size(); ++i) {
+    if (m_Unbounded.shapes[i]->Occluded(
+          transform(r, m_Unbounded.worldToParent[i]), tmin, tmax)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<std::size_t N>
+void CompiledScene::IntersectClosest(const RayPacket<N>& packet,
+                                     float tmin,
+                                     PacketHits<N>& hits) const
+{
+  hits.fill(std::nullopt);
+  float tmax[N];
+  std::fill(std::begin(tmax), std::end(tmax), INFINITY);
+
+  m_BVH.TraverseClosest(
+    packet, tmin, tmax, [&](std::uint32_t slot, LaneMask lanes) {
+      IntersectSlot(slot, packet, lanes, tmin, tmax, hits);
+    });
+
+  for (std::uint32_t i = 0; i < m_Planes.shapes.size(); ++i) {
+    float ts[N];
+    const auto crossed =
+      Plane::Solve(transform(packet, m_Planes.worldToObject[i]), ts);
+    for_each_lane(crossed, [&](std::size_t lane) {
+      if (ts[lane] >= tmin && ts[lane] < tmax[lane]) {
+        hits[lane] = Intersection{ ts[lane], m_Planes.shapes[i] };
+        tmax[lane] = ts[lane];
+      }
+    });
+  }
+  for (std::uint32_t i = 0; i < m_Unbounded.shapes.size(); ++i) {
+    for_each_lane(packet.active, [&](std::size_t lane) {
+      const auto r = packet.Get(lane);
+      if (auto hit = IntersectShape(m_Unbounded, i, r, tmin, tmax[lane])) {
+        hits[lane] = hit;
+        tmax[lane] = hit->t;
+      }
+    });
+  }
+}
+
+///
+/// @subsubsection Private member functions
+///
+
+void CompiledScene::Flatten(const Shape& shape,
+                            const mat4& worldToParent,
+                            const mat4& parentToWorld,
+                            std::vector<Placement>& placements)
+{
+  const auto worldToObject = shape.GetInverseTransform() * worldToParent;
+  const auto objectToWorld = parentToWorld * shape.GetTransform();
+
+  if (const auto* group = dynamic_cast<const Group*>(&shape)) {
+    for (const auto& child : group->GetChildren()) {
+      Flatten(*child, worldToObject, objectToWorld, placements);
+    }
+    return;
+  }
+
+  Placement placement{ PrimitiveType::Shape,
+                       &shape,
+                       worldToParent,
+                       worldToObject,
+                       transform(shape.Bounds(), parentToWorld) };
+  if (dynamic_cast<const Sphere*>(&shape)) {
+    placement.type = PrimitiveType::Sphere;
+  } else if (dynamic_cast<const Cube*>(&shape)) {
+    placement.type = PrimitiveType::Cube;
+  } else if (dynamic_cast<const Cylinder*>(&shape)) {
+    placement.type = PrimitiveType::Cylinder;
+  } else if (dynamic_cast<const Cone*>(&shape)) {
+    placement.type = PrimitiveType::Cone;
+  } else if (dynamic_cast<const Triangle*>(&shape)) {
+    placement.type = PrimitiveType::Triangle;
+  } else if (dynamic_cast<const Plane*>(&shape)) {
+    placement.type = PrimitiveType::Plane;
+  }
+  placements.push_back(std::move(placement));
+}
+
+std::vector<CompiledScene::Placement> CompiledScene::Place(
+  const std::vector<std::shared_ptr<Shape>>& objects)
+{
+  std::vector<Placement> placements;
+  for (const auto& object : objects) {
+    Flatten(*object, mat4::Identity(), mat4::Identity(), placements);
+  }
+  return placements;
+}
+
+std::vector<CompiledScene::Placement> CompiledScene::FileUnbounded(
+  std::vector<Placement> placements)
+{
+  std::vector<Placement> bounded;
+  for (auto& placement : placements) {
+    if (placement.type == PrimitiveType::Plane) {
+      m_Planes.worldToObject.push_back(placement.worldToObject);
+      m_Planes.shapes.push_back(placement.shape);
+    } else if (!is_bounded(placement.bounds)) {
+      m_Unbounded.worldToParent.push_back(placement.worldToParent);
+      m_Unbounded.shapes.push_back(placement.shape);
+    } else {
+      bounded.push_back(std::move(placement));
+    }
+  }
+  return bounded;
+}
+
+void CompiledScene::StoreBounded(const std::vector<Placement>& bounded)
+{
+  const auto& order = m_BVH.GetPrimitiveIndices();
+  m_Slots.clear();
+  m_Slots.reserve(order.size());
+  for (auto primitive : order) {
+    m_Slots.push_back(Store(bounded[primitive]));
+  }
+}
+
+void CompiledScene::ClearBuffers()
+{
+  m_Spheres = {};
+  m_Cubes = {};
+  m_Cylinders = {};
+  m_Cones = {};
+  m_Triangles = {};
+  m_Shapes = {};
+  m_Planes = {};
+  m_Unbounded = {};
+}
+
+CompiledScene::Reference CompiledScene::Store(const Placement& placement)
+{
+  const auto tag = static_cast<Reference>(placement.type) << TagShift;
+  const auto* shape = placement.shape;
+
+  const auto storeUnit = [&](UnitSolids& buffer) {
+    buffer.worldToObject.push_back(placement.worldToObject);
+    buffer.shapes.push_back(shape);
+    return static_cast<Reference>(buffer.shapes.size() - 1);
+  };
+  const auto storeTruncated = [&](TruncatedSolids& buffer,
+                                  float minimum,
+                                  float maximum,
+                                  bool closed) {
+    buffer.worldToObject.push_back(placement.worldToObject);
+    buffer.minimum.push_back(minimum);
+    buffer.maximum.push_back(maximum);
+    buffer.closed.push_back(closed ? 1 : 0);
+    buffer.shapes.push_back(shape);
+    return static_cast<Reference>(buffer.shapes.size() - 1);
+  };
+
+  Reference index = 0;
+  switch (placement.type) {
+    case PrimitiveType::Sphere:
+      index = storeUnit(m_Spheres);
+      break;
+    case PrimitiveType::Cube:
+      index = storeUnit(m_Cubes);
+      break;
+    case PrimitiveType::Cylinder: {
+      const auto& cylinder = static_cast<const Cylinder&>(*shape);
+      index = storeTruncated(m_Cylinders,
+                             cylinder.GetMinimum(),
+                             cylinder.GetMaximum(),
+                             cylinder.IsClosed());
+      break;
+    }
+    case PrimitiveType::Cone: {
+      const auto& cone = static_cast<const Cone&>(*shape);
+      index = storeTruncated(
+        m_Cones, cone.GetMinimum(), cone.GetMaximum(), cone.IsClosed());
+      break;
+    }
+    case PrimitiveType::Triangle: {
+      // the parallel-ray test in Solve() is absolute, so the corners stay
+      // in object space where it has the scale Triangle gives it
+      const auto& triangle = static_cast<const Triangle&>(*shape);
+      m_Triangles.worldToObject.push_back(placement.worldToObject);
+      m_Triangles.p1.push_back(triangle.p1);
+      m_Triangles.e1.push_back(triangle.e1);
+      m_Triangles.e2.push_back(triangle.e2);
+      m_Triangles.shapes.push_back(shape);
+      index = static_cast<Reference>(m_Triangles.shapes.size() - 1);
+      break;
+    }
+    default:
+      m_Shapes.worldToParent.push_back(placement.worldToParent);
+      m_Shapes.shapes.push_back(shape);
+      index = static_cast<Reference>(m_Shapes.shapes.size() - 1);
+      break;
+  }
+  DEBUG_ASSERT(index <= IndexMask);
+  return tag | index;
+}
+
+std::optional<Intersection> CompiledScene::IntersectSlot(std::uint32_t slot,
+                                                         const Ray& r,
+                                                         float tmin,
+                                                         float tmax) const
+{
+  const auto reference = m_Slots[slot];
+  const auto index = reference & IndexMask;
+
+  switch (static_cast<PrimitiveType>(reference >> TagShift)) {
+    case PrimitiveType::Sphere: {
+      const auto local = transform(r, m_Spheres.worldToObject[index]);
+      float ts[2];
+      if (Sphere::Solve(local, ts[0], ts[1])) {
+        const auto t = NearestIn(ts, 2, tmin, tmax);
+        if (t < tmax) {
+          return Intersection{ t, m_Spheres.shapes[index] };
+        }
+      }
+      return std::nullopt;
+    }
+    case PrimitiveType::Cube: {
+      const auto local = transform(r, m_Cubes.worldToObject[index]);
+      float ts[2];
+      if (Cube::Solve(local, ts[0], ts[1])) {
+        const auto t = NearestIn(ts, 2, tmin, tmax);
+        if (t < tmax) {
+          return Intersection{ t, m_Cubes.shapes[index] };
+        }
+      }
+      return std::nullopt;
+    }
+    case PrimitiveType::Cylinder: {
+      const auto local = transform(r, m_Cylinders.worldToObject[index]);
+      float ts[4];
+      const auto count = Cylinder::Solve(local,
+                                         m_Cylinders.minimum[index],
+                                         m_Cylinders.maximum[index],
+                                         m_Cylinders.closed[index] != 0,
+                                         ts);
+      const auto t = NearestIn(ts, count, tmin, tmax);
+      if (t < tmax) {
+        return Intersection{ t, m_Cylinders.shapes[index] };
+      }
+      return std::nullopt;
+    }
+    case PrimitiveType::Cone: {
+      const auto local = transform(r, m_Cones.worldToObject[index]);
+      float ts[4];
+      const auto count = Cone::Solve(local,
+                                     m_Cones.minimum[index],
+                                     m_Cones.maximum[index],
+                                     m_Cones.closed[index] != 0,
+                                     ts);
+      const auto t = NearestIn(ts, count, tmin, tmax);
+      if (t < tmax) {
+        return Intersection{ t, m_Cones.shapes[index] };
+      }
+      return std::nullopt;
+    }
+    case PrimitiveType::Triangle: {
+      const auto local = transform(r, m_Triangles.worldToObject[index]);
+      float t = 0.0f;
+      float u = 0.0f;
+      float v = 0.0f;
+      if (Triangle::Solve(m_Triangles.p1[index],
+                          m_Triangles.e1[index],
+                          m_Triangles.e2[index],
+                          local,
+                          t,
+                          u,
+                          v) &&
+          t >= tmin && t < tmax) {
+        return Intersection{ t, m_Triangles.shapes[index], u, v };
+      }
+      return std::nullopt;
+    }
+    default:
+      return IntersectShape(m_Shapes, index, r, tmin, tmax);
+  }
+}
+
+template<std::size_t N>
+void CompiledScene::IntersectSlot(std::uint32_t slot,
+                                  const RayPacket<N>& packet,
+                                  LaneMask lanes,
+                                  float tmin,
+                                  float (&tmax)[N],
+                                  PacketHits<N>& hits) const
+{
+  const auto reference = m_Slots[slot];
+  const auto index = reference & IndexMask;
+  const auto keep = [&](std::size_t lane, const Intersection& hit) {
+    hits[lane] = hit;
+    tmax[lane] = hit.t;
+  };
+
+  switch (static_cast<PrimitiveType>(reference >> TagShift)) {
+    case PrimitiveType::Sphere:
+    case PrimitiveType::Cube: {
+      const auto isSphere =
+        static_cast<PrimitiveType>(reference >> TagShift) ==
+        PrimitiveType::Sphere;
+      const auto& buffer = isSphere ? m_Spheres : m_Cubes;
+      const auto local = transform(packet, buffer.worldToObject[index]);
+      float t1[N];
+      float t2[N];
+      const auto solved =
+        (isSphere ? Sphere::Solve(local, t1, t2) : Cube::Solve(local, t1, t2)) &
+        lanes;
+      for_each_lane(solved, [&](std::size_t lane) {
+        const float ts[2] = { t1[lane], t2[lane] };
+        const auto t = NearestIn(ts, 2, tmin, tmax[lane]);
+        if (t < tmax[lane]) {
+          keep(lane, Intersection{ t, buffer.shapes[index] });
+        }
+      });
+      return;
+    }
+    case PrimitiveType::Triangle: {
+      const auto local = transform(packet, m_Triangles.worldToObject[index]);
+      float t[N];
+      float u[N];
+      float v[N];
+      const auto solved = Triangle::Solve(m_Triangles.p1[index],
+                                          m_Triangles.e1[index],
+                                          m_Triangles.e2[index],
+                                          local,
+                                          t,
+                                          u,
+                                          v) &
+                          lanes;
+      for_each_lane(solved, [&](std::size_t lane) {
+        if (t[lane] >= tmin && t[lane] < tmax[lane]) {
+          keep(lane,
+               Intersection{
+                 t[lane], m_Triangles.shapes[index], u[lane], v[lane] });
+        }
+      });
+      return;
+    }
+    default:
+      // cylinders, cones and shapes, one lane at a time
+      for_each_lane(lanes, [&](std::size_t lane) {
+        const auto r = packet.Get(lane);
+        if (auto hit = IntersectSlot(slot, r, tmin, tmax[lane])) {
+          keep(lane, *hit);
+        }
+      });
+      return;
+  }
+}
+
+std::optional<Intersection> CompiledScene::IntersectShape(const Shapes& buffer,
+                                                          std::uint32_t index,
+                                                          const Ray& r,
+                                                          float tmin,
+                                                          float tmax)
+{
+  // t is preserved, as transform() does not renormalize the direction
+  const auto inParent = transform(r, buffer.worldToParent[index]);
+  return buffer.shapes[index]->IntersectClosest(inParent, tmin, tmax);
+}
+
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
+
+template void CompiledScene::IntersectClosest(const RayPacket<4>&,
+                                              float,
+                                              PacketHits<4>&) const;
+template void CompiledScene::IntersectClosest(const RayPacket<8>&,
+                                              float,
+                                              PacketHits<8>&) const;
+template void CompiledScene::IntersectClosest(const RayPacket<16>&,
+                                              float,
+                                              PacketHits<16>&) const;
+
+} // namespace Scene
+} // namespace Rendering
+} // namespace RayTracer
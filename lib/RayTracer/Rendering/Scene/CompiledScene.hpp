@@ -0,0 +1,201 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Acceleration/BVH.hpp"
+#include "RayTracer/Rendering/Lighting/Intersection.hpp"
+#include "RayTracer/Rendering/Lighting/RayPacket.hpp"
+#include "RayTracer/Rendering/Primitives/Shape.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+namespace Scene {
+using namespace Math;
+using namespace Primitives;
+using namespace Lighting;
+
+/**
+ * @brief A scene's objects flattened into one buffer per primitive type
+ * @details Compile() walks the objects, descending into groups, and files
+ * each leaf by type: spheres, cubes, cylinders, cones and triangles each get
+ * a structure of arrays holding only what their intersection kernel reads.
+ * The entries are stored in the order of the slots of a BVH over all of
+ * them, so leaves near each other in the tree read entries near each other
+ * in each buffer, and each slot switches on a type tag to its primitive's
+ * kernel. Planes, which no box bounds, have a buffer of their own tested
+ * after the hierarchy. A query does no virtual call until it reaches another
+ * kind of shape: CSGs, instances, meshes and other unbounded shapes are kept
+ * as they are and tested through Shape.
+ *
+ * The store is a snapshot. Hits report the authoring shapes, which must
+ * outlive it, and any later transform, parent or bounds change to the shapes
+ * attached to the revision it was compiled against makes it stale; see
+ * IsCurrent(). Where only transforms and bounds changed, Refit() brings it
+ * up to date without rebuilding the hierarchy. Only the closest-hit and
+ * any-hit queries are served, the closest-hit one also for packets of rays;
+ * every crossing along a ray still comes from the World.
+ */
+class CompiledScene
+{
+public:
+  /// @section Member types
+  enum class PrimitiveType : std::uint8_t
+  {
+    Sphere,
+    Cube,
+    Cylinder,
+    Cone,
+    Triangle, // and smooth triangles
+    Plane,    // unbounded, so outside the hierarchy
+    Shape     // anything else, through its virtual interface
+  };
+
+  /// @section Member functions
+  /// @subsection Observers
+  bool IsEmpty() const;
+  /// @return true if compiled and no shape of the scene changed since
+  bool IsCurrent() const;
+  /// @brief Full compiles and refits done so far
+  std::size_t GetBuildCount() const;
+  std::size_t GetRefitCount() const;
+  /// @return the primitives of type inside the hierarchy
+  std::size_t GetCount(PrimitiveType type) const;
+  /// @brief Shapes without finite bounds, planes included, tested after the
+  /// hierarchy
+  std::size_t GetUnboundedCount() const;
+  const Acceleration::BVH& GetBVH() const;
+
+  /// @subsection Modifiers
+  /// @param revision the counters the objects are attached to
+  void Compile(const std::vector<std::shared_ptr<Shape>>& objects,
+               std::shared_ptr<const SceneRevision> revision,
+               const Acceleration::BVH::BuildSettings& settings = {});
+  /**
+   * @brief Rewrites the per-type buffers of the same objects, and refits the
+   * hierarchy to their bounds
+   * @return false if the scene must be compiled again instead: a shape
+   * gained a child or changed parent, a leaf became bounded or unbounded, or
+   * the refitted hierarchy is degraded past costLimit (see
+   * BVH::IsDegraded()); it is then left stale
+   */
+  bool Refit(const std::vector<std::shared_ptr<Shape>>& objects,
+             float costLimit);
+  void Clear();
+
+  /// @subsection Ray queries
+  /// @brief Nearest intersection with tmin <= t < tmax, if any
+  std::optional<Intersection> IntersectClosest(const Ray& r,
+                                               float tmin,
+                                               float tmax) const;
+  /// @return true if any intersection has tmin <= t < tmax
+  bool Occluded(const Ray& r, float tmin, float tmax) const;
+
+  /**
+   * @brief IntersectClosest() for each active lane of packet, with no tmax
+   * @details The packet goes down the hierarchy together, and the sphere,
+   * cube, triangle and plane kernels run over its lanes at once; other
+   * primitives are tested one lane at a time.
+   */
+  template<std::size_t N>
+  void IntersectClosest(const RayPacket<N>& packet,
+                        float tmin,
+                        PacketHits<N>& hits) const;
+
+private:
+  /// @brief A type tag in the top bits over an index into that type's buffer
+  using Reference = std::uint32_t;
+  static constexpr int TagShift = 29;
+  static constexpr Reference IndexMask = (Reference{ 1 } << TagShift) - 1;
+  static constexpr std::uint64_t Stale = ~std::uint64_t{ 0 };
+
+  /// @brief A leaf found by Compile(), before it is filed by type
+  struct Placement;
+
+  /// Spheres and cubes: only the transform differs
+  struct UnitSolids
+  {
+    std::vector<mat4> worldToObject;
+    std::vector<const Shape*> shapes;
+  };
+
+  /// Cylinders and cones
+  struct TruncatedSolids
+  {
+    std::vector<mat4> worldToObject;
+    std::vector<float> minimum;
+    std::vector<float> maximum;
+    std::vector<std::uint8_t> closed;
+    std::vector<const Shape*> shapes;
+  };
+
+  /// Triangles and smooth triangles, kept in object space so that
+  /// Triangle::Solve() sees the same ray as Triangle does
+  struct Triangles
+  {
+    std::vector<mat4> worldToObject;
+    std::vector<Tuple> p1;
+    std::vector<Tuple> e1;
+    std::vector<Tuple> e2;
+    std::vector<const Shape*> shapes;
+  };
+
+  /// Shapes tested as they are, nested in groups or not
+  struct Shapes
+  {
+    std::vector<mat4> worldToParent;
+    std::vector<const Shape*> shapes;
+  };
+
+  static std::vector<Placement> Place(
+    const std::vector<std::shared_ptr<Shape>>& objects);
+  static void Flatten(const Shape& shape,
+                      const mat4& worldToParent,
+                      const mat4& parentToWorld,
+                      std::vector<Placement>& placements);
+  /// @brief Files the planes and the other unbounded placements
+  /// @return the bounded ones, which the hierarchy is over
+  std::vector<Placement> FileUnbounded(std::vector<Placement> placements);
+  /// @brief Stores the bounded placements in the order of the BVH's slots
+  void StoreBounded(const std::vector<Placement>& bounded);
+  Reference Store(const Placement& placement);
+  void ClearBuffers();
+
+  /// @return the nearest hit of the slot's primitive in [tmin, tmax)
+  std::optional<Intersection> IntersectSlot(std::uint32_t slot,
+                                            const Ray& r,
+                                            float tmin,
+                                            float tmax) const;
+  /// @brief Lowers tmax[lane] of the given lanes to their hits in the slot
+  template<std::size_t N>
+  void IntersectSlot(std::uint32_t slot,
+                     const RayPacket<N>& packet,
+                     LaneMask lanes,
+                     float tmin,
+                     float (&tmax)[N],
+                     PacketHits<N>& hits) const;
+  static std::optional<Intersection> IntersectShape(const Shapes& buffer,
+                                                    std::uint32_t index,
+                                                    const Ray& r,
+                                                    float tmin,
+                                                    float tmax);
+
+  UnitSolids m_Spheres;
+  UnitSolids m_Cubes;
+  TruncatedSolids m_Cylinders;
+  TruncatedSolids m_Cones;
+  Triangles m_Triangles;
+  Shapes m_Shapes;
+  UnitSolids m_Planes;
+  Shapes m_Unbounded;
+
+  Acceleration::BVH m_BVH;
+  std::vector<Reference> m_Slots; // BVH slot -> primitive
+  std::shared_ptr<const SceneRevision> m_Revision;
+  std::uint64_t m_BoundsRevision{ Stale };
+  std::uint64_t m_TopologyRevision{ Stale };
+  std::size_t m_BuildCount{ 0 };
+  std::size_t m_RefitCount{ 0 };
+};
+
+} // namespace Scene
+} // namespace Rendering
+} // namespace RayTracer
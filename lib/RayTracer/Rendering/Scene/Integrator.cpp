@@ -0,0 +1,166 @@
+#include "RayTracer/Rendering/Scene/Integrator.hpp"
+
+#include "RayTracer/Core/Assertions.hpp"
+#include "RayTracer/Rendering/Lighting/Computations.hpp"
+#include "RayTracer/Rendering/Materials/Material.hpp"
+
+namespace RayTracer {
+namespace Rendering {
+namespace Scene {
+
+using namespace Math;
+using namespace Materials;
+
+/// ===========================================================================
+/// @section Member functions
+/// ===========================================================================
+
+/// ---------------------------------------------------------------------------
+/// @subsection Special member functions
+/// ---------------------------------------------------------------------------
+
+Integrator::Integrator()
+  : Integrator(Settings{})
+{}
+
+Integrator::Integrator(const Settings& settings, std::uint32_t stream)
+  : m_Settings(settings)
+  , m_Random(settings.seed + stream)
+{
+  m_Settings.depth = std::clamp(m_Settings.depth, 0, MaxDepth);
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Observers
+/// ---------------------------------------------------------------------------
+
+const Integrator::Settings& Integrator::GetSettings() const
+{
+  return m_Settings;
+}
+
+const Integrator::Stats& Integrator::GetStats() const
+{
+  return m_Stats;
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Modifiers
+/// ---------------------------------------------------------------------------
+
+void Integrator::ResetStats()
+{
+  m_Stats = {};
+}
+
+/// ---------------------------------------------------------------------------
+/// @subsection Operations
+/// ---------------------------------------------------------------------------
+
+Color Integrator::Trace(const World& w, const Ray& r)
+{
+  return Trace(w, r, w.IntersectClosest(r));
+}
+
+Color Integrator::Trace(const World& w,
+                        const Ray& r,
+                        const std::optional<Intersection>& firstHit)
+{
+  ++m_Stats.rays;
+
+  // shade_hit() is black without a light, reflections and all
+  const auto light = w.GetLightSource();
+  if (!firstHit || !light) {
+    return Colors::Black;
+  }
+
+  auto color = Colors::Black;
+  m_StackSize = 0;
+  m_Stack[m_StackSize++] = { r, 1.0f, m_Settings.depth };
+  m_Stats.peakStack = std::max(m_Stats.peakStack, m_StackSize);
+  auto hit = firstHit;
+  auto first = true;
+
+  while (m_StackSize > 0) {
+    const auto path = m_Stack[--m_StackSize];
+    if (!first) {
+      ++m_Stats.rays;
+      hit = w.IntersectClosest(path.ray);
+      if (!hit) {
+        continue;
+      }
+    }
+    first = false;
+    ++m_Stats.hits;
+
+    // as in color_at(), refraction needs every crossing along the ray to
+    // find n1 and n2; opaque surfaces only need the hit
+    const auto& material = hit->object->GetMaterial();
+    const auto comps = [&] {
+      if (material.transparency > 0) {
+        intersect_world(w, path.ray, m_Crossings);
+        return prepare_computations(
+          *hit, path.ray, &m_Crossings, &m_Containers);
+      }
+      return prepare_computations(*hit, path.ray);
+    }();
+
+    const auto surface = lighting(material,
+                                  *light,
+                                  comps.over_point,
+                                  comps.eyev,
+                                  comps.normalv,
+                                  is_shadowed(w, comps.over_point),
+                                  comps.object);
+    color = color + surface * path.weight;
+
+    if (path.depth < 1) {
+      continue;
+    }
+    auto reflectance = 1.0f;
+    auto transmittance = 1.0f;
+    if (material.reflective > 0 && material.transparency > 0) {
+      reflectance = schlick(comps);
+      transmittance = 1 - reflectance;
+    }
+    if (material.transparency != 0) {
+      if (const auto ray = refracted_ray(comps)) {
+        Spawn({ *ray,
+                path.weight * material.transparency * transmittance,
+                path.depth - 1 });
+      }
+    }
+    if (material.reflective != 0) {
+      Spawn({ Ray{ comps.over_point, comps.reflectv },
+              path.weight * material.reflective * reflectance,
+              path.depth - 1 });
+    }
+  }
+  return color;
+}
+
+void Integrator::Spawn(PathRay path)
+{
+  if (path.weight < m_Settings.cutoff) {
+    ++m_Stats.culled;
+    return;
+  }
+  if (m_Settings.russianRoulette && path.weight < m_Settings.rouletteWeight) {
+    const auto u = static_cast<float>(m_Random() - m_Random.min()) /
+                   static_cast<float>(m_Random.max() - m_Random.min());
+    if (u * m_Settings.rouletteWeight >= path.weight) {
+      ++m_Stats.terminated;
+      return;
+    }
+    path.weight = m_Settings.rouletteWeight;
+  }
+
+  // each bounce leaves at most one sibling behind, so depth + 1 entries do
+  DEBUG_ASSERT(m_StackSize < m_Stack.size());
+  m_Stack[m_StackSize++] = path;
+  m_Stats.peakStack = std::max(m_Stats.peakStack, m_StackSize);
+}
+
+} // namespace Scene
+} // namespace Rendering
+} // namespace RayTracer
@@ -0,0 +1,105 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+#include "RayTracer/Rendering/Color.hpp"
+#include "RayTracer/Rendering/Lighting/Intersection.hpp"
+#include "RayTracer/Rendering/Lighting/Ray.hpp"
+#include "RayTracer/Rendering/Scene/World.hpp"
+
+#include <random>
+
+namespace RayTracer {
+namespace Rendering {
+namespace Scene {
+
+/**
+ * @brief color_at() as a loop over an explicit stack of rays
+ * @details color_at(), shade_hit() and the reflected and refracted colors
+ * recurse into each other, and follow every reflection and refraction to
+ * the full depth however little it adds to the pixel. Trace() keeps the
+ * rays still to follow on a fixed-size stack instead, each with its
+ * throughput: the product of the reflectivity, transparency and Schlick
+ * terms the recursion would have scaled its color by on the way back. Each
+ * hit adds its lit surface color times that weight.
+ *
+ * A ray whose weight falls below Settings::cutoff is dropped. With
+ * Settings::russianRoulette, a ray below Settings::rouletteWeight is instead
+ * kept with probability weight / rouletteWeight and, if kept, weighted
+ * rouletteWeight, which leaves the expected color unchanged. With a cutoff
+ * of 0 and no roulette, Trace() gives color_at()'s color up to rounding.
+ *
+ * An Integrator draws its own random numbers and counts what it traced, so
+ * each thread needs one of its own.
+ */
+class Integrator
+{
+public:
+  /// @section Member types
+  struct Settings
+  {
+    int depth{ 5 }; // bounces after the first ray, as color_at()'s
+    float cutoff{ 1.0f / 512 };
+    bool russianRoulette{ false };
+    float rouletteWeight{ 1.0f / 16 };
+    std::uint32_t seed{ 1 };
+  };
+
+  /// @brief Counts since construction or the last ResetStats()
+  struct Stats
+  {
+    std::size_t rays{ 0 };
+    std::size_t hits{ 0 };
+    std::size_t culled{ 0 };     // below the cutoff
+    std::size_t terminated{ 0 }; // lost at Russian roulette
+    std::size_t peakStack{ 0 };
+  };
+
+  /// @brief Deeper settings are clamped to it, as the stack is fixed-size
+  static constexpr int MaxDepth = 16;
+
+  /// @section Member functions
+  /// @subsection Special member functions
+  Integrator();
+  /// @param stream offsets the seed, e.g. by tile, so that threads draw
+  /// different numbers
+  explicit Integrator(const Settings& settings, std::uint32_t stream = 0);
+
+  /// @subsection Observers
+  const Settings& GetSettings() const;
+  const Stats& GetStats() const;
+
+  /// @subsection Modifiers
+  void ResetStats();
+
+  /// @subsection Operations
+  Color Trace(const World& w, const Ray& r);
+  /// @brief Trace() of a ray whose hit was found beforehand, e.g. in a packet
+  Color Trace(const World& w,
+              const Ray& r,
+              const std::optional<Intersection>& hit);
+
+private:
+  /// @brief A ray still to follow
+  struct PathRay
+  {
+    Ray ray{ Point(0, 0, 0), Vector(0, 0, 0) };
+    float weight{ 0.0f };
+    int depth{ 0 }; // bounces left after this one
+  };
+
+  /// @brief Pushes path unless the cutoff or the roulette drops it
+  void Spawn(PathRay path);
+
+  Settings m_Settings{};
+  Stats m_Stats{};
+  std::minstd_rand m_Random;
+  std::array<PathRay, MaxDepth + 1> m_Stack;
+  std::size_t m_StackSize{ 0 };
+  // reused by the rays that refract
+  Intersections m_Crossings;
+  std::vector<const Shape*> m_Containers;
+};
+
+} // namespace Scene
+} // namespace Rendering
+} // namespace RayTracer
@@ -13,6 +13,8 @@ using namespace Math;
 
 std::vector<std::shared_ptr<Shape>>& World::GetObjects()
 {
+  topLevel.Invalidate();
+  compiled.Clear();
   return objects;
 }
 
@@ -26,6 +28,16 @@ std::optional<PointLight> World::GetLightSource() const
   return light;
 }
 
+const Acceleration::TopLevelBVH& World::GetTopLevel() const
+{
+  return topLevel;
+}
+
+const CompiledScene& World::GetCompiled() const
+{
+  return compiled;
+}
+
 void World::SetLight(PointLight aPointLight)
 {
   light = aPointLight;
@@ -33,7 +45,16 @@ void World::SetLight(PointLight aPointLight)
 
 void World::AddObject(std::shared_ptr<Shape> s)
 {
+  s->AttachTo(topLevel.GetRevision());
   objects.push_back(std::move(s));
+  topLevel.Invalidate();
+  compiled.Clear();
+}
+
+void World::SetBuildSettings(const Acceleration::BVH::BuildSettings& settings)
+{
+  topLevel.SetBuildSettings(settings);
+  compiled.Clear();
 }
 
 bool World::Contains(const std::shared_ptr<Shape> s) const
@@ -51,6 +72,82 @@ bool World::Contains(const std::shared_ptr<Shape> s) const
   return false;
 }
 
+void World::Commit() const
+{
+  if (compiled.IsCurrent()) {
+    return;
+  }
+
+  const auto& revision = topLevel.GetRevision();
+  // objects pushed through GetObjects() are attached here
+  for (const auto& object : objects) {
+    object->AttachTo(revision);
+  }
+  topLevel.GetBVH(objects);
+  for (const auto& object : objects) {
+    object->Bake();
+  }
+  const auto& settings = topLevel.GetBuildSettings();
+  if (!compiled.Refit(objects, settings.refitCostLimit)) {
+    compiled.Compile(objects, revision, settings);
+  }
+}
+
+void World::Refit() const
+{
+  // the top level refits itself, and each Group below it, when the world's
+  // bounds revision moved without the object list being invalidated
+  topLevel.GetBVH(objects);
+  for (const auto& object : objects) {
+    object->Bake();
+  }
+}
+
+std::optional<Intersection> World::IntersectClosest(const Ray& r,
+                                                    float tmin,
+                                                    float tmax) const
+{
+  if (compiled.IsCurrent()) {
+    return compiled.IntersectClosest(r, tmin, tmax);
+  }
+
+  std::optional<Intersection> closest{};
+  topLevel.TraverseClosest(objects, r, tmin, tmax, [&](const Shape& object) {
+    if (auto hit = object.IntersectClosest(r, tmin, tmax)) {
+      closest = hit;
+      tmax = hit->t;
+    }
+  });
+  return closest;
+}
+
+bool World::Occluded(const Ray& r, float maxDistance) const
+{
+  if (compiled.IsCurrent()) {
+    return compiled.Occluded(r, 0.0f, maxDistance);
+  }
+
+  return topLevel.TraverseAny(
+    objects, r, 0.0f, maxDistance, [&](const Shape& object) {
+      return object.Occluded(r, 0.0f, maxDistance);
+    });
+}
+
+template<std::size_t N>
+void World::IntersectClosest(const RayPacket<N>& packet,
+                             PacketHits<N>& hits) const
+{
+  if (compiled.IsCurrent()) {
+    compiled.IntersectClosest(packet, 0.0f, hits);
+    return;
+  }
+
+  hits.fill(std::nullopt);
+  for_each_lane(packet.active, [&](std::size_t lane) {
+    hits[lane] = IntersectClosest(packet.Get(lane));
+  });
+}
+
 /// ===========================================================================
 /// @section Functions
 /// ===========================================================================
@@ -79,19 +176,17 @@ World default_world()
 Intersections intersect_world(const World& w, const Ray& r)
 {
   Intersections result;
-
-  result.Reserve(w.GetObjects().size() * 2);
-  for (const auto& object : w.GetObjects()) {
-    auto intersections = object->Intersect(r);
-    for (auto i = 0U; i < intersections.Count(); ++i) {
-      result.EmplaceBack(std::move(intersections[i]));
-    }
-  }
-
-  result.Sort();
+  intersect_world(w, r, result);
   return result;
 }
 
+void intersect_world(const World& w, const Ray& r, Intersections& xs)
+{
+  xs.Clear();
+  w.Traverse(r, [&](const Shape& object) { object.Intersect(r, xs); });
+  xs.Sort();
+}
+
 /// @todo Supporting Multiple Light Sources
 Color shade_hit(const World& w, const Computations& comps, int depth)
 {
@@ -101,7 +196,8 @@ Color shade_hit(const World& w, const Computations& comps, int depth)
 
   const auto shadowed = is_shadowed(w, comps.over_point);
 
-  auto surface = lighting(comps.object->GetMaterial(),
+  const auto& material = comps.object->GetMaterial();
+  auto surface = lighting(material,
                           w.GetLightSource().value(),
                           comps.over_point,
                           comps.eyev,
@@ -112,7 +208,6 @@ Color shade_hit(const World& w, const Computations& comps, int depth)
   auto reflected = reflected_color(w, comps, depth);
   auto refracted = refracted_color(w, comps, depth);
 
-  auto material = comps.object->GetMaterial();
   if (material.reflective > 0 && material.transparency > 0) {
     auto reflectance = schlick(comps);
     return surface + reflected * reflectance + refracted * (1 - reflectance);
@@ -122,19 +217,32 @@ Color shade_hit(const World& w, const Computations& comps, int depth)
 
 Color color_at(const World& w, const Ray& r, int depth)
 {
-  // find the intersections of the given ray with the given world
-  const auto intersections = intersect_world(w, r);
-
-  // Find the hit from the resulting intersections
-  const auto* theHit = intersections.Hit();
+  // Find the hit, without gathering anything behind it
+  return color_at(w, r, w.IntersectClosest(r), depth);
+}
 
+Color color_at(const World& w,
+               const Ray& r,
+               const std::optional<Intersection>& theHit,
+               int depth)
+{
   // Return the color black if there is no such intersection
   if (!theHit) {
     return Colors::Black;
   }
 
+  // Refraction needs every intersection along the ray, and the objects it
+  // enters and leaves, to find n1 and n2; opaque surfaces only need the hit
+  if (theHit->object->GetMaterial().transparency > 0) {
+    const auto intersections = intersect_world(w, r);
+    std::vector<const Shape*> containers;
+    const auto comps =
+      prepare_computations(*theHit, r, &intersections, &containers);
+    return shade_hit(w, comps, depth);
+  }
+
   // Otherwise, precompute the necessary values with prepare_computations
-  const auto comps = prepare_computations(*theHit, r, &intersections);
+  const auto comps = prepare_computations(*theHit, r);
 
   // Finally, call shade_hit to find the color at the hit
   return shade_hit(w, comps, depth);
@@ -156,13 +264,7 @@ bool is_shadowed(const World& world, const Tuple& point)
   const auto direction = normalize(v);
 
   const auto ray = Ray{ point, direction };
-  const auto intersections = intersect_world(world, ray);
-
-  if (const auto hit = intersections.Hit();
-      hit != nullptr && hit->t < distance) {
-    return true;
-  }
-  return false;
+  return world.Occluded(ray, distance);
 }
 
 /// ===========================================================================
@@ -172,21 +274,38 @@ bool is_shadowed(const World& world, const Tuple& point)
 Color reflected_color(const World& w, const Computations& comps, int depth)
 {
   // reflected color for a nonreflective material OR too many recursive calls
-  if (comps.object->GetMaterial().reflective == 0 || depth < 1) {
+  const auto reflective = comps.object->GetMaterial().reflective;
+  if (reflective == 0 || depth < 1) {
     return Colors::Black;
   }
 
   auto reflect_ray = Ray{ comps.over_point, comps.reflectv };
   auto color = color_at(w, reflect_ray, depth - 1);
-  return color * comps.object->GetMaterial().reflective;
+  return color * reflective;
 }
 
 Color refracted_color(const World& w, const Computations& comps, int depth)
 {
-  if (comps.object->GetMaterial().transparency == 0 || depth < 1) {
+  const auto transparency = comps.object->GetMaterial().transparency;
+  if (transparency == 0 || depth < 1) {
     return Colors::Black;
   }
 
+  // Total internal reflection leaves nothing to refract
+  const auto ray = refracted_ray(comps);
+  if (!ray) {
+    return Colors::Black;
+  }
+
+  // Find the color of the refracted ray, making sure to multiply
+  // by the transparency value to account for any opacity
+  auto color = color_at(w, *ray, depth - 1) * transparency;
+
+  return color;
+}
+
+std::optional<Ray> refracted_ray(const Computations& comps)
+{
   // Snell's Law:
   // Find the ratio of first index of refraction to the second.
   // (Yup, this is inverted from the definition of Snell's Law.)
@@ -200,7 +319,7 @@ Color refracted_color(const World& w, const Computations& comps, int depth)
 
   // if greater than 1, we got total internal reflection
   if (sin2_t > 1) {
-    return Colors::Black;
+    return std::nullopt;
   }
 
   // Find cos(theta_t) via trignometric identity
@@ -211,15 +330,19 @@ Color refracted_color(const World& w, const Computations& comps, int depth)
     comps.normalv * (n_ratio * cos_i - cos_t) - comps.eyev * n_ratio;
 
   // Create the refracted ray
-  auto refracted_ray = Ray{ comps.under_point, direction };
+  return Ray{ comps.under_point, direction };
+}
 
-  // Find the color of the refracted ray, making sure to multiply
-  // by the transparency value to account for any opacity
-  auto color = color_at(w, refracted_ray, depth - 1) *
-               comps.object->GetMaterial().transparency;
+/// ===========================================================================
+/// @section Explicit instantiations
+/// ===========================================================================
 
-  return color;
-}
+template void World::IntersectClosest(const RayPacket<4>&,
+                                      PacketHits<4>&) const;
+template void World::IntersectClosest(const RayPacket<8>&,
+                                      PacketHits<8>&) const;
+template void World::IntersectClosest(const RayPacket<16>&,
+                                      PacketHits<16>&) const;
 
 } // namespace Scene
 } // namespace Rendering
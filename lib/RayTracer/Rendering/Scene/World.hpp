@@ -1,11 +1,13 @@
 #pragma once
 #include "RayTracerPCH.hpp"
 
+#include "RayTracer/Rendering/Acceleration/TopLevelBVH.hpp"
 #include "RayTracer/Rendering/Color.hpp"
 #include "RayTracer/Rendering/Lighting/Computations.hpp"
 #include "RayTracer/Rendering/Lighting/Intersection.hpp"
 #include "RayTracer/Rendering/Lighting/Light.hpp"
 #include "RayTracer/Rendering/Primitives/Shape.hpp"
+#include "RayTracer/Rendering/Scene/CompiledScene.hpp"
 
 namespace RayTracer {
 namespace Rendering {
@@ -15,34 +17,115 @@ using namespace Primitives;
 using namespace Lighting;
 using namespace Colors;
 
+/**
+ * @brief Objects and light of a scene
+ * @details Rays find objects through a two-level hierarchy: a top-level BVH
+ * over the objects' bounds, each object keeping its own structure below.
+ * Commit() also compiles the objects into a CompiledScene, which serves the
+ * closest-hit and any-hit queries for as long as no shape changes.
+ */
 class World
 {
 public:
+  /// @brief Mutable access; the hierarchy is rebuilt on the next query, and
+  /// changes to objects added through it are seen from the next Commit()
   std::vector<std::shared_ptr<Shape>>& GetObjects();
   const std::vector<std::shared_ptr<Shape>>& GetObjects() const;
   std::optional<PointLight> GetLightSource() const;
+  const Acceleration::TopLevelBVH& GetTopLevel() const;
+  /// @brief The scene as of the last Commit(); used while IsCurrent()
+  const CompiledScene& GetCompiled() const;
   void SetLight(PointLight p);
   void AddObject(std::shared_ptr<Shape> s);
+  void SetBuildSettings(const Acceleration::BVH::BuildSettings& settings);
   bool Contains(const std::shared_ptr<Shape> s) const;
 
+  /**
+   * @brief Builds every acceleration structure now instead of on first use
+   * @details Also bakes each object's transforms (see Shape::Bake()), so
+   * that shading a hit costs one matrix product however deeply it is nested,
+   * and compiles the objects into per-type buffers (see CompiledScene).
+   * Returns at once if nothing changed since the last Commit(); where only
+   * transforms and bounds changed, the compiled scene is refitted rather
+   * than compiled again.
+   */
+  void Commit() const;
+
+  /**
+   * @brief Updates the hierarchies after objects moved, e.g. between frames
+   * @details Where only transforms changed, node boxes are refitted
+   * bottom-up and the topology is kept; hierarchies that gained objects, or
+   * that refitting degraded past BuildSettings::refitCostLimit, are rebuilt.
+   * Queries do the same on their own; this keeps the work out of the first
+   * rays of a frame. Transforms are baked again, as by Commit(), but the
+   * compiled scene is left stale until the next Commit() refits it.
+   */
+  void Refit() const;
+
+  /**
+   * @brief Nearest intersection with tmin <= t < tmax, if any
+   * @details Each hit lowers tmax, so farther objects and subtrees are
+   * rejected by their boxes. Allocates nothing for spheres, planes, cubes,
+   * triangles and groups of them. intersect_world() still returns every
+   * crossing, in order, for refraction and CSG.
+   */
+  std::optional<Intersection> IntersectClosest(const Ray& r,
+                                               float tmin = 0.0f,
+                                               float tmax = INFINITY) const;
+
+  /**
+   * @brief Whether anything intersects r with 0 <= t < maxDistance
+   * @details Returns on the first blocker found, in no particular order.
+   */
+  bool Occluded(const Ray& r, float maxDistance) const;
+
+  /**
+   * @brief IntersectClosest(ray) for every active lane of packet
+   * @details Served by the compiled scene while it is current, tracing the
+   * packet's lanes together; otherwise each lane is traced on its own.
+   */
+  template<std::size_t N>
+  void IntersectClosest(const RayPacket<N>& packet, PacketHits<N>& hits) const;
+
+  /**
+   * @brief Calls visit(object) for every object the ray's line may reach
+   */
+  template<typename Visitor>
+  void Traverse(const Ray& r, Visitor&& visit) const
+  {
+    topLevel.Traverse(objects, r, std::forward<Visitor>(visit));
+  }
+
 private:
   std::vector<std::shared_ptr<Shape>> objects{};
   std::optional<PointLight> light{};
+  Acceleration::TopLevelBVH topLevel{};
+  mutable CompiledScene compiled{};
 };
 
 World default_world();
 
 Intersections intersect_world(const World& w, const Ray& r);
+/// @brief Refills xs, so one list can be reused across rays
+void intersect_world(const World& w, const Ray& r, Intersections& xs);
 
 Color shade_hit(const World& w, const Computations& comps, int depth = 5);
 
 Color color_at(const World& w, const Ray& r, int depth = 5);
+/// @brief color_at() of a ray whose hit was found beforehand, e.g. in a packet
+Color color_at(const World& w,
+               const Ray& r,
+               const std::optional<Intersection>& hit,
+               int depth = 5);
 
 bool is_shadowed(const World& w, const Tuple& p);
 
 Color reflected_color(const World& w, const Computations& comps, int depth = 5);
 Color refracted_color(const World& w, const Computations& comps, int depth = 5);
 
+/// @return the ray refraction continues along, unless it is totally reflected
+std::optional<Ray> refracted_ray(const Computations& comps);
+
 } // namespace Scene
 } // namespace Rendering
 } // namespace RayTracer
@@ -24,6 +24,7 @@
 #include <memory>
 #include <new> // for std::align_val_t
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -39,11 +39,13 @@ std::shared_ptr<Group> HexagonSide()
 
 std::shared_ptr<Group> Hexagon()
 {
+  // one side, placed six times
+  const std::shared_ptr<const Shape> side = HexagonSide();
   auto hex = std::make_shared<Group>();
   for (auto n = 0; n <= 5; ++n) {
-    auto side = HexagonSide();
-    side->SetTransform(rotation_y(n * PI / 3));
-    hex->AddChild(side);
+    auto instance = std::make_shared<Instance>(side);
+    instance->SetTransform(rotation_y(n * PI / 3));
+    hex->AddChild(instance);
   }
   return hex;
 }
@@ -84,6 +86,7 @@ int main()
   /// =========================================================================
 
   // render the result to a canvas.
+  Print("Kernel set:", RayTracer::Cpu::ToString(RayTracer::Cpu::ActiveKernelSet()));
   Timer renderTimer("to render");
   auto canvas = render(camera, world);
   renderTimer.status();
@@ -0,0 +1,326 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Rendering::Acceleration;
+using namespace RayTracer::Rendering::Lighting;
+using namespace RayTracer::Math;
+
+namespace {
+
+/// @brief n unit boxes scattered over a 20 x 20 x 20 cube
+std::vector<BoundingBox> ScatteredBoxes(int n)
+{
+  std::vector<BoundingBox> boxes;
+  for (int i = 0; i < n; ++i) {
+    const auto x = static_cast<float>((i * 7) % 20);
+    const auto y = static_cast<float>((i * 13) % 20);
+    const auto z = static_cast<float>((i * 17) % 20);
+    boxes.push_back({ Point(x, y, z), Point(x + 1, y + 1, z + 1) });
+  }
+  return boxes;
+}
+
+/// @return true if every primitive sits in exactly one leaf, every leaf
+/// respects maxLeafSize, every node's box contains its contents and the
+/// leaves cover the slots in depth-first order
+bool IsWellFormed(const BVH& bvh,
+                  const std::vector<BoundingBox>& boxes,
+                  std::uint32_t maxLeafSize)
+{
+  const auto& nodes = bvh.GetNodes();
+  std::vector<int> seen(boxes.size(), 0);
+  std::uint32_t nextSlot = 0;
+  for (std::uint32_t index = 0; index < nodes.size(); ++index) {
+    const auto& node = nodes[index];
+    if (node.IsLeaf()) {
+      if (node.count > maxLeafSize || node.offset != nextSlot) {
+        return false;
+      }
+      nextSlot += node.count;
+      for (auto slot = node.offset; slot < node.offset + node.count; ++slot) {
+        const auto primitive = bvh.GetPrimitiveIndices()[slot];
+        ++seen[primitive];
+        if (!box_contains_box(node.Bounds(), boxes[primitive])) {
+          return false;
+        }
+      }
+    } else {
+      if (node.offset <= index + 1 || node.offset >= nodes.size()) {
+        return false;
+      }
+      const auto& left = nodes[index + 1];
+      const auto& right = nodes[node.offset];
+      if (!box_contains_box(node.Bounds(), left.Bounds()) ||
+          !box_contains_box(node.Bounds(), right.Bounds())) {
+        return false;
+      }
+    }
+  }
+  return nextSlot == boxes.size() &&
+         std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; });
+}
+
+/// @return the primitives hierarchy visits for r; wide hierarchies share the
+/// slots of binary
+template<typename Hierarchy>
+std::vector<std::uint32_t> Visited(const Hierarchy& hierarchy,
+                                   const BVH& binary,
+                                   const Ray& r)
+{
+  std::vector<std::uint32_t> result;
+  hierarchy.Traverse(r, [&](std::uint32_t slot) {
+    result.push_back(binary.GetPrimitiveIndices()[slot]);
+  });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<std::uint32_t> Visited(const BVH& bvh, const Ray& r)
+{
+  return Visited(bvh, bvh, r);
+}
+
+/// @return true if the leaf lanes of wide cover every slot exactly once and
+/// no node has more children than it has lanes
+template<std::size_t Width>
+bool IsWellFormed(const WideBVH<Width>& wide, std::size_t slotCount)
+{
+  std::vector<int> seen(slotCount, 0);
+  for (const auto& node : wide.GetNodes()) {
+    if (node.childCount == 0 || node.childCount > Width) {
+      return false;
+    }
+    for (std::uint32_t i = 0; i < node.childCount; ++i) {
+      for (auto slot = node.child[i]; slot < node.child[i] + node.count[i];
+           ++slot) {
+        ++seen[slot];
+      }
+    }
+  }
+  return std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; });
+}
+
+} // namespace
+
+SCENARIO("Building a hierarchy with either split method")
+{
+  GIVEN("boxes = 500 unit boxes scattered over a cube")
+  {
+    const auto boxes = ScatteredBoxes(500);
+
+    WHEN("median and sah are built with a leaf size of 2 and 8 bins")
+    {
+      BVH::BuildSettings settings{};
+      settings.maxLeafSize = 2;
+      settings.binCount = 8;
+      // small enough that the build recurses in parallel tasks
+      settings.parallelThreshold = 64;
+
+      BVH median;
+      settings.splitMethod = BVH::SplitMethod::Median;
+      median.Build(boxes, settings);
+
+      BVH sah;
+      settings.splitMethod = BVH::SplitMethod::BinnedSAH;
+      sah.Build(boxes, settings);
+
+      THEN("both are well formed and report their build")
+      {
+        CHECK(sizeof(BVH::Node) == 32);
+        CHECK(IsWellFormed(median, boxes, 2));
+        CHECK(IsWellFormed(sah, boxes, 2));
+        CHECK(sah.GetBuildStats().nodeCount == sah.GetNodes().size());
+        CHECK(sah.GetBuildStats().leafCount > 0);
+        CHECK(sah.GetBuildStats().milliseconds >= 0.0);
+      }
+      THEN("sah is no more expensive than median")
+      {
+        CHECK(sah.GetSAHCost() <= median.GetSAHCost());
+      }
+      THEN("both visit the same primitives for a ray through the boxes")
+      {
+        auto r = Ray{ Point(-5, 3.5, 2.5), normalize(Vector(1, 0.2, 0.4)) };
+        auto visited = Visited(sah, r);
+        CHECK(visited == Visited(median, r));
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+          if (intersects(boxes[i], r)) {
+            CHECK(std::binary_search(visited.begin(), visited.end(), i));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Building a hierarchy over identical boxes")
+{
+  GIVEN("boxes = 100 copies of the unit cube")
+  {
+    std::vector<BoundingBox> boxes(
+      100, BoundingBox{ Point(-1, -1, -1), Point(1, 1, 1) });
+    WHEN("bvh = build(boxes) with a leaf size of 4")
+    {
+      BVH bvh;
+      bvh.Build(boxes);
+      THEN("the leaves still hold at most 4 boxes each")
+      {
+        CHECK(IsWellFormed(bvh, boxes, 4));
+        CHECK(bvh.GetBuildStats().depth <= BVH::MaxDepth);
+      }
+    }
+  }
+}
+
+SCENARIO("Refitting a hierarchy after its primitives moved")
+{
+  GIVEN("bvh = a hierarchy over 500 scattered unit boxes")
+  {
+    auto boxes = ScatteredBoxes(500);
+    BVH::BuildSettings settings{};
+    settings.maxLeafSize = 2;
+    BVH bvh;
+    bvh.Build(boxes, settings);
+    const auto nodes = bvh.GetNodes().size();
+    const auto cost = bvh.GetSAHCost();
+
+    // boxes in slot order, as Refit() expects them
+    const auto inSlotOrder = [&]() {
+      std::vector<BoundingBox> slotBounds;
+      for (auto primitive : bvh.GetPrimitiveIndices()) {
+        slotBounds.push_back(boxes[primitive]);
+      }
+      return slotBounds;
+    };
+
+    WHEN("every box moves by (3, -2, 5) and bvh is refitted")
+    {
+      for (auto& box : boxes) {
+        box = transform(box, translation(3, -2, 5));
+      }
+      bvh.Refit(inSlotOrder());
+
+      THEN("the topology is kept and every box is contained again")
+      {
+        CHECK(bvh.GetNodes().size() == nodes);
+        CHECK(IsWellFormed(bvh, boxes, 2));
+        CHECK(bvh.GetBounds().min == Point(3, -2, 5));
+        CHECK(bvh.GetSAHCost() == doctest::Approx(cost));
+        CHECK_FALSE(bvh.IsDegraded(settings.refitCostLimit));
+      }
+      THEN("it visits every box the ray hits")
+      {
+        auto r = Ray{ Point(-2, -6.5, -0.5), normalize(Vector(1, 1, 1)) };
+        auto visited = Visited(bvh, r);
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+          if (intersects(boxes[i], r)) {
+            CHECK(std::binary_search(visited.begin(), visited.end(), i));
+          }
+        }
+      }
+    }
+    WHEN("the boxes trade places across the cube and bvh is refitted")
+    {
+      for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const auto x = static_cast<float>((i * 37) % 97) / 5;
+        const auto y = static_cast<float>((i * 53) % 89) / 5;
+        const auto z = static_cast<float>((i * 71) % 83) / 5;
+        boxes[i] = { Point(x, y, z), Point(x + 1, y + 1, z + 1) };
+      }
+      bvh.Refit(inSlotOrder());
+
+      THEN("it is still correct, but degraded enough to be rebuilt")
+      {
+        CHECK(IsWellFormed(bvh, boxes, 2));
+        CHECK(bvh.IsDegraded(settings.refitCostLimit));
+      }
+    }
+  }
+}
+
+SCENARIO("Collapsing a binary hierarchy into wider nodes")
+{
+  GIVEN("bvh = a hierarchy over 500 scattered unit boxes")
+  {
+    const auto boxes = ScatteredBoxes(500);
+    BVH::BuildSettings settings{};
+    settings.maxLeafSize = 2;
+    BVH bvh;
+    bvh.Build(boxes, settings);
+
+    WHEN("bvh4 and bvh8 are collapsed from bvh")
+    {
+      BVH4 bvh4;
+      bvh4.Build(bvh);
+      BVH8 bvh8;
+      bvh8.Build(bvh);
+
+      THEN("they hold every slot once, in fewer nodes")
+      {
+        CHECK(IsWellFormed(bvh4, boxes.size()));
+        CHECK(IsWellFormed(bvh8, boxes.size()));
+        CHECK(bvh4.GetNodes().size() < bvh.GetNodes().size());
+        CHECK(bvh8.GetNodes().size() < bvh4.GetNodes().size());
+      }
+      THEN("they visit the same primitives as bvh")
+      {
+        auto r = Ray{ Point(-5, -4.5, -5.5), normalize(Vector(1, 1, 1)) };
+        auto visited = Visited(bvh, r);
+        CHECK_FALSE(visited.empty());
+        CHECK(Visited(bvh4, bvh, r) == visited);
+        CHECK(Visited(bvh8, bvh, r) == visited);
+      }
+      THEN("they find the same closest distance and the same occlusion")
+      {
+        auto r = Ray{ Point(-5, -4.5, -5.5), normalize(Vector(1, 1, 1)) };
+        auto closest = [&](const auto& hierarchy) {
+          auto tmax = INFINITY;
+          const float inv[3] = { 1 / r.direction.x,
+                                 1 / r.direction.y,
+                                 1 / r.direction.z };
+          hierarchy.TraverseClosest(r, 0.0f, tmax, [&](std::uint32_t slot) {
+            const auto& box = boxes[bvh.GetPrimitiveIndices()[slot]];
+            auto tnear = 0.0f;
+            auto tfar = tmax;
+            if (intersects_slabs(box, &r.origin.x, inv, tnear, tfar)) {
+              tmax = tnear;
+            }
+          });
+          return tmax;
+        };
+        auto occluded = [&](const auto& hierarchy, float tmax) {
+          return hierarchy.TraverseAny(r, 0.0f, tmax, [&](std::uint32_t slot) {
+            return intersects(boxes[bvh.GetPrimitiveIndices()[slot]], r);
+          });
+        };
+        CHECK(closest(bvh) < INFINITY);
+        CHECK(closest(bvh4) == closest(bvh));
+        CHECK(closest(bvh8) == closest(bvh));
+        CHECK(occluded(bvh4, INFINITY) == occluded(bvh, INFINITY));
+        CHECK(occluded(bvh8, INFINITY) == occluded(bvh, INFINITY));
+        CHECK_FALSE(occluded(bvh8, 1.0f));
+      }
+    }
+  }
+  GIVEN("bvh = a hierarchy small enough to be a single leaf")
+  {
+    std::vector<BoundingBox> boxes(
+      3, BoundingBox{ Point(-1, -1, -1), Point(1, 1, 1) });
+    BVH bvh;
+    bvh.Build(boxes);
+    WHEN("bvh4 is collapsed from bvh")
+    {
+      BVH4 bvh4;
+      bvh4.Build(bvh);
+      THEN("its root holds that leaf as its only child")
+      {
+        REQUIRE(bvh4.GetNodes().size() == 1);
+        CHECK(bvh4.GetNodes()[0].childCount == 1);
+        auto r = Ray{ Point(0, 0, -5), Vector(0, 0, 1) };
+        CHECK(Visited(bvh4, bvh, r) == std::vector<std::uint32_t>{ 0, 1, 2 });
+      }
+    }
+  }
+}
@@ -0,0 +1,220 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+#include "TestShape.hpp"
+
+using namespace RayTracer::Rendering::Acceleration;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Lighting;
+using namespace RayTracer::Math;
+
+SCENARIO("Creating an empty bounding box")
+{
+  GIVEN("box = bounding_box(empty)")
+  {
+    auto box = BoundingBox{};
+    THEN("box.min == point(infinity, infinity, infinity) &&\
+          box.max == point(-infinity, -infinity, -infinity)")
+    {
+      CHECK(box.min.x == INFINITY);
+      CHECK(box.max.x == -INFINITY);
+      CHECK(is_empty(box));
+    }
+  }
+}
+
+SCENARIO("Adding points to an empty bounding box")
+{
+  GIVEN("box = bounding_box(empty) && p1 = point(-5, 2, 0) &&\
+         p2 = point(7, 0, -3)")
+  {
+    auto box = BoundingBox{};
+    WHEN("p1 is added to box && p2 is added to box")
+    {
+      add_point(box, Point(-5, 2, 0));
+      add_point(box, Point(7, 0, -3));
+      THEN("box.min == point(-5, 0, -3) && box.max == point(7, 2, 0)")
+      {
+        CHECK(box.min == Point(-5, 0, -3));
+        CHECK(box.max == Point(7, 2, 0));
+      }
+    }
+  }
+}
+
+SCENARIO("Adding one bounding box to another")
+{
+  GIVEN("box1 = bounding_box(min=point(-5, -2, 0) max=point(7, 4, 4)) &&\
+         box2 = bounding_box(min=point(8, -7, -2) max=point(14, 2, 8))")
+  {
+    auto box1 = BoundingBox{ Point(-5, -2, 0), Point(7, 4, 4) };
+    auto box2 = BoundingBox{ Point(8, -7, -2), Point(14, 2, 8) };
+    WHEN("box2 is added to box1")
+    {
+      add_box(box1, box2);
+      THEN("box1.min == point(-5, -7, -2) && box1.max == point(14, 4, 8)")
+      {
+        CHECK(box1.min == Point(-5, -7, -2));
+        CHECK(box1.max == Point(14, 4, 8));
+      }
+    }
+  }
+}
+
+SCENARIO("Checking to see if a box contains a given point or box")
+{
+  GIVEN("box = bounding_box(min=point(5, -2, 0) max=point(11, 4, 7))")
+  {
+    auto box = BoundingBox{ Point(5, -2, 0), Point(11, 4, 7) };
+    THEN("the corners and center are contained, points outside are not")
+    {
+      CHECK(box_contains_point(box, Point(5, -2, 0)));
+      CHECK(box_contains_point(box, Point(11, 4, 7)));
+      CHECK(box_contains_point(box, Point(8, 1, 3)));
+      CHECK_FALSE(box_contains_point(box, Point(3, 0, 3)));
+      CHECK_FALSE(box_contains_point(box, Point(8, -4, 3)));
+      CHECK_FALSE(box_contains_point(box, Point(8, 1, 8)));
+    }
+    THEN("a box is contained only if both its corners are")
+    {
+      CHECK(box_contains_box(
+        box, BoundingBox{ Point(6, -1, 1), Point(10, 3, 6) }));
+      CHECK_FALSE(box_contains_box(
+        box, BoundingBox{ Point(4, -3, -1), Point(10, 3, 6) }));
+    }
+  }
+}
+
+SCENARIO("Transforming a bounding box")
+{
+  GIVEN("box = bounding_box(min=point(-1, -1, -1) max=point(1, 1, 1)) &&\
+         matrix = rotation_x(π / 4) * rotation_y(π / 4)")
+  {
+    auto box = BoundingBox{ Point(-1, -1, -1), Point(1, 1, 1) };
+    auto matrix = rotation_x(PI / 4) * rotation_y(PI / 4);
+    WHEN("box2 = transform(box, matrix)")
+    {
+      auto box2 = transform(box, matrix);
+      THEN("box2.min == point(-1.4142, -1.7071, -1.7071) &&\
+            box2.max == point(1.4142, 1.7071, 1.7071)")
+      {
+        CHECK(box2.min == Point(-1.4142, -1.7071, -1.7071));
+        CHECK(box2.max == Point(1.4142, 1.7071, 1.7071));
+      }
+    }
+  }
+  GIVEN("a plane's box, infinite in x and z")
+  {
+    auto box = Plane().Bounds();
+    WHEN("box2 = transform(box, translation(0, 2, 0))")
+    {
+      auto box2 = transform(box, translation(0, 2, 0));
+      THEN("the flat axis moves and the others stay unbounded")
+      {
+        CHECK(box2.min.y == 2.0f);
+        CHECK(box2.max.y == 2.0f);
+        CHECK(box2.min.x == -INFINITY);
+        CHECK(box2.max.z == INFINITY);
+        CHECK_FALSE(is_bounded(box2));
+      }
+    }
+  }
+}
+
+SCENARIO("Intersecting a ray with a bounding box")
+{
+  GIVEN("box = bounding_box(min=point(5, -2, 0) max=point(11, 4, 7))")
+  {
+    auto box = BoundingBox{ Point(5, -2, 0), Point(11, 4, 7) };
+    THEN("rays through the box hit it and rays beside it miss")
+    {
+      CHECK(intersects(box, Ray{ Point(15, 1, 2), Vector(-1, 0, 0) }));
+      CHECK(intersects(box, Ray{ Point(8, 2, 12), Vector(0, 0, -1) }));
+      CHECK(intersects(box, Ray{ Point(5, 7, -5), Vector(1, -2, 2) }));
+      CHECK(intersects(box, Ray{ Point(8, 1, 3.5), Vector(0, 0, 1) }));
+      CHECK_FALSE(intersects(box, Ray{ Point(9, -1, -8), Vector(6, 2, 4) }));
+      CHECK_FALSE(intersects(box, Ray{ Point(12, 5, 4), Vector(-1, 0, 0) }));
+      CHECK_FALSE(intersects(box, Ray{ Point(8, 1, 8), Vector(0, 1, 0) }));
+    }
+  }
+}
+
+SCENARIO("Primitives report their bounds")
+{
+  THEN("a sphere and a cube span [-1, 1] on every axis")
+  {
+    CHECK(Sphere().Bounds().min == Point(-1, -1, -1));
+    CHECK(Cube().Bounds().max == Point(1, 1, 1));
+  }
+  THEN("a triangle is bounded by its vertices")
+  {
+    auto t = Triangle(Point(-3, 7, 2), Point(6, 2, -4), Point(2, -1, -1));
+    CHECK(t.Bounds().min == Point(-3, -1, -4));
+    CHECK(t.Bounds().max == Point(6, 7, 2));
+  }
+  GIVEN("cyl = cylinder() with minimum -5 and maximum 3 &&\
+         cone = cone() with minimum -5 and maximum 3")
+  {
+    auto cyl = Cylinder();
+    cyl.SetMinimum(-5);
+    cyl.SetMaximum(3);
+    auto cone = Cone();
+    cone.SetMinimum(-5);
+    cone.SetMaximum(3);
+    THEN("the cylinder has unit radius and the cone radius 5")
+    {
+      CHECK(cyl.Bounds().min == Point(-1, -5, -1));
+      CHECK(cyl.Bounds().max == Point(1, 3, 1));
+      CHECK(cone.Bounds().min == Point(-5, -5, -5));
+      CHECK(cone.Bounds().max == Point(5, 3, 5));
+    }
+  }
+  GIVEN("s = sphere() with transform translation(1, 2, 3) * scaling(2, 2, 2)")
+  {
+    auto s = Sphere();
+    s.SetTransform(translation(1, 2, 3) * scaling(2, 2, 2));
+    THEN("s.Bounds() is in parent space")
+    {
+      CHECK(s.Bounds().min == Point(-1, 0, 1));
+      CHECK(s.Bounds().max == Point(3, 4, 5));
+    }
+  }
+}
+
+SCENARIO("A group and a CSG shape are bounded by their children")
+{
+  GIVEN("s = sphere() with transform translation(2, 5, -3) * scaling(2, 2, 2)\
+         && c = cylinder() from -2 to 2 with transform\
+         translation(-4, -1, 4) * scaling(0.5, 1, 0.5)")
+  {
+    auto s = std::make_shared<Sphere>();
+    s->SetTransform(translation(2, 5, -3) * scaling(2, 2, 2));
+    auto c = std::make_shared<Cylinder>();
+    c->SetMinimum(-2);
+    c->SetMaximum(2);
+    c->SetTransform(translation(-4, -1, 4) * scaling(0.5, 1, 0.5));
+
+    WHEN("shape = group() containing s and c")
+    {
+      auto shape = std::make_shared<Group>();
+      shape->AddChild(s);
+      shape->AddChild(c);
+      THEN("box.min == point(-4.5, -3, -5) && box.max == point(4, 7, 4.5)")
+      {
+        CHECK(shape->Bounds().min == Point(-4.5, -3, -5));
+        CHECK(shape->Bounds().max == Point(4, 7, 4.5));
+      }
+    }
+    WHEN("shape = csg(difference, s, c)")
+    {
+      auto shape = CreateCSGShape(CSGOperation::Difference, s, c);
+      THEN("box.min == point(-4.5, -3, -5) && box.max == point(4, 7, 4.5)")
+      {
+        CHECK(shape->Bounds().min == Point(-4.5, -3, -5));
+        CHECK(shape->Bounds().max == Point(4, 7, 4.5));
+      }
+    }
+  }
+}
@@ -3,6 +3,7 @@
 
 // Engine
 #include "RayTracer.hpp"
+#include "TestShape.hpp"
 
 using namespace RayTracer::Rendering::Primitives;
 using namespace RayTracer::Math;
@@ -194,3 +195,93 @@ SCENARIO("A ray hits a CSG object")
     }
   }
 }
+
+SCENARIO("Occlusion only counts surfaces that survive the CSG operation")
+{
+  GIVEN("s1 = sphere()\
+  \n\t And s2 = sphere()\
+  \n\t And set_transform(s2, translation(0, 0, 0.5))\
+  \n c = csg('union', s1, s2)\
+  \n\t And r = ray(point(0, 0, 0), vector(0, 0, 1))")
+  {
+    auto s1 = CreateShapeAs<Sphere>();
+    auto s2 = CreateShapeAs<Sphere>();
+    s2->SetTransform(translation(0, 0, 0.5));
+    auto c = CreateCSGShape(CSGOperation::Union, s1, s2);
+    auto r = Ray{ Point(0, 0, 0), Vector(0, 0, 1) };
+
+    THEN("s1's surface at t = 1 is inside s2 and does not occlude\
+    \n\t And s2's surface at t = 1.5 does")
+    {
+      CHECK(s1->Occluded(r, 0, 1.2f));
+      CHECK_FALSE(c->Occluded(r, 0, 1.2f));
+      CHECK(c->Occluded(r, 0, 2));
+      CHECK_FALSE(c->Occluded(r, 2, INFINITY));
+    }
+  }
+}
+
+SCENARIO("A CSG only intersects the operands that can decide the result")
+{
+  GIVEN("left = test_shape()\
+  \n\t And right = test_shape()\
+  \n\t And set_transform(right, translation(5, 0, 0))\
+  \n\t And r = ray(point(0, 0, -5), vector(0, 0, 1))")
+  {
+    std::shared_ptr<Shape> left = std::make_shared<::TestShape>();
+    std::shared_ptr<Shape> right = std::make_shared<::TestShape>();
+    right->SetTransform(translation(5, 0, 0));
+    auto r = Ray{ Point(0, 0, -5), Vector(0, 0, 1) };
+    const auto& leftRay = static_cast<::TestShape&>(*left).saved_ray;
+    const auto& rightRay = static_cast<::TestShape&>(*right).saved_ray;
+
+    WHEN("c = csg('union', left, right)\
+    \n\t And xs = intersect(c, r)")
+    {
+      auto c = CreateCSGShape(CSGOperation::Union, left, right);
+      auto xs = c->Intersect(r);
+
+      THEN("left.saved_ray is set\
+      \n\t And right.saved_ray is not, as r misses its bounds")
+      {
+        CHECK(leftRay.origin == Point(0, 0, -5));
+        CHECK(rightRay.origin == Point(0, 0, 0));
+      }
+    }
+    WHEN("c = csg('intersection', right, left)\
+    \n\t And xs = intersect(c, r)")
+    {
+      auto c = CreateCSGShape(CSGOperation::Intersection, right, left);
+      auto xs = c->Intersect(r);
+
+      THEN("neither saved_ray is set, as nothing of right is hit")
+      {
+        CHECK(xs.Count() == 0);
+        CHECK(leftRay.origin == Point(0, 0, 0));
+        CHECK(rightRay.origin == Point(0, 0, 0));
+      }
+    }
+  }
+}
+
+SCENARIO("CSG operands are told apart by identity, however nested")
+{
+  GIVEN("s1 = sphere() in a group g\
+  \n\t And s2 = sphere(), equal to s1\
+  \n\t And c = csg('difference', g, s2)")
+  {
+    auto s1 = CreateShapeAs<Sphere>();
+    auto g = std::make_shared<Group>();
+    g->AddChild(s1);
+    std::shared_ptr<Shape> left = g;
+    std::shared_ptr<Shape> s2 = CreateShapeAs<Sphere>();
+    auto c = CreateCSGShape(CSGOperation::Difference, left, s2);
+
+    THEN("s1 is a leaf of the left operand and s2 is not")
+    {
+      REQUIRE(*s1 == *s2);
+      CHECK(c->IsLeftLeaf(*s1));
+      CHECK_FALSE(c->IsLeftLeaf(*s2));
+    }
+  }
+}
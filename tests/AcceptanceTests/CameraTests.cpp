@@ -115,6 +115,57 @@ SCENARIO("Constructing a ray when the camera is transformed")
   }
 }
 
+SCENARIO("A camera caches the inverse of its transform")
+{
+  GIVEN("c = camera(201, 101, PI/2)")
+  {
+    auto c = Camera{ 201, 101, PI / 2 };
+
+    WHEN("c.transform = rotation_y(PI/4) * translation(0, -2, 5)")
+    {
+      const auto t = rotation_y(PI / 4) * translation(0, -2, 5);
+      c.transform = t;
+
+      THEN("its inverse and origin follow the new transform")
+      {
+        CHECK(c.transform == t);
+        CHECK(c.transform.GetInverse() == inverse(t));
+        CHECK(c.transform.GetOrigin() == Point(0, 2, -5));
+      }
+    }
+  }
+}
+
+SCENARIO("Constructing the rays of a row incrementally")
+{
+  GIVEN("c = camera(201, 101, PI/2) &&\
+    \n c.transform = rotation_y(PI/4) * translation(0, -2, 5)")
+  {
+    auto c = Camera{ 201, 101, PI / 2 };
+    c.transform = rotation_y(PI / 4) * translation(0, -2, 5);
+
+    WHEN("rays = rays_for_row(c, 3, 17, 198)")
+    {
+      std::vector<Ray> rays{ Ray{ Point(0, 0, 0), Vector(1, 0, 0) } };
+      rays_for_row(c, 3, 17, 198, rays);
+
+      THEN("rays[i] == ray_for_pixel(c, 3 + i, 17)")
+      {
+        REQUIRE(rays.size() == 198);
+        int mismatches = 0;
+        for (std::size_t i = 0; i < rays.size(); ++i) {
+          const auto expected = ray_for_pixel(c, 3 + i, 17);
+          if (!(rays[i].origin == expected.origin) ||
+              !(rays[i].direction == expected.direction)) {
+            ++mismatches;
+          }
+        }
+        CHECK(mismatches == 0);
+      }
+    }
+  }
+}
+
 SCENARIO("Rendering a world with a camera")
 {
   GIVEN("w = default_world() &&\
@@ -142,3 +193,36 @@ SCENARIO("Rendering a world with a camera")
     }
   }
 }
+
+SCENARIO("Rendering in tiles on several threads")
+{
+  GIVEN("w = default_world() &&\
+    \n c = camera(37, 23, PI/2), which no whole number of tiles covers &&\
+    \n c.transform = view_transform(point(0, 0, -5), point(0, 0, 0), up)")
+  {
+    auto w = default_world();
+    auto c = Camera{ 37.0f, 23.0f, PI / 2.0f };
+    c.transform = view_transform(
+      Point(0.0f, 0.0f, -5.0f), Point(0.0f, 0.0f, 0.0f), Vector(0, 1, 0));
+
+    WHEN("image = render(c, w, a pool of 4 threads)")
+    {
+      RayTracer::Core::ThreadPool pool(4);
+      auto image = render(c, w, pool);
+
+      THEN("every pixel is the one color_at() gives for its ray")
+      {
+        int mismatches = 0;
+        for (int y = 0; y < 23; ++y) {
+          for (int x = 0; x < 37; ++x) {
+            const auto expected = color_at(w, ray_for_pixel(c, x, y));
+            if (!(pixel_at(image, x, y) == expected)) {
+              ++mismatches;
+            }
+          }
+        }
+        CHECK(mismatches == 0);
+      }
+    }
+  }
+}
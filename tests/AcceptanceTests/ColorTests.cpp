@@ -70,3 +70,20 @@ SCENARIO("Multiplying colors")
     }
   }
 }
+
+SCENARIO("Color arithmetic leaves the padding lane out of equality")
+{
+  GIVEN("c1 = color(0.9, 0.6, 0.75) && c2 = color(0.7, 0.1, 0.25)")
+  {
+    auto c1 = Color{ 0.9f, 0.6f, 0.75f };
+    auto c2 = Color{ 0.7f, 0.1f, 0.25f };
+
+    THEN("c1 + c2 + black == color(1.6, 0.7, 1.0) &&\
+      \n colors are 16-byte aligned")
+    {
+      CHECK(c1 + c2 + Black == Color{ 1.6f, 0.7f, 1.0f });
+      CHECK(alignof(Color) == 16);
+      CHECK(sizeof(Color) == 4 * sizeof(float));
+    }
+  }
+}
@@ -0,0 +1,396 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Cameras;
+using namespace RayTracer::Rendering::Lighting;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Scene;
+
+namespace {
+
+using Type = CompiledScene::PrimitiveType;
+
+/// @brief One of every kind of shape, some nested in transformed groups
+/// @param left, right operands of the CSG, which keeps references to them
+World MixedWorld(const std::shared_ptr<Shape>& left,
+                 const std::shared_ptr<Shape>& right)
+{
+  World w;
+  for (int i = 0; i < 4; ++i) {
+    auto s = std::make_shared<Sphere>();
+    s->SetTransform(translation(i * 3.0f - 4.5f, 0, 0) *
+                    scaling(1, 0.5f + i * 0.25f, 1));
+    w.AddObject(s);
+  }
+
+  auto cube = std::make_shared<Cube>();
+  cube->SetTransform(translation(-3, 3, 2) * rotation_y(0.5f));
+  w.AddObject(cube);
+
+  auto cylinder = std::make_shared<Cylinder>();
+  cylinder->SetMinimum(-1);
+  cylinder->SetMaximum(1);
+  cylinder->SetClosed(true);
+  cylinder->SetTransform(translation(0, 3, 2) * rotation_x(0.4f));
+  w.AddObject(cylinder);
+
+  auto cone = std::make_shared<Cone>();
+  cone->SetMinimum(-1);
+  cone->SetMaximum(0);
+  cone->SetClosed(true);
+  cone->SetTransform(translation(3, 3.5f, 2));
+  w.AddObject(cone);
+
+  auto outer = std::make_shared<Group>();
+  outer->SetTransform(translation(0, -3, 1) * rotation_z(0.3f));
+  auto inner = std::make_shared<Group>();
+  inner->SetTransform(scaling(1.5f, 1.5f, 1.5f));
+  inner->AddChild(std::make_shared<Triangle>(
+    Point(-1, 0, 0), Point(1, 0, 0), Point(0, 1, 0)));
+  inner->AddChild(std::make_shared<SmoothTriangle>(Point(-1, -1, 0.5f),
+                                                   Point(1, -1, 0.5f),
+                                                   Point(0, 0, 0.5f),
+                                                   Vector(0, 0, -1),
+                                                   Vector(0, 0, -1),
+                                                   Vector(0, 0, -1)));
+  outer->AddChild(inner);
+  auto small = std::make_shared<Cube>();
+  small->SetTransform(translation(3, 0, 0) * scaling(0.5f, 0.5f, 0.5f));
+  outer->AddChild(small);
+  w.AddObject(outer);
+
+  auto csg = CreateCSGShape(CSGOperation::Difference, left, right);
+  csg->SetTransform(translation(-4, -3, 1));
+  w.AddObject(csg);
+
+  auto geometry = std::make_shared<Sphere>();
+  auto instance = std::make_shared<Instance>(geometry);
+  instance->SetTransform(translation(5, -3, 1) * scaling(0.5f, 0.5f, 0.5f));
+  w.AddObject(instance);
+
+  auto floor = std::make_shared<Plane>();
+  floor->SetTransform(translation(0, 0, 6) * rotation_x(1.5707964f));
+  w.AddObject(floor);
+  return w;
+}
+
+/// @brief Rays from in front of the scene through a grid behind it
+std::vector<Ray> RayGrid()
+{
+  std::vector<Ray> rays;
+  for (int y = 0; y < 40; ++y) {
+    for (int x = 0; x < 40; ++x) {
+      const auto target = Point(x * 0.3f - 6.0f, y * 0.25f - 5.0f, 8);
+      const auto origin = Point(0.1f, 0.2f, -10);
+      rays.push_back(Ray{ origin, target - origin });
+    }
+  }
+  return rays;
+}
+
+} // namespace
+
+SCENARIO("Compiling a world into per-type buffers")
+{
+  GIVEN("w = a world of spheres, a cube, a cylinder, a cone, a group of \
+triangles, a CSG, an instance and a plane")
+  {
+    std::shared_ptr<Shape> left = std::make_shared<Sphere>();
+    std::shared_ptr<Shape> right = std::make_shared<Cube>();
+    right->SetTransform(translation(0.5f, 0, 0));
+    auto w = MixedWorld(left, right);
+
+    WHEN("w is committed")
+    {
+      w.Commit();
+      const auto& compiled = w.GetCompiled();
+
+      THEN("each primitive is filed under its type")
+      {
+        CHECK(compiled.IsCurrent());
+        CHECK(compiled.GetCount(Type::Sphere) == 4);
+        CHECK(compiled.GetCount(Type::Cube) == 2);
+        CHECK(compiled.GetCount(Type::Cylinder) == 1);
+        CHECK(compiled.GetCount(Type::Cone) == 1);
+        CHECK(compiled.GetCount(Type::Triangle) == 2);
+        CHECK(compiled.GetCount(Type::Plane) == 1);
+        CHECK(compiled.GetCount(Type::Shape) == 2);
+        CHECK(compiled.GetUnboundedCount() == 1);
+        CHECK(compiled.GetBVH().GetPrimitiveIndices().size() == 12);
+      }
+    }
+    WHEN("rays are cast before and after w is committed")
+    {
+      const auto rays = RayGrid();
+      std::vector<std::optional<Intersection>> expected;
+      std::vector<bool> blocked;
+      for (const auto& r : rays) {
+        expected.push_back(w.IntersectClosest(r));
+        blocked.push_back(w.Occluded(r, 0.5f));
+      }
+      w.Commit();
+
+      THEN("the compiled scene finds the same hits")
+      {
+        REQUIRE(w.GetCompiled().IsCurrent());
+        int hits = 0;
+        int mismatches = 0;
+        for (std::size_t i = 0; i < rays.size(); ++i) {
+          const auto hit = w.IntersectClosest(rays[i]);
+          if (hit.has_value() != expected[i].has_value() ||
+              blocked[i] != w.Occluded(rays[i], 0.5f)) {
+            ++mismatches;
+            continue;
+          }
+          if (hit) {
+            ++hits;
+            if (hit->object != expected[i]->object ||
+                hit->t != doctest::Approx(expected[i]->t).epsilon(1e-4)) {
+              ++mismatches;
+            }
+          }
+        }
+        CHECK(hits > 1000);
+        CHECK(mismatches == 0);
+      }
+    }
+    WHEN("rows of the grid are cast as packets of 4, 8 and 16 rays")
+    {
+      const auto rays = RayGrid();
+      std::vector<std::optional<Intersection>> expected;
+      for (const auto& r : rays) {
+        expected.push_back(w.IntersectClosest(r));
+      }
+      w.Commit();
+
+      const auto mismatchesOf = [&](auto packet) {
+        constexpr auto width = sizeof(packet.originX) / sizeof(float);
+        PacketHits<width> hits;
+        int mismatches = 0;
+        for (std::size_t first = 0; first < rays.size(); first += width) {
+          packet.active = 0;
+          for (std::size_t i = 0; i < width; ++i) {
+            packet.Set(i, rays[first + i]);
+          }
+          w.IntersectClosest(packet, hits);
+          for (std::size_t i = 0; i < width; ++i) {
+            const auto& hit = hits[i];
+            const auto& want = expected[first + i];
+            if (hit.has_value() != want.has_value() ||
+                (hit && (hit->object != want->object ||
+                         hit->t != doctest::Approx(want->t).epsilon(1e-4)))) {
+              ++mismatches;
+            }
+          }
+        }
+        return mismatches;
+      };
+
+      THEN("each lane finds the hit its ray finds alone")
+      {
+        REQUIRE(w.GetCompiled().IsCurrent());
+        CHECK(mismatchesOf(RayPacket<4>{}) == 0);
+        CHECK(mismatchesOf(RayPacket<8>{}) == 0);
+        CHECK(mismatchesOf(RayPacket<16>{}) == 0);
+      }
+    }
+    WHEN("w is committed and then a shape is moved")
+    {
+      w.Commit();
+      const auto r = Ray{ Point(-4.5f, 0, -5), Vector(0, 0, 1) };
+      const auto before = w.IntersectClosest(r);
+      std::as_const(w).GetObjects().front()->SetTransform(
+        translation(-4.5f, 0, 3));
+      const auto after = w.IntersectClosest(r);
+
+      THEN("the compiled scene is stale and queries see the move")
+      {
+        CHECK_FALSE(w.GetCompiled().IsCurrent());
+        REQUIRE(before.has_value());
+        REQUIRE(after.has_value());
+        CHECK(before->t == doctest::Approx(4));
+        CHECK(after->t == doctest::Approx(7));
+      }
+    }
+    WHEN("w and another world are committed, and then a shape of the other\
+    \n world is moved")
+    {
+      auto other = default_world();
+      w.Commit();
+      other.Commit();
+      std::as_const(other).GetObjects().front()->SetTransform(
+        translation(0, 5, 0));
+
+      THEN("only the other world's compiled scene is stale")
+      {
+        CHECK(w.GetCompiled().IsCurrent());
+        CHECK_FALSE(other.GetCompiled().IsCurrent());
+      }
+    }
+    WHEN("w is committed and then an operand of its CSG is moved")
+    {
+      w.Commit();
+      right->SetTransform(translation(0.25f, 0, 0));
+
+      THEN("w's compiled scene is stale, as the change is passed up")
+      {
+        CHECK_FALSE(w.GetCompiled().IsCurrent());
+      }
+    }
+  }
+}
+
+SCENARIO("Committing a world only as far as it changed")
+{
+  GIVEN("w = default_world() &&\
+    \n c = camera(11, 11, PI/2), looking at w from (0, 0, -5)")
+  {
+    auto w = default_world();
+    auto c = Camera{ 11, 11, PI / 2 };
+    c.transform = view_transform(
+      Point(0.0f, 0.0f, -5.0f), Point(0.0f, 0.0f, 0.0f), Vector(0, 1, 0));
+    RayTracer::Core::ThreadPool pool(2);
+    const auto& objects = std::as_const(w).GetObjects();
+    const auto& compiled = w.GetCompiled();
+    const auto& topLevel = w.GetTopLevel();
+
+    WHEN("w is rendered twice")
+    {
+      const auto first = render(c, w, pool);
+      const auto second = render(c, w, pool);
+
+      THEN("it is compiled once, and the images are the same")
+      {
+        CHECK(compiled.GetBuildCount() == 1);
+        CHECK(compiled.GetRefitCount() == 0);
+        CHECK(topLevel.GetBuildCount() == 1);
+        CHECK(pixel_at(first, 5, 5) == pixel_at(second, 5, 5));
+      }
+    }
+    WHEN("w is rendered, the inner sphere is moved, w is refitted and\
+    \n rendered again")
+    {
+      const auto first = render(c, w, pool);
+      objects[1]->SetTransform(translation(0, 0, -3) * scaling(0.5, 0.5, 0.5));
+      w.Refit();
+      const auto second = render(c, w, pool);
+
+      THEN("both hierarchies are refitted, not rebuilt, and the second image\
+      \n shows the sphere where it moved")
+      {
+        CHECK(compiled.GetBuildCount() == 1);
+        CHECK(compiled.GetRefitCount() == 1);
+        CHECK(topLevel.GetBuildCount() == 1);
+        CHECK(topLevel.GetRefitCount() == 1);
+        REQUIRE(compiled.IsCurrent());
+        const auto hit =
+          w.IntersectClosest(Ray{ Point(0, 0, -5), Vector(0, 0, 1) });
+        REQUIRE(hit.has_value());
+        CHECK(hit->object == objects[1].get());
+        CHECK(hit->t == doctest::Approx(1.5f));
+        CHECK_FALSE(pixel_at(first, 5, 5) == pixel_at(second, 5, 5));
+      }
+    }
+    WHEN("w is rendered, and then a material is edited through a kept\
+    \n reference and w rendered again")
+    {
+      const auto first = render(c, w, pool);
+      auto& material = objects[0]->SetMaterial();
+      material.color = Color{ 0, 0, 1 };
+      const auto second = render(c, w, pool);
+
+      THEN("the scene is not compiled again, and the second image shows the\
+      \n new color")
+      {
+        CHECK(compiled.GetBuildCount() == 1);
+        CHECK(compiled.GetRefitCount() == 0);
+        CHECK_FALSE(pixel_at(first, 5, 5) == pixel_at(second, 5, 5));
+      }
+    }
+    WHEN("w is rendered, and then a sphere is added and w rendered again")
+    {
+      render(c, w, pool);
+      w.AddObject(std::make_shared<Sphere>());
+      render(c, w, pool);
+
+      THEN("the scene is compiled again")
+      {
+        CHECK(compiled.GetBuildCount() == 2);
+        CHECK(compiled.GetCount(Type::Sphere) == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("Compiling unbounded primitives")
+{
+  GIVEN("w = world() with an infinite cylinder translated by (3, 0, 0) &&\
+    \n r = ray(point(3, 0, -5), vector(0, 0, 1))")
+  {
+    auto w = World();
+    auto cylinder = std::make_shared<Cylinder>();
+    cylinder->SetTransform(translation(3, 0, 0));
+    w.AddObject(cylinder);
+    const auto r = Ray{ Point(3, 0, -5), Vector(0, 0, 1) };
+
+    WHEN("w is committed")
+    {
+      w.Commit();
+      const auto hit = w.IntersectClosest(r);
+
+      THEN("the cylinder is tested through its parent's space, once")
+      {
+        CHECK(w.GetCompiled().GetUnboundedCount() == 1);
+        REQUIRE(hit.has_value());
+        CHECK(hit->object == cylinder.get());
+        CHECK(hit->t == doctest::Approx(4));
+      }
+    }
+  }
+}
+
+SCENARIO("Compiling a triangle in a small scaled group")
+{
+  GIVEN("t = triangle(point(0, 1, 0), point(-1, 0, 0), point(1, 0, 0)) &&\
+    \n g = group() with t, scaled by (0.005, 0.005, 0.005) &&\
+    \n w = world() with g &&\
+    \n r = ray(point(0, 0.001, -5), vector(0, 0, 1))")
+  {
+    auto t = std::make_shared<Triangle>(
+      Point(0, 1, 0), Point(-1, 0, 0), Point(1, 0, 0));
+    auto g = std::make_shared<Group>();
+    g->SetTransform(scaling(0.005f, 0.005f, 0.005f));
+    g->AddChild(t);
+    auto w = World();
+    w.AddObject(g);
+    const auto r = Ray{ Point(0, 0.001f, -5), Vector(0, 0, 1) };
+
+    WHEN("r is cast before and after w is committed")
+    {
+      const auto before = w.IntersectClosest(r);
+      const auto blockedBefore = w.Occluded(r, 10);
+      w.Commit();
+      const auto after = w.IntersectClosest(r);
+      const auto blockedAfter = w.Occluded(r, 10);
+      const auto xs = intersect_world(w, r);
+
+      THEN("the compiled and uncompiled queries agree on the hit")
+      {
+        CHECK(w.GetCompiled().GetCount(Type::Triangle) == 1);
+        REQUIRE(before.has_value());
+        REQUIRE(after.has_value());
+        CHECK(after->object == t.get());
+        CHECK(after->t == doctest::Approx(before->t));
+        CHECK(after->t == doctest::Approx(5));
+        CHECK(blockedBefore);
+        CHECK(blockedAfter);
+        REQUIRE(xs.Count() == 1);
+        CHECK(xs[0].t == doctest::Approx(5));
+      }
+    }
+  }
+}
@@ -0,0 +1,141 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Cpu;
+
+SCENARIO("The active kernel set never exceeds what the CPU supports")
+{
+  GIVEN("detected = DetectKernelSet()")
+  {
+    const auto detected = DetectKernelSet();
+    THEN("ActiveKernelSet() <= detected &&\
+          AvailableKernelSets() ends with detected")
+    {
+      CHECK(ActiveKernelSet() <= detected);
+      REQUIRE(!AvailableKernelSets().empty());
+      CHECK(AvailableKernelSets().front() == KernelSet::Baseline);
+      CHECK(AvailableKernelSets().back() == detected);
+    }
+    WHEN("SetActiveKernelSet(KernelSet::AVX512)")
+    {
+      const auto previous = ActiveKernelSet();
+      SetActiveKernelSet(KernelSet::AVX512);
+      THEN("ActiveKernelSet() == detected")
+      {
+        CHECK(ActiveKernelSet() == detected);
+      }
+      SetActiveKernelSet(previous);
+    }
+  }
+}
+
+SCENARIO("Every kernel set agrees with the baseline color encoding")
+{
+  GIVEN("13 colors spanning below black to above white")
+  {
+    std::vector<RayTracer::Rendering::Color> colors;
+    for (int i = 0; i < 13; ++i) {
+      const float c = static_cast<float>(i) * 0.1f - 0.1f;
+      colors.push_back({ c, 1.0f - c, c * 0.5f });
+    }
+    const float* rgbx = &colors.data()->r;
+
+    std::vector<std::uint8_t> expected(colors.size() * 4);
+    GetKernels(KernelSet::Baseline)
+      .encodeColors(rgbx, colors.size(), expected.data());
+
+    THEN("channels are clamped to [0, 255]")
+    {
+      CHECK(expected[0] == 0);
+      CHECK(expected[1] == 255);
+      CHECK(expected[12 * 4] == 255);
+    }
+    THEN("every available kernel set produces identical bytes")
+    {
+      for (auto set : AvailableKernelSets()) {
+        std::vector<std::uint8_t> actual(colors.size() * 4);
+        GetKernels(set).encodeColors(rgbx, colors.size(), actual.data());
+        INFO(ToString(set));
+        CHECK(actual == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("Every kernel set agrees with the baseline packet kernels")
+{
+  GIVEN("rays = 16 rays from z = -5, fanning out across the unit solids &&\
+    \n corner = triangle(point(0, 1, 0), point(-1, 0, 0), point(1, 0, 0))")
+  {
+    constexpr std::size_t Count = 16;
+    float originX[Count];
+    float originY[Count];
+    float originZ[Count];
+    float directionX[Count];
+    float directionY[Count];
+    float directionZ[Count];
+    for (std::size_t i = 0; i < Count; ++i) {
+      const float spread = static_cast<float>(i) * 0.1f - 0.8f;
+      originX[i] = spread;
+      originY[i] = 0.3f;
+      originZ[i] = -5.0f;
+      directionX[i] = spread * 0.1f;
+      directionY[i] = -0.05f;
+      directionZ[i] = 1.0f;
+    }
+    const RayLanes rays{ originX,    originY,    originZ,
+                         directionX, directionY, directionZ,
+                         Count };
+    const float corner[9] = { 0, 1, 0, -1, -1, 0, 1, -1, 0 };
+
+    const auto& baseline = GetKernels(KernelSet::Baseline);
+    float s1[Count], s2[Count], c1[Count], c2[Count];
+    float t[Count], u[Count], v[Count];
+    const auto spheres = baseline.solveSpheres(rays, s1, s2);
+    const auto cubes = baseline.solveCubes(rays, c1, c2);
+    const auto triangles = baseline.solveTriangles(corner, rays, t, u, v);
+
+    THEN("some rays hit each primitive and some miss")
+    {
+      CHECK(spheres != 0);
+      CHECK(spheres != 0xFFFF);
+      CHECK(cubes != 0);
+      CHECK(triangles != 0);
+      CHECK(triangles != 0xFFFF);
+    }
+    THEN("every available kernel set reports the same hits and distances")
+    {
+      for (auto set : AvailableKernelSets()) {
+        const auto& kernels = GetKernels(set);
+        float a[Count], b[Count], w[Count];
+        INFO(ToString(set));
+
+        REQUIRE(kernels.solveSpheres(rays, a, b) == spheres);
+        for (std::size_t i = 0; i < Count; ++i) {
+          if ((spheres >> i) & 1) {
+            CHECK(a[i] == s1[i]);
+            CHECK(b[i] == s2[i]);
+          }
+        }
+        REQUIRE(kernels.solveCubes(rays, a, b) == cubes);
+        for (std::size_t i = 0; i < Count; ++i) {
+          if ((cubes >> i) & 1) {
+            CHECK(a[i] == c1[i]);
+            CHECK(b[i] == c2[i]);
+          }
+        }
+        REQUIRE(kernels.solveTriangles(corner, rays, a, b, w) == triangles);
+        for (std::size_t i = 0; i < Count; ++i) {
+          if ((triangles >> i) & 1) {
+            CHECK(a[i] == t[i]);
+            CHECK(b[i] == u[i]);
+            CHECK(w[i] == v[i]);
+          }
+        }
+      }
+    }
+  }
+}
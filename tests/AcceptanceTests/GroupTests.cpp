@@ -132,6 +132,182 @@ SCENARIO("Intersecting a transformed group")
   }
 }
 
+SCENARIO("Intersecting ray+group doesn't test children if box is missed")
+{
+  GIVEN("child = test_shape()\
+  \n\t And shape = group()\
+  \n\t And add_child(shape, child)\
+  \n\t And r = ray(point(0, 0, -5), vector(0, 1, 0))")
+  {
+    auto child = std::make_shared<::TestShape>();
+    auto shape = std::make_shared<Group>();
+    shape->AddChild(child);
+    auto r = Ray{ Point(0, 0, -5), Vector(0, 1, 0) };
+
+    WHEN("xs = intersect(shape, r)")
+    {
+      auto xs = shape->Intersect(r);
+      THEN("child.saved_ray is unset")
+      {
+        CHECK(child->saved_ray.origin == Point(0, 0, 0));
+      }
+    }
+  }
+}
+
+SCENARIO("Intersecting ray+group tests children if box is hit")
+{
+  GIVEN("child = test_shape()\
+  \n\t And shape = group()\
+  \n\t And add_child(shape, child)\
+  \n\t And r = ray(point(0, 0, -5), vector(0, 0, 1))")
+  {
+    auto child = std::make_shared<::TestShape>();
+    auto shape = std::make_shared<Group>();
+    shape->AddChild(child);
+    auto r = Ray{ Point(0, 0, -5), Vector(0, 0, 1) };
+
+    WHEN("xs = intersect(shape, r)")
+    {
+      auto xs = shape->Intersect(r);
+      THEN("child.saved_ray is set")
+      {
+        CHECK(child->saved_ray.origin == Point(0, 0, -5));
+      }
+    }
+  }
+}
+
+SCENARIO("A group's hierarchy follows changes to its children")
+{
+  GIVEN("g = group() of 100 spheres in a row along x\
+  \n\t And r = ray(point(-10, 0, -5), vector(0, 0, 1))")
+  {
+    auto g = std::make_shared<Group>();
+    std::vector<std::shared_ptr<Sphere>> spheres;
+    for (int i = 0; i < 100; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation(i * 3.0f, 0, 0));
+      g->AddChild(s);
+      spheres.push_back(s);
+    }
+    auto r = Ray{ Point(-10, 0, -5), Vector(0, 0, 1) };
+
+    THEN("the ray misses every sphere")
+    {
+      CHECK(g->Intersect(r).Count() == 0);
+    }
+
+    WHEN("the last sphere is moved into the path of r")
+    {
+      CHECK(g->Intersect(r).Count() == 0);
+      spheres.back()->SetTransform(translation(-10, 0, 0));
+      auto xs = g->Intersect(r);
+      THEN("xs.count == 2 && xs[0].object == the last sphere")
+      {
+        REQUIRE(xs.Count() == 2);
+        CHECK(xs[0].object == spheres.back().get());
+        CHECK(g->Bounds().min.x == doctest::Approx(-11));
+      }
+    }
+  }
+}
+
+SCENARIO("Finding the closest hit in a nested group")
+{
+  GIVEN("g = group() with a transform of scaling(2, 2, 2)\
+  \n\t And g holds a sphere, a cube and a subgroup of 20 spheres along z")
+  {
+    auto g = std::make_shared<Group>();
+    g->SetTransform(scaling(2, 2, 2));
+    auto sphere = std::make_shared<Sphere>();
+    sphere->SetTransform(translation(0, 0, -5));
+    g->AddChild(sphere);
+    auto cube = std::make_shared<Cube>();
+    cube->SetTransform(translation(3, 0, 0));
+    g->AddChild(cube);
+    auto row = std::make_shared<Group>();
+    for (int i = 0; i < 20; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation(0, 0, i * 3.0f));
+      row->AddChild(s);
+    }
+    g->AddChild(row);
+
+    WHEN("rays are cast along z from both ends and across x")
+    {
+      const Ray rays[] = {
+        { Point(0, 0, -20), Vector(0, 0, 1) },
+        { Point(0, 0, 200), Vector(0, 0, -1) },
+        { Point(0, 0, 30), Vector(0, 0, 1) },
+        { Point(-20, 0, 0), Vector(1, 0, 0) },
+        { Point(20, 1, 0), Vector(-1, 0, 0) },
+        { Point(0, 20, 0), Vector(0, 0, 1) },
+      };
+
+      THEN("IntersectClosest() agrees with the hit of Intersect()")
+      {
+        for (const auto& r : rays) {
+          const auto xs = g->Intersect(r);
+          const auto* expected = xs.Hit();
+          const auto closest = g->IntersectClosest(r, 0, INFINITY);
+          REQUIRE(closest.has_value() == (expected != nullptr));
+          if (expected) {
+            CHECK(*closest == *expected);
+          }
+        }
+        CHECK(g->IntersectClosest(rays[0], 0, INFINITY)->object ==
+              sphere.get());
+      }
+    }
+  }
+}
+
+SCENARIO("A group traverses the hierarchy its build settings select")
+{
+  GIVEN("g = group() of 64 spheres on an 8 x 8 grid")
+  {
+    auto g = std::make_shared<Group>();
+    for (int i = 0; i < 64; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation((i % 8) * 3.0f, (i / 8) * 3.0f, 0));
+      g->AddChild(s);
+    }
+    const Ray rays[] = {
+      { Point(0, 0, -5), Vector(0, 0, 1) },
+      { Point(9, 12.5, -5), Vector(0, 0, 1) },
+      { Point(-5, 6, 0), Vector(1, 0, 0) },
+      { Point(1.5, 1.5, -5), Vector(0, 0, 1) },
+    };
+    std::vector<Intersections> binary;
+    for (const auto& r : rays) {
+      binary.push_back(g->Intersect(r));
+    }
+
+    WHEN("its width is set to 4, then 8")
+    {
+      THEN("every query agrees with the binary hierarchy")
+      {
+        for (std::uint32_t width : { 4u, 8u }) {
+          RayTracer::Rendering::Acceleration::BVH::BuildSettings settings{};
+          settings.width = width;
+          g->SetBuildSettings(settings);
+          for (std::size_t i = 0; i < std::size(rays); ++i) {
+            const auto xs = g->Intersect(rays[i]);
+            REQUIRE(xs.Count() == binary[i].Count());
+            for (std::size_t j = 0; j < xs.Count(); ++j) {
+              CHECK(xs[j] == binary[i][j]);
+            }
+            const auto closest = g->IntersectClosest(rays[i], 0, INFINITY);
+            CHECK(closest.has_value() == (binary[i].Hit() != nullptr));
+            CHECK(g->Occluded(rays[i], 0, INFINITY) == closest.has_value());
+          }
+        }
+      }
+    }
+  }
+}
+
 SCENARIO("Converting a point from world to object space")
 {
   GIVEN("g1 = group()\
@@ -222,3 +398,77 @@ SCENARIO("Finding a normal on a child object")
     }
   }
 }
+
+SCENARIO("Baking the transforms of nested groups")
+{
+  GIVEN("g1 = group() with transform rotation_y(PI/2)\
+  \n\t And g2 = group() with transform scaling(1, 2, 3), a child of g1\
+  \n\t And s = sphere() with transform translation(5, 0, 0), a child of g2")
+  {
+    auto g1 = std::make_shared<Group>();
+    g1->SetTransform(rotation_y(PI / 2));
+    auto g2 = std::make_shared<Group>();
+    g2->SetTransform(scaling(1, 2, 3));
+    g1->AddChild(g2);
+    auto s = std::make_shared<Sphere>();
+    s->SetTransform(translation(5, 0, 0));
+    g2->AddChild(s);
+
+    const auto point = Point(1.7321, 1.1547, -5.5774);
+    const auto local = s->WorldToObject(point);
+    const auto normal = s->GetNormalAt(point);
+
+    WHEN("g1 is baked")
+    {
+      g1->Bake();
+
+      THEN("s is baked and maps points and normals as the parent walk did")
+      {
+        CHECK(s->IsBaked());
+        CHECK(g2->IsBaked());
+        CHECK(s->WorldToObject(point) == local);
+        CHECK(s->GetNormalAt(point) == normal);
+        CHECK(s->GetNormalAt(point) == Vector(0.2857, 0.4286, -0.8571));
+      }
+    }
+    WHEN("g1 is baked, then g2's transform changes")
+    {
+      g1->Bake();
+      g2->SetTransform(scaling(2, 2, 2));
+
+      THEN("the baked matrices below g1 are dropped and the walk sees the\
+      \n change")
+      {
+        CHECK_FALSE(s->IsBaked());
+        CHECK_FALSE(g2->IsBaked());
+        CHECK(g1->IsBaked());
+        CHECK(s->WorldToObject(Point(0, 0, -12)) == Point(1, 0, 0));
+      }
+    }
+  }
+  GIVEN("s = sphere() nested in 32 groups, each translated by (1, 0, 0)")
+  {
+    auto root = std::make_shared<Group>();
+    root->SetTransform(translation(1, 0, 0));
+    auto parent = root;
+    for (int depth = 1; depth < 32; ++depth) {
+      auto g = std::make_shared<Group>();
+      g->SetTransform(translation(1, 0, 0));
+      parent->AddChild(g);
+      parent = g;
+    }
+    auto s = std::make_shared<Sphere>();
+    parent->AddChild(s);
+
+    WHEN("the root is baked")
+    {
+      root->Bake();
+      THEN("s's world-to-object matrix folds in all 32 translations")
+      {
+        CHECK(s->IsBaked());
+        CHECK(s->WorldToObject(Point(32, 0, -1)) == Point(0, 0, -1));
+        CHECK(s->GetNormalAt(Point(31, 0, 0)) == Vector(-1, 0, 0));
+      }
+    }
+  }
+}
@@ -0,0 +1,132 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Lighting;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Colors;
+using namespace RayTracer::Rendering::Scene;
+
+SCENARIO("Instances share their geometry")
+{
+  GIVEN("g = group() of 10 spheres")
+  {
+    auto g = std::make_shared<Group>();
+    for (int i = 0; i < 10; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation(i * 3.0f, 0, 0));
+      g->AddChild(s);
+    }
+    const auto* nodes = g->GetBVH().GetNodes().data();
+
+    WHEN("100 instances of g are created, each translated along z")
+    {
+      TrackNew::reset();
+      std::vector<std::shared_ptr<Instance>> instances;
+      instances.reserve(100);
+      const auto reserved = TrackNew::getStatus().sizeSum;
+      for (int i = 0; i < 100; ++i) {
+        auto instance = std::make_shared<Instance>(g);
+        instance->SetTransform(translation(0, 0, i * 3.0f));
+        instances.push_back(std::move(instance));
+      }
+      const auto bytes = TrackNew::getStatus().sizeSum - reserved;
+
+      THEN("each costs one allocation of its own and none of g's")
+      {
+        CHECK(TrackNew::getStatus().mallocNum == 101);
+        CHECK(bytes <= 100 * (sizeof(Instance) + 64));
+        CHECK(g->GetBVH().GetNodes().data() == nodes);
+      }
+      THEN("each is bounded by g's bounds under its own transform")
+      {
+        CHECK(instances[0]->Bounds().min == Point(-1, -1, -1));
+        CHECK(instances[0]->Bounds().max == Point(28, 1, 1));
+        CHECK(instances[99]->Bounds().min == Point(-1, -1, 296));
+        CHECK(instances[99]->Bounds().max == Point(28, 1, 298));
+      }
+    }
+  }
+}
+
+SCENARIO("Intersecting a ray with an instance")
+{
+  GIVEN("s = sphere() with a transform of scaling(2, 2, 2)\
+  \n\t  And instance = instance(s) with a transform of translation(5, 0, 0)")
+  {
+    auto s = std::make_shared<Sphere>();
+    s->SetTransform(scaling(2, 2, 2));
+    auto instance = std::make_shared<Instance>(s);
+    instance->SetTransform(translation(5, 0, 0));
+
+    WHEN("r = ray(point(5, 0, -5), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(5, 0, -5), Vector(0, 0, 1) };
+      auto xs = instance->Intersect(r);
+
+      THEN("the hits are reported on the instance, with s as the leaf")
+      {
+        REQUIRE(xs.Count() == 2);
+        CHECK(xs[0].t == doctest::Approx(3));
+        CHECK(xs[1].t == doctest::Approx(7));
+        CHECK(xs[0].object == instance.get());
+        CHECK(xs[0].leaf == s.get());
+        auto closest = instance->IntersectClosest(r, 0, INFINITY);
+        REQUIRE(closest.has_value());
+        CHECK(*closest == xs[0]);
+        CHECK(closest->leaf == s.get());
+        CHECK(instance->Occluded(r, 0, INFINITY));
+        CHECK_FALSE(instance->Occluded(r, 0, 2.9f));
+      }
+      THEN("the normal at the hit accounts for both transforms")
+      {
+        CHECK(instance->GetNormalAt(Point(5, 0, -2), &xs[0]) ==
+              Vector(0, 0, -1));
+        auto oblique = Point(5 + std::sqrt(2.0f), std::sqrt(2.0f), 0);
+        CHECK(instance->GetNormalAt(oblique, &xs[0]) ==
+              Vector(std::sqrt(2.0f) / 2, std::sqrt(2.0f) / 2, 0));
+      }
+    }
+  }
+}
+
+SCENARIO("Instances shade with their own material")
+{
+  GIVEN("s = sphere() with a red, matte material\
+  \n\t  And left and right = instances of s on either side of the origin\
+  \n\t  And right's material is overridden with a green one\
+  \n\t  And w = a world holding both and a light behind the eye")
+  {
+    auto s = std::make_shared<Sphere>();
+    s->SetMaterial().color = Color{ 1, 0, 0 };
+    s->SetMaterial().specular = 0;
+    auto left = std::make_shared<Instance>(s);
+    left->SetTransform(translation(-2, 0, 0));
+    auto right = std::make_shared<Instance>(s);
+    right->SetTransform(translation(2, 0, 0));
+    right->SetMaterial().color = Color{ 0, 1, 0 };
+
+    World w;
+    w.SetLight(PointLight{ Point(0, 0, -10), Color{ 1, 1, 1 } });
+    w.AddObject(left);
+    w.AddObject(right);
+
+    WHEN("a ray is cast at the center of each instance")
+    {
+      auto leftColor = color_at(w, Ray{ Point(-2, 0, -5), Vector(0, 0, 1) });
+      auto rightColor = color_at(w, Ray{ Point(2, 0, -5), Vector(0, 0, 1) });
+
+      THEN("left keeps the geometry's red and right is green")
+      {
+        CHECK(left->GetMaterial().color == Color{ 1, 0, 0 });
+        CHECK(leftColor.r > 0.5f);
+        CHECK(leftColor.g == doctest::Approx(0));
+        CHECK(rightColor.g > 0.5f);
+        CHECK(rightColor.r == doctest::Approx(0));
+      }
+    }
+  }
+}
@@ -0,0 +1,204 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+#include "TestWorlds.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Cameras;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Scene;
+
+namespace {
+
+/// @brief Two planes at y = -1 and y = 1 facing each other, both reflective,
+/// lit from between them
+World Mirrors(float reflective)
+{
+  auto w = World();
+  w.SetLight({ Point(0, 0, 0), Color{ 1, 1, 1 } });
+
+  auto lower = std::make_shared<Plane>();
+  lower->SetMaterial().reflective = reflective;
+  lower->SetTransform(translation(0, -1, 0));
+  w.AddObject(lower);
+
+  auto upper = std::make_shared<Plane>();
+  upper->SetMaterial().reflective = reflective;
+  upper->SetTransform(translation(0, 1, 0));
+  w.AddObject(upper);
+  return w;
+}
+
+} // namespace
+
+SCENARIO("Tracing without a cutoff")
+{
+  GIVEN("w = default_world() over a reflective floor, with a glass sphere &&\
+    \n settings = a depth of 5, a cutoff of 0 and no roulette")
+  {
+    auto w = GlassWorld();
+    w.Commit();
+    const auto settings = Integrator::Settings{ 5, 0.0f };
+
+    THEN("every camera ray gets the color color_at() gives")
+    {
+      const auto c = LookingDown(20, 15);
+      auto integrator = Integrator(settings);
+      int mismatches = 0;
+      for (int y = 0; y < 15; ++y) {
+        for (int x = 0; x < 20; ++x) {
+          const auto r = ray_for_pixel(c, x, y);
+          if (!(integrator.Trace(w, r) == color_at(w, r))) {
+            ++mismatches;
+          }
+        }
+      }
+      CHECK(mismatches == 0);
+      CHECK(integrator.GetStats().culled == 0);
+      CHECK(integrator.GetStats().peakStack <= 6);
+    }
+    THEN("rendering with it gives render()'s image")
+    {
+      const auto c = LookingDown(40, 30);
+      RayTracer::Core::ThreadPool pool(3);
+      const auto image = render(c, w, settings, pool);
+      const auto expected = render(c, w, pool);
+      int mismatches = 0;
+      for (int y = 0; y < 30; ++y) {
+        for (int x = 0; x < 40; ++x) {
+          if (!(pixel_at(image, x, y) == pixel_at(expected, x, y))) {
+            ++mismatches;
+          }
+        }
+      }
+      CHECK(mismatches == 0);
+    }
+  }
+}
+
+SCENARIO("Cutting off paths that contribute little")
+{
+  GIVEN("w = two mirrors of reflectivity 0.5 facing each other &&\
+    \n r = ray(point(0, 0, 0), vector(0, -1, 0))")
+  {
+    const auto w = Mirrors(0.5f);
+    const auto r = Ray{ Point(0, 0, 0), Vector(0, -1, 0) };
+
+    WHEN("r is traced to a depth of 16 with a cutoff of 0.1")
+    {
+      auto integrator = Integrator({ 16, 0.1f });
+      integrator.Trace(w, r);
+      const auto& stats = integrator.GetStats();
+
+      THEN("the path stops once its weight is below 0.1, not at the depth")
+      {
+        // weights 1, 0.5, 0.25 and 0.125 are traced; 0.0625 is not
+        CHECK(stats.rays == 4);
+        CHECK(stats.hits == 4);
+        CHECK(stats.culled == 1);
+        CHECK(stats.peakStack == 1);
+      }
+    }
+    WHEN("r is traced with the depth over Integrator::MaxDepth")
+    {
+      auto integrator = Integrator({ 100, 0.0f });
+      integrator.Trace(w, r);
+
+      THEN("the depth is clamped to it")
+      {
+        CHECK(integrator.GetSettings().depth == Integrator::MaxDepth);
+        CHECK(integrator.GetStats().rays == Integrator::MaxDepth + 1);
+      }
+    }
+  }
+  GIVEN("w = two perfect mirrors facing each other")
+  {
+    const auto w = Mirrors(1.0f);
+
+    THEN("tracing between them terminates at the depth")
+    {
+      auto integrator = Integrator();
+      const auto c =
+        integrator.Trace(w, Ray{ Point(0, 0, 0), Vector(0, 1, 0) });
+      CHECK(c == color_at(w, Ray{ Point(0, 0, 0), Vector(0, 1, 0) }));
+      CHECK(integrator.GetStats().rays == 6);
+    }
+  }
+}
+
+SCENARIO("Ending paths by Russian roulette")
+{
+  GIVEN("w = two mirrors of reflectivity 0.5 facing each other &&\
+    \n settings = a depth of 5, no cutoff, and roulette below 0.5")
+  {
+    const auto w = Mirrors(0.5f);
+    const auto r = Ray{ Point(0, 0, 0), Vector(0, -1, 0) };
+    auto settings = Integrator::Settings{ 5, 0.0f, true, 0.5f };
+
+    WHEN("r is traced many times")
+    {
+      constexpr int traces = 4000;
+      auto integrator = Integrator(settings);
+      auto sum = Color{ 0, 0, 0 };
+      for (int i = 0; i < traces; ++i) {
+        sum = sum + integrator.Trace(w, r);
+      }
+      const auto mean = sum * (1.0f / traces);
+      const auto expected = color_at(w, r);
+
+      THEN("some paths are ended early, but the mean color is unchanged")
+      {
+        CHECK(integrator.GetStats().terminated > 0);
+        CHECK(integrator.GetStats().rays < traces * 6);
+        CHECK(mean.r == doctest::Approx(expected.r).epsilon(0.01));
+        CHECK(mean.g == doctest::Approx(expected.g).epsilon(0.01));
+        CHECK(mean.b == doctest::Approx(expected.b).epsilon(0.01));
+      }
+    }
+    WHEN("two integrators are made with the same seed")
+    {
+      auto first = Integrator(settings, 7);
+      auto second = Integrator(settings, 7);
+
+      THEN("they trace the same paths")
+      {
+        for (int i = 0; i < 16; ++i) {
+          CHECK(first.Trace(w, r) == second.Trace(w, r));
+        }
+        CHECK(first.GetStats().rays == second.GetStats().rays);
+      }
+    }
+  }
+}
+
+SCENARIO("Tracing through transparent surfaces")
+{
+  GIVEN("w = default_world() over a glass floor, with a red ball under it &&\
+    \n r = ray(point(0, 0, -3), vector(0, -SQRT(2)/2, SQRT(2)/2))")
+  {
+    const auto sqrt2 = static_cast<float>(std::sqrt(2));
+    const auto r = Ray{ Point(0, 0, -3), Vector(0, -sqrt2 / 2, sqrt2 / 2) };
+    auto integrator = Integrator({ 5, 0.0f });
+
+    WHEN("the floor is transparent")
+    {
+      const auto w = GlassFloorWorld(0.0f);
+
+      THEN("Trace(w, r) == color(0.93642, 0.68642, 0.68642)")
+      {
+        CHECK(integrator.Trace(w, r) == Color{ 0.93642f, 0.68642f, 0.68642f });
+      }
+    }
+    WHEN("the floor is also reflective")
+    {
+      const auto w = GlassFloorWorld(0.5f);
+
+      THEN("Trace(w, r) == color(0.93391, 0.69643, 0.69243)")
+      {
+        CHECK(integrator.Trace(w, r) == Color{ 0.93391f, 0.69643f, 0.69243f });
+      }
+    }
+  }
+}
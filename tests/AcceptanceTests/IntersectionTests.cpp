@@ -469,3 +469,45 @@ SCENARIO("An intersection can encapsulate 'u' and 'v'")
     }
   }
 }
+
+SCENARIO("Intersections stay inline until they outgrow the inline buffer")
+{
+  GIVEN("s = sphere() And xs = intersections()")
+  {
+    auto s = Sphere();
+    auto xs = Intersections();
+
+    WHEN("InlineCapacity intersections are added in reverse order")
+    {
+      TrackNew::reset();
+      for (auto i = Intersections::InlineCapacity; i > 0; --i) {
+        xs.EmplaceBack(static_cast<float>(i), &s);
+      }
+      xs.Sort();
+      const auto allocations = TrackNew::getStatus().mallocNum;
+
+      THEN("nothing was allocated And xs is sorted")
+      {
+        CHECK(allocations == 0);
+        CHECK(xs.IsInline());
+        CHECK(xs.Count() == Intersections::InlineCapacity);
+        CHECK(xs[0].t == 1);
+        CHECK(xs.Hit()->t == 1);
+      }
+
+      AND_WHEN("one more is added And xs is copied")
+      {
+        xs.EmplaceBack(-1.0f, &s);
+        auto copy = xs;
+
+        THEN("both lists hold every intersection on the heap")
+        {
+          CHECK_FALSE(xs.IsInline());
+          CHECK(copy.Count() == Intersections::InlineCapacity + 1);
+          CHECK(copy[Intersections::InlineCapacity].t == -1);
+          CHECK(copy.Hit()->t == 1);
+        }
+      }
+    }
+  }
+}
@@ -725,3 +725,65 @@ SCENARIO("Calculating the product of a matrix by its inverse")
     }
   }
 }
+
+SCENARIO("The closed-form inverse agrees with the cofactor expansion")
+{
+  GIVEN("the following 4x4 matrix A:\
+    \n| -5 |  2 |  6 | -8 |\
+    \n|  1 | -5 |  1 |  8 |\
+    \n|  7 |  7 | -6 | -7 |\
+    \n|  1 | -3 |  7 |  4 |\n")
+  {
+    mat4 A = {
+      -5, 2,  6,  -8, //
+      1,  -5, 1,  8,  //
+      7,  7,  -6, -7, //
+      1,  -3, 7,  4   //
+    };
+
+    THEN("inverse(A) == inverse<4, 4>(A) && !isAffine(A)")
+    {
+      CHECK(!isAffine(A));
+      CHECK(inverse(A) == inverse<4, 4>(A));
+      CHECK(determinant(A) == determinant<4, 4>(A));
+    }
+  }
+}
+
+SCENARIO("Inverting an affine transformation")
+{
+  GIVEN("A = translation(1, -2, 3) * rotation_y(PI/3) * shearing(1, 0, 0.5, 0, 0, 2)\
+    \n\t * scaling(2, 4, 0.5)")
+  {
+    auto A = translation(1, -2, 3) * rotation_y(PI / 3) *
+             shearing(1, 0, 0.5, 0, 0, 2) * scaling(2, 4, 0.5);
+
+    THEN("isAffine(A) &&\
+      \n affine_inverse(A) == inverse<4, 4>(A) &&\
+      \n A * inverse(A) == identity_matrix")
+    {
+      CHECK(isAffine(A));
+      CHECK(affine_inverse(A) == inverse<4, 4>(A));
+      CHECK(A * inverse(A) == mat4::Identity());
+    }
+  }
+}
+
+SCENARIO("Inverting a noninvertible matrix")
+{
+  GIVEN("A = scaling(1, 0, 1)")
+  {
+    auto A = scaling(1, 0, 1);
+
+    THEN("inverse(A) throws")
+    {
+      auto threw = false;
+      try {
+        inverse(A);
+      } catch (const std::runtime_error&) {
+        threw = true;
+      }
+      CHECK(threw);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Acceleration;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Parsers;
+
+namespace {
+
+/// @brief An empty directory of its own under the system's temporary one
+std::filesystem::path ScratchDirectory(const char* name)
+{
+  auto path = std::filesystem::temp_directory_path()
+                .append("RayTracerTests")
+                .append(name);
+  std::filesystem::remove_all(path);
+  std::filesystem::create_directories(path);
+  return path;
+}
+
+/// @brief Writes an n x n grid of unit squares at height z as OBJ faces
+void WriteGrid(const std::filesystem::path& path, int n, float z)
+{
+  std::ofstream file(path);
+  for (int y = 0; y <= n; ++y) {
+    for (int x = 0; x <= n; ++x) {
+      file << "v " << x << ' ' << y << ' ' << z << '\n';
+    }
+  }
+  for (int y = 0; y < n; ++y) {
+    for (int x = 0; x < n; ++x) {
+      const auto corner = y * (n + 1) + x + 1;
+      const auto above = corner + n + 1;
+      file << "f " << corner << ' ' << corner + 1 << ' ' << above + 1 << ' '
+           << above << '\n';
+    }
+  }
+}
+
+bool SameNodes(const BVH& a, const BVH& b)
+{
+  const auto& lhs = a.GetNodes();
+  const auto& rhs = b.GetNodes();
+  return lhs.size() == rhs.size() &&
+         std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(BVH::Node)) ==
+           0 &&
+         a.GetPrimitiveIndices() == b.GetPrimitiveIndices();
+}
+
+} // namespace
+
+SCENARIO("Loading a mesh through a cache")
+{
+  GIVEN("file = an OBJ file of a 20 x 20 grid of squares\
+  \n\t  And cache = mesh_cache(an empty directory)")
+  {
+    const auto directory = ScratchDirectory("MeshCache");
+    const auto file = directory / "grid.obj";
+    WriteGrid(file, 20, 0);
+    MeshCache cache(directory / "cache");
+    BVH::BuildSettings settings{};
+    settings.maxLeafSize = 2;
+
+    WHEN("the mesh is loaded once")
+    {
+      auto mesh = cache.Load(file, settings);
+
+      THEN("it is built from the file and stored")
+      {
+        CHECK(cache.GetMissCount() == 1);
+        CHECK(cache.GetHitCount() == 0);
+        CHECK(mesh->GetTriangleCount() == 800);
+        CHECK(std::filesystem::exists(cache.GetEntryPath(file, settings)));
+      }
+    }
+    WHEN("it is loaded again, by another cache over the same directory")
+    {
+      auto built = cache.Load(file, settings);
+      MeshCache other(directory / "cache");
+      auto loaded = other.Load(file, settings);
+
+      THEN("it is read back exactly as it was built")
+      {
+        CHECK(other.GetHitCount() == 1);
+        CHECK(other.GetMissCount() == 0);
+        CHECK(loaded->GetVertices() == built->GetVertices());
+        CHECK(loaded->GetIndices() == built->GetIndices());
+        CHECK(SameNodes(loaded->GetBVH(), built->GetBVH()));
+        CHECK(loaded->GetBVH().GetSAHCost() == built->GetBVH().GetSAHCost());
+        CHECK(loaded->Bounds().min == built->Bounds().min);
+        CHECK(loaded->Bounds().max == built->Bounds().max);
+
+        auto r = Ray{ Point(7.3, 11.6, -5), Vector(0, 0, 1) };
+        auto expected = built->IntersectClosest(r, 0, INFINITY);
+        auto hit = loaded->IntersectClosest(r, 0, INFINITY);
+        REQUIRE(hit.has_value());
+        CHECK(hit->t == expected->t);
+        CHECK(hit->primitive == expected->primitive);
+      }
+    }
+    WHEN("the settings change, the file changes or the entry is damaged")
+    {
+      cache.Load(file, settings);
+      auto wider = settings;
+      wider.width = 4;
+      cache.Load(file, wider);
+      const auto hits = cache.GetHitCount();
+
+      auto median = settings;
+      median.splitMethod = BVH::SplitMethod::Median;
+      cache.Load(file, median);
+      const auto afterMedian = cache.GetMissCount();
+
+      const auto entry = cache.GetEntryPath(file, settings);
+      std::filesystem::resize_file(entry, 100);
+      auto rebuilt = cache.Load(file, settings);
+      const auto afterDamage = cache.GetMissCount();
+
+      WriteGrid(file, 20, 3);
+      auto moved = cache.Load(file, settings);
+
+      THEN("only the width is shared; everything else is built again")
+      {
+        CHECK(hits == 1);
+        CHECK(afterMedian == 2);
+        CHECK(afterDamage == 3);
+        CHECK(rebuilt->GetTriangleCount() == 800);
+        CHECK(cache.GetMissCount() == 4);
+        CHECK(moved->Bounds().min.z == 3);
+        CHECK(cache.GetEntryPath(file, settings) != entry);
+      }
+    }
+  }
+}
@@ -327,3 +327,53 @@ SCENARIO("Faces with normals")
     }
   }
 }
+
+SCENARIO("Converting an OBJ file to a triangle mesh")
+{
+  GIVEN("file = the file 'triangles.obj'\
+  \n\t  And parser = parse_obj_file(file)")
+  {
+    auto filePath = GetTestAssetsAbsolutePath().append("Triangles.obj");
+    auto file = OBJFile(filePath.string().c_str());
+    OBJParser parser(file);
+
+    WHEN("mesh = parser.mesh\
+    \n\t  And first = the mesh of 'FirstGroup'")
+    {
+      auto mesh = parser.GetMesh();
+      auto first = parser.GetMeshByName("FirstGroup");
+
+      THEN("mesh holds the faces of both groups over the parser's vertices\
+      \n\t  And first holds the face of 'FirstGroup'")
+      {
+        REQUIRE(mesh != nullptr);
+        CHECK(mesh->GetTriangleCount() == 2);
+        CHECK(mesh->GetVertices() == parser.GetVertices());
+        CHECK_FALSE(mesh->IsSmooth());
+        REQUIRE(first != nullptr);
+        REQUIRE(first->GetTriangleCount() == 1);
+        CHECK(first->GetIndices() == std::vector<std::uint32_t>{ 1, 2, 3 });
+        CHECK(parser.GetMeshByName("ThirdGroup") == nullptr);
+      }
+    }
+  }
+  GIVEN("file = the file 'facesWithNormals.obj'\
+  \n\t  And parser = parse_obj_file(file)")
+  {
+    auto filePath = GetTestAssetsAbsolutePath().append("FacesWithNormals.obj");
+    auto file = OBJFile(filePath.string().c_str());
+    OBJParser parser(file);
+
+    WHEN("mesh = parser.mesh")
+    {
+      auto mesh = parser.GetMesh();
+      THEN("mesh is smooth and keeps the face's normal indices")
+      {
+        REQUIRE(mesh->GetTriangleCount() == 2);
+        CHECK(mesh->IsSmooth());
+        CHECK(mesh->GetNormalIndices() ==
+              std::vector<std::uint32_t>{ 3, 1, 2, 3, 1, 2 });
+      }
+    }
+  }
+}
@@ -0,0 +1,147 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Lighting;
+using namespace RayTracer::Rendering::Primitives;
+
+namespace {
+
+/// @brief Eight rays from around (0, 0, -5) fanning across [-2, 2] in x and y
+RayPacket<8> Fan()
+{
+  RayPacket<8> packet;
+  for (std::size_t i = 0; i < 8; ++i) {
+    const auto x = -2.0f + 4.0f * static_cast<float>(i) / 7.0f;
+    const auto y = 1.5f - 0.4f * static_cast<float>(i);
+    const auto origin = Point(0.1f, 0.05f * i, -5);
+    packet.Set(i, Ray{ origin, normalize(Point(x, y, 0) - origin) });
+  }
+  return packet;
+}
+
+} // namespace
+
+SCENARIO("Storing rays in a packet")
+{
+  GIVEN("packet = an empty packet of 4 rays")
+  {
+    RayPacket<4> packet;
+
+    WHEN("lanes 0 and 2 are set")
+    {
+      packet.Set(0, Ray{ Point(1, 2, 3), Vector(0, 0, 1) });
+      packet.Set(2, Ray{ Point(-1, 0, 5), Vector(1, 0, 0) });
+
+      THEN("only those lanes are active and they read back as set")
+      {
+        CHECK(packet.active == 0b0101);
+        CHECK(packet.Get(0).origin == Point(1, 2, 3));
+        CHECK(packet.Get(2).direction == Vector(1, 0, 0));
+
+        std::vector<std::size_t> lanes;
+        for_each_lane(packet.active,
+                      [&](std::size_t i) { lanes.push_back(i); });
+        CHECK(lanes == std::vector<std::size_t>{ 0, 2 });
+      }
+    }
+    WHEN("the packet is transformed by translation(3, 4, 5)")
+    {
+      packet.Set(1, Ray{ Point(1, 2, 3), Vector(0, 1, 0) });
+      const auto moved = transform(packet, translation(3, 4, 5));
+
+      THEN("each lane moves as transform() moves its ray")
+      {
+        CHECK(moved.active == packet.active);
+        CHECK(moved.Get(1).origin == Point(4, 6, 8));
+        CHECK(moved.Get(1).direction == Vector(0, 1, 0));
+      }
+    }
+  }
+}
+
+SCENARIO("Intersecting a packet with the primitive kernels")
+{
+  GIVEN("packet = eight rays fanning out toward the origin")
+  {
+    const auto packet = Fan();
+
+    THEN("every lane agrees with the scalar kernel for its ray")
+    {
+      float t1[8];
+      float t2[8];
+      float t3[8];
+      const auto spheres = Sphere::Solve(packet, t1, t2);
+      for (std::size_t i = 0; i < 8; ++i) {
+        float s1 = 0.0f;
+        float s2 = 0.0f;
+        const auto hit = Sphere::Solve(packet.Get(i), s1, s2);
+        REQUIRE(hit == ((spheres >> i) & 1));
+        if (hit) {
+          CHECK(t1[i] == doctest::Approx(s1));
+          CHECK(t2[i] == doctest::Approx(s2));
+        }
+      }
+
+      const auto cubes = Cube::Solve(packet, t1, t2);
+      for (std::size_t i = 0; i < 8; ++i) {
+        float s1 = 0.0f;
+        float s2 = 0.0f;
+        const auto hit = Cube::Solve(packet.Get(i), s1, s2);
+        REQUIRE(hit == ((cubes >> i) & 1));
+        if (hit) {
+          CHECK(t1[i] == doctest::Approx(s1));
+          CHECK(t2[i] == doctest::Approx(s2));
+        }
+      }
+
+      const auto tilted = transform(packet, rotation_x(PI / 2));
+      const auto planes = Plane::Solve(tilted, t1);
+      for (std::size_t i = 0; i < 8; ++i) {
+        float s = 0.0f;
+        const auto hit = Plane::Solve(tilted.Get(i), s);
+        REQUIRE(hit == ((planes >> i) & 1));
+        if (hit) {
+          CHECK(t1[i] == doctest::Approx(s));
+        }
+      }
+
+      const auto p1 = Point(0, 1, 0);
+      const auto e1 = Point(-1, 0, 0) - p1;
+      const auto e2 = Point(1, 0, 0) - p1;
+      const auto triangles = Triangle::Solve(p1, e1, e2, packet, t1, t2, t3);
+      for (std::size_t i = 0; i < 8; ++i) {
+        float t = 0.0f;
+        float u = 0.0f;
+        float v = 0.0f;
+        const auto hit = Triangle::Solve(p1, e1, e2, packet.Get(i), t, u, v);
+        REQUIRE(hit == ((triangles >> i) & 1));
+        if (hit) {
+          CHECK(t1[i] == doctest::Approx(t));
+          CHECK(t2[i] == doctest::Approx(u));
+          CHECK(t3[i] == doctest::Approx(v));
+        }
+      }
+
+      CHECK(spheres != 0);
+      CHECK(spheres != RayPacket<8>::AllLanes);
+      CHECK(triangles != 0);
+    }
+  }
+  GIVEN("packet = the same rays with lanes 1 and 4 inactive")
+  {
+    auto packet = Fan();
+    packet.active &= ~LaneMask{ 0b10010 };
+
+    THEN("no kernel reports a hit in an inactive lane")
+    {
+      float t1[8];
+      float t2[8];
+      CHECK((Sphere::Solve(packet, t1, t2) & 0b10010) == 0);
+      CHECK((Cube::Solve(packet, t1, t2) & 0b10010) == 0);
+    }
+  }
+}
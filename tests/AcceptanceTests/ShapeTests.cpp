@@ -38,6 +38,68 @@ SCENARIO("Changing a shape's transformation")
   }
 }
 
+SCENARIO("Changing a shape's transformation updates its cached inverse")
+{
+  GIVEN("s = shape() && t = scaling(1, 0.5, 1) * rotation_z(PI/5)")
+  {
+    auto s = TestShape();
+    auto t = scaling(1, 0.5, 1) * rotation_z(PI / 5);
+
+    WHEN("set_transform(s, t)")
+    {
+      s.SetTransform(t);
+
+      THEN("s.inverse_transform == inverse(t) &&\
+      \n s.normal_transform == transpose(inverse(t))")
+      {
+        CHECK(s.GetInverseTransform() == inverse(t));
+        CHECK(s.GetNormalTransform() == transpose(inverse(t)));
+      }
+    }
+  }
+}
+
+SCENARIO("Editing a shape's transformation in place updates its cached inverse")
+{
+  GIVEN("s = shape()")
+  {
+    auto s = TestShape();
+
+    WHEN("s.transform = translation(2, 3, 4) && s.transform[0][0] = 2")
+    {
+      s.SetTransform() = translation(2, 3, 4);
+      s.SetTransform()[0][0] = 2;
+
+      THEN("s.inverse_transform == inverse(s.transform)")
+      {
+        auto t = translation(2, 3, 4);
+        t[0][0] = 2;
+        CHECK(s.GetTransform() == t);
+        CHECK(s.GetInverseTransform() == inverse(t));
+        CHECK(s.GetNormalTransform() == transpose(inverse(t)));
+      }
+    }
+  }
+}
+
+SCENARIO("Editing a shape's transformation in place rejects a singular one")
+{
+  GIVEN("s = shape() with transform = translation(2, 3, 4)")
+  {
+    auto s = TestShape();
+    s.SetTransform(translation(2, 3, 4));
+
+    THEN("s.transform[0][0] = 0 throws, and s keeps its transform")
+    {
+      CHECK_THROWS_AS(s.SetTransform()[0][0] = 0, std::runtime_error);
+      CHECK_THROWS_AS(s.SetTransform() *= scaling(1, 0, 1),
+                      std::runtime_error);
+      CHECK(s.GetTransform() == translation(2, 3, 4));
+      CHECK(s.GetInverseTransform() == inverse(translation(2, 3, 4)));
+    }
+  }
+}
+
 SCENARIO("A shape has a default material")
 {
   GIVEN("s = shape()")
@@ -24,9 +24,13 @@ protected:
     return Vector(point.x, point.y, point.z);
   }
 
-  Intersections GetLocalIntersect(const Ray& r) const override
+  void GetLocalIntersect(const Ray& r, Intersections&) const override
   {
     saved_ray = r;
-    return {};
+  }
+
+  BoundingBox GetLocalBounds() const override
+  {
+    return { Point(-1, -1, -1), Point(1, 1, 1) };
   }
 };
@@ -0,0 +1,68 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Cameras;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Scene;
+
+/// @brief default_world() over a reflective floor, with a glass sphere
+inline World GlassWorld()
+{
+  auto w = default_world();
+
+  auto floor = std::make_shared<Plane>();
+  floor->SetTransform(translation(0, -1, 0));
+  floor->SetMaterial().reflective = 0.5f;
+  w.AddObject(floor);
+
+  auto glass = std::make_shared<Sphere>(GlassSphere());
+  glass->SetTransform(translation(-1.5f, 0, -1.5f) * scaling(0.5f, 0.5f, 0.5f));
+  glass->SetMaterial().reflective = 0.9f;
+  w.AddObject(glass);
+  return w;
+}
+
+/// @brief A camera looking down at GlassWorld() from the front left
+inline Camera LookingDown(float hsize, float vsize)
+{
+  auto c = Camera{ hsize, vsize, PI / 3 };
+  c.transform = view_transform(
+    Point(-2.0f, 2.5f, -6.0f), Point(0.0f, 0.0f, 0.0f), Vector(0, 1, 0));
+  return c;
+}
+
+/// @brief The book's shade_hit() world for transparent materials:
+/// default_world() over a glass floor, with a red ball under it
+inline World GlassFloorWorld(float reflective)
+{
+  auto w = default_world();
+
+  auto floor = std::make_shared<Plane>();
+  floor->SetTransform(translation(0, -1, 0));
+  floor->SetMaterial().reflective = reflective;
+  floor->SetMaterial().transparency = 0.5f;
+  floor->SetMaterial().refractiveIndex = 1.5f;
+  w.AddObject(floor);
+
+  auto ball = std::make_shared<Sphere>();
+  ball->SetTransform(translation(0, -3.5f, -0.5f));
+  ball->SetMaterial().color = Color{ 1, 0, 0 };
+  ball->SetMaterial().ambient = 0.5f;
+  w.AddObject(ball);
+  return w;
+}
+
+/// @brief A one-pixel camera whose only ray is the book's
+/// ray(point(0, 0, -3), vector(0, -SQRT(2)/2, SQRT(2)/2)) into
+/// GlassFloorWorld()
+inline Camera ThroughGlassFloor()
+{
+  auto c = Camera{ 1, 1, PI / 2 };
+  c.transform = view_transform(
+    Point(0.0f, 0.0f, -3.0f), Point(0.0f, -1.0f, -2.0f), Vector(0, 1, 0));
+  return c;
+}
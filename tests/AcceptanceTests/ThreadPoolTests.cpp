@@ -0,0 +1,61 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Core;
+
+SCENARIO("Running a loop on a thread pool")
+{
+  GIVEN("pool = thread_pool(4)")
+  {
+    ThreadPool pool(4);
+
+    WHEN("two loops of 1000 items each count their calls")
+    {
+      std::vector<std::atomic<int>> calls(1000);
+      for (int loop = 0; loop < 2; ++loop) {
+        pool.ParallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+      }
+
+      THEN("every item ran once per loop, on the same threads")
+      {
+        CHECK(pool.GetThreadCount() == 4);
+        CHECK(std::all_of(calls.begin(), calls.end(), [](const auto& n) {
+          return n.load() == 2;
+        }));
+      }
+    }
+    WHEN("a loop is run from inside another")
+    {
+      std::atomic<int> calls{ 0 };
+      pool.ParallelFor(8, [&](std::size_t) {
+        pool.ParallelFor(8, [&](std::size_t) { ++calls; });
+      });
+
+      THEN("the inner loops run on their callers")
+      {
+        CHECK(calls.load() == 64);
+      }
+    }
+    WHEN("an item throws")
+    {
+      std::atomic<int> calls{ 0 };
+      auto loop = [&] {
+        pool.ParallelFor(100, [&](std::size_t i) {
+          ++calls;
+          if (i == 42) {
+            throw std::runtime_error("item 42");
+          }
+        });
+      };
+
+      THEN("the loop still runs every item, then rethrows")
+      {
+        CHECK_THROWS_AS(loop(), std::runtime_error);
+        CHECK(calls.load() == 100);
+      }
+    }
+  }
+}
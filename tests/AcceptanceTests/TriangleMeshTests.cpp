@@ -0,0 +1,174 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Primitives;
+
+namespace {
+
+/// @brief n x n unit squares in the z = 0 plane, two triangles each
+std::shared_ptr<TriangleMesh> Grid(int n)
+{
+  std::vector<Tuple> vertices;
+  for (int y = 0; y <= n; ++y) {
+    for (int x = 0; x <= n; ++x) {
+      vertices.push_back(Point(x, y, 0));
+    }
+  }
+  std::vector<std::uint32_t> indices;
+  for (int y = 0; y < n; ++y) {
+    for (int x = 0; x < n; ++x) {
+      const auto corner = static_cast<std::uint32_t>(y * (n + 1) + x);
+      const auto above = corner + n + 1;
+      indices.insert(indices.end(), { corner, corner + 1, above + 1 });
+      indices.insert(indices.end(), { corner, above + 1, above });
+    }
+  }
+  return std::make_shared<TriangleMesh>(std::move(vertices),
+                                        std::move(indices));
+}
+
+} // namespace
+
+SCENARIO("Constructing a triangle mesh")
+{
+  GIVEN("mesh = a 10 x 10 grid of squares, two triangles per square")
+  {
+    auto mesh = Grid(10);
+    THEN("it holds 200 flat triangles over 121 shared vertices")
+    {
+      CHECK(mesh->GetTriangleCount() == 200);
+      CHECK(mesh->GetVertices().size() == 121);
+      CHECK(mesh->GetIndices().size() == 600);
+      CHECK_FALSE(mesh->IsSmooth());
+      CHECK(mesh->Bounds().min == Point(0, 0, 0));
+      CHECK(mesh->Bounds().max == Point(10, 10, 0));
+    }
+  }
+}
+
+SCENARIO("Intersecting a ray with a triangle mesh")
+{
+  GIVEN("mesh = a 10 x 10 grid of squares\
+  \n\t  And mesh has a transform of translation(0, 0, 5)")
+  {
+    auto mesh = Grid(10);
+    mesh->SetTransform(translation(0, 0, 5));
+
+    WHEN("r = ray(point(2.7, 6.2, 0), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(2.7, 6.2, 0), Vector(0, 0, 1) };
+      auto xs = mesh->Intersect(r);
+
+      THEN("it hits the triangle under (2.7, 6.2) at t = 5")
+      {
+        REQUIRE(xs.Count() == 1);
+        CHECK(xs[0].t == doctest::Approx(5));
+        CHECK(xs[0].object == mesh.get());
+
+        const auto& indices = mesh->GetIndices();
+        const auto& vertices = mesh->GetVertices();
+        auto triangle = Triangle(vertices[indices[3 * xs[0].primitive]],
+                                 vertices[indices[3 * xs[0].primitive + 1]],
+                                 vertices[indices[3 * xs[0].primitive + 2]]);
+        CHECK(triangle.Intersect(Ray{ Point(2.7, 6.2, -5), Vector(0, 0, 1) })
+                .Count() == 1);
+        CHECK(mesh->GetNormalAt(Point(2.7, 6.2, 5), &xs[0]) ==
+              Vector(0, 0, -1));
+      }
+      THEN("the closest-hit and any-hit queries agree")
+      {
+        auto closest = mesh->IntersectClosest(r, 0, INFINITY);
+        REQUIRE(closest.has_value());
+        CHECK(*closest == xs[0]);
+        CHECK(mesh->Occluded(r, 0, INFINITY));
+        CHECK_FALSE(mesh->Occluded(r, 0, 4.9f));
+      }
+    }
+    WHEN("r = ray(point(12, 6, 0), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(12, 6, 0), Vector(0, 0, 1) };
+      THEN("it misses")
+      {
+        CHECK(mesh->Intersect(r).Count() == 0);
+        CHECK_FALSE(mesh->IntersectClosest(r, 0, INFINITY).has_value());
+      }
+    }
+  }
+}
+
+SCENARIO("A smooth triangle mesh interpolates its vertex normals")
+{
+  GIVEN("mesh = one triangle with the points and normals of a smooth_triangle\
+  \n\t  And tri = the equivalent smooth_triangle")
+  {
+    auto p1 = Point(0, 1, 0);
+    auto p2 = Point(-1, 0, 0);
+    auto p3 = Point(1, 0, 0);
+    auto n1 = Vector(0, 1, 0);
+    auto n2 = Vector(-1, 0, 0);
+    auto n3 = Vector(1, 0, 0);
+    auto mesh = std::make_shared<TriangleMesh>(
+      std::vector<Tuple>{ p1, p2, p3 },
+      std::vector<std::uint32_t>{ 0, 1, 2 },
+      std::vector<Tuple>{ n1, n2, n3 },
+      std::vector<std::uint32_t>{ 0, 1, 2 });
+    auto tri = SmoothTriangle(p1, p2, p3, n1, n2, n3);
+
+    WHEN("r = ray(point(-0.2, 0.3, -2), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(-0.2, 0.3, -2), Vector(0, 0, 1) };
+      auto xs = mesh->Intersect(r);
+      auto expected = tri.Intersect(r);
+
+      THEN("u, v and the normal match the smooth triangle's")
+      {
+        REQUIRE(xs.Count() == 1);
+        CHECK(mesh->IsSmooth());
+        CHECK(xs[0].u == expected[0].u);
+        CHECK(xs[0].v == expected[0].v);
+        CHECK(mesh->GetNormalAt(Point(0, 0, 0), &xs[0]) ==
+              tri.GetNormalAt(Point(0, 0, 0), &expected[0]));
+      }
+    }
+  }
+}
+
+SCENARIO("A triangle mesh traverses the hierarchy its build settings select")
+{
+  GIVEN("mesh = a 16 x 16 grid of squares")
+  {
+    auto mesh = Grid(16);
+    const Ray rays[] = {
+      { Point(0.25, 0.75, -1), Vector(0, 0, 1) },
+      { Point(15.5, 3.2, 1), Vector(0, 0, -1) },
+      { Point(-1, -1, -1), normalize(Vector(5, 7, 1)) },
+    };
+    std::vector<std::optional<Intersection>> binary;
+    for (const auto& r : rays) {
+      binary.push_back(mesh->IntersectClosest(r, 0, INFINITY));
+    }
+
+    WHEN("its width is set to 4, then 8")
+    {
+      THEN("the closest hits agree with the binary hierarchy")
+      {
+        for (std::uint32_t width : { 4u, 8u }) {
+          RayTracer::Rendering::Acceleration::BVH::BuildSettings settings{};
+          settings.width = width;
+          mesh->SetBuildSettings(settings);
+          for (std::size_t i = 0; i < std::size(rays); ++i) {
+            auto closest = mesh->IntersectClosest(rays[i], 0, INFINITY);
+            REQUIRE(closest.has_value() == binary[i].has_value());
+            if (closest) {
+              CHECK(closest->t == binary[i]->t);
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -323,3 +323,32 @@ SCENARIO("Reflecting a vector off a slanted surface")
     }
   }
 }
+
+SCENARIO("The cross product of two points is a vector")
+{
+  GIVEN("a = point(1, 2, 3) && b = point(2, 3, 4)")
+  {
+    auto a = Point(1, 2, 3);
+    auto b = Point(2, 3, 4);
+
+    THEN("cross(a, b) == vector(-1, 2, -1) && isVector(cross(a, b))")
+    {
+      CHECK(cross(a, b) == Vector(-1, 2, -1));
+      CHECK(isVector(cross(a, b)));
+    }
+  }
+}
+
+SCENARIO("Negating a zero vector keeps the sign of zero")
+{
+  GIVEN("v = vector(0, 1, 0)")
+  {
+    auto v = Vector(0, 1, 0);
+
+    THEN("-v has a negative zero x component")
+    {
+      CHECK(std::signbit((-v).x));
+      CHECK(-v == Vector(0, -1, 0));
+    }
+  }
+}
@@ -0,0 +1,110 @@
+// Test Framework
+#include "doctest/doctest.h"
+
+// Engine
+#include "RayTracer.hpp"
+#include "TestWorlds.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Cameras;
+using namespace RayTracer::Rendering::Scene;
+
+SCENARIO("Rendering breadth-first")
+{
+  GIVEN("w = default_world() over a reflective floor, with a glass sphere &&\
+    \n c = camera(40, 30, PI/3), looking down at it")
+  {
+    auto w = GlassWorld();
+    const auto c = LookingDown(40, 30);
+    RayTracer::Core::ThreadPool pool(3);
+
+    WHEN("image = a wavefront render of w, in batches of 2 tiles")
+    {
+      WavefrontRenderer renderer({ 2, 5 });
+      const auto image = renderer.Render(c, w, pool);
+      const auto& stats = renderer.GetStats();
+
+      THEN("every pixel is the one render() gives")
+      {
+        const auto expected = render(c, w, pool);
+        int mismatches = 0;
+        for (int y = 0; y < 30; ++y) {
+          for (int x = 0; x < 40; ++x) {
+            if (!(pixel_at(image, x, y) == pixel_at(expected, x, y))) {
+              ++mismatches;
+            }
+          }
+        }
+        CHECK(mismatches == 0);
+      }
+      THEN("the stages account for every ray they queued")
+      {
+        CHECK(stats.primaryRays == 40 * 30);
+        REQUIRE(!stats.raysPerBounce.empty());
+        CHECK(stats.raysPerBounce.front() == 40 * 30);
+        CHECK(stats.raysPerBounce.size() <= 6);
+
+        std::size_t traced = 0;
+        for (auto count : stats.raysPerBounce) {
+          traced += count;
+        }
+        CHECK(traced == stats.primaryRays + stats.reflectionRays +
+                          stats.refractionRays);
+        CHECK(stats.shadowRays == stats.hits);
+        CHECK(stats.reflectionRays > 0);
+        CHECK(stats.refractionRays > 0);
+        CHECK(stats.peakRayQueue >= 2 * TileSize * TileSize);
+        CHECK(stats.peakShadowQueue <= stats.peakRayQueue);
+      }
+    }
+    WHEN("it is rendered with a depth of 0")
+    {
+      WavefrontRenderer renderer({ 16, 0 });
+      renderer.Render(c, w, pool);
+      const auto& stats = renderer.GetStats();
+
+      THEN("only the primary rays are traced")
+      {
+        CHECK(stats.raysPerBounce == std::vector<std::size_t>{ 40 * 30 });
+        CHECK(stats.reflectionRays == 0);
+        CHECK(stats.refractionRays == 0);
+        CHECK(stats.shadowRays == stats.hits);
+      }
+    }
+  }
+}
+
+SCENARIO("Rendering transparent surfaces breadth-first")
+{
+  GIVEN("w = default_world() over a glass floor, with a red ball under it &&\
+    \n c = a 1x1 camera whose ray is\
+    \n ray(point(0, 0, -3), vector(0, -SQRT(2)/2, SQRT(2)/2))")
+  {
+    const auto c = ThroughGlassFloor();
+    RayTracer::Core::ThreadPool pool(1);
+    WavefrontRenderer renderer({ 1, 5 });
+
+    WHEN("the floor is transparent")
+    {
+      auto w = GlassFloorWorld(0.0f);
+      const auto image = renderer.Render(c, w, pool);
+
+      THEN("pixel_at(image, 0, 0) == color(0.93642, 0.68642, 0.68642)")
+      {
+        CHECK(pixel_at(image, 0, 0) == Color{ 0.93642f, 0.68642f, 0.68642f });
+        CHECK(renderer.GetStats().refractionRays > 0);
+      }
+    }
+    WHEN("the floor is also reflective")
+    {
+      auto w = GlassFloorWorld(0.5f);
+      const auto image = renderer.Render(c, w, pool);
+
+      THEN("pixel_at(image, 0, 0) == color(0.93391, 0.69643, 0.69243)")
+      {
+        CHECK(pixel_at(image, 0, 0) == Color{ 0.93391f, 0.69643f, 0.69243f });
+        CHECK(renderer.GetStats().reflectionRays > 0);
+      }
+    }
+  }
+}
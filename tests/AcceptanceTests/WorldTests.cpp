@@ -84,6 +84,231 @@ SCENARIO("Intersect a world with a ray")
   }
 }
 
+SCENARIO("Intersecting a world through its top-level hierarchy")
+{
+  GIVEN("w = world() with a 10 x 10 grid of spheres\
+    \n AND floor = plane() with transform translation(0, -1, 0)\
+    \n AND floor is added to w")
+  {
+    auto w = World();
+    for (int i = 0; i < 100; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation((i % 10) * 3.0f, 0, (i / 10) * 3.0f));
+      w.AddObject(s);
+    }
+    auto floor = std::make_shared<Plane>();
+    floor->SetTransform(translation(0, -1, 0));
+    w.AddObject(floor);
+
+    WHEN("r = ray(point(6, 5, -5), vector(0, -1, 1) normalized)\
+      \n AND xs = intersect_world(w, r)")
+    {
+      auto r = Ray{ Point(6, 5, -5), normalize(Vector(0, -1, 1)) };
+      auto xs = intersect_world(w, r);
+
+      THEN("the floor sits outside the hierarchy\
+            \n AND xs matches intersecting every object in turn")
+      {
+        CHECK(w.GetTopLevel().GetUnboundedCount() == 1);
+        CHECK(w.GetTopLevel().GetBVH(w.GetObjects()).GetNodes().size() > 1);
+
+        Intersections expected;
+        for (const auto& object : w.GetObjects()) {
+          const auto objectXS = object->Intersect(r);
+          for (const auto& i : objectXS.GetIntersectionPoints()) {
+            expected.Add(i);
+          }
+        }
+        expected.Sort();
+        REQUIRE(xs.Count() == expected.Count());
+        for (std::size_t i = 0; i < xs.Count(); ++i) {
+          CHECK(xs[i] == expected[i]);
+        }
+      }
+    }
+
+    WHEN("the first sphere is moved after a first query")
+    {
+      auto first = w.GetObjects().front();
+      auto r = Ray{ Point(100, 0, -5), Vector(0, 0, 1) };
+      CHECK(intersect_world(w, r).Count() == 0);
+      first->SetTransform(translation(100, 0, 0));
+      THEN("the next query finds it at its new place")
+      {
+        auto xs = intersect_world(w, r);
+        CHECK(xs.Count() == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("Refitting a world after its objects moved")
+{
+  GIVEN("w = world() with a 10 x 10 grid of spheres, committed")
+  {
+    auto w = World();
+    for (int i = 0; i < 100; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation((i % 10) * 3.0f, 0, (i / 10) * 3.0f));
+      w.AddObject(s);
+    }
+    w.Commit();
+    // the const overload, as the mutable one invalidates the hierarchy
+    const auto& objects = std::as_const(w).GetObjects();
+    const auto& topLevel = w.GetTopLevel();
+    REQUIRE(topLevel.GetBuildCount() == 1);
+
+    WHEN("every sphere rises by 2 and w is refitted")
+    {
+      for (int i = 0; i < 100; ++i) {
+        objects[i]->SetTransform(
+          translation((i % 10) * 3.0f, 2, (i / 10) * 3.0f));
+      }
+      w.Refit();
+
+      THEN("the hierarchy was refitted, not rebuilt\
+      \n AND rays find the spheres at their new height")
+      {
+        CHECK(topLevel.GetBuildCount() == 1);
+        CHECK(topLevel.GetRefitCount() == 1);
+        auto hit = w.IntersectClosest(Ray{ Point(9, 2, -5), Vector(0, 0, 1) });
+        REQUIRE(hit.has_value());
+        CHECK(hit->t == doctest::Approx(4));
+        CHECK_FALSE(w.Occluded(Ray{ Point(9, 0, -5), Vector(0, 0, 1) }, 50));
+      }
+    }
+    WHEN("the spheres are scattered far apart and w is refitted")
+    {
+      for (int i = 0; i < 100; ++i) {
+        const auto shift = static_cast<float>((i * 37) % 100) * 10.0f;
+        objects[i]->SetTransform(translation(shift, -shift, shift));
+      }
+      w.Refit();
+
+      THEN("the degraded hierarchy was rebuilt instead")
+      {
+        CHECK(topLevel.GetBuildCount() == 2);
+        auto hit =
+          w.IntersectClosest(Ray{ Point(370, -370, 300), Vector(0, 0, 1) });
+        REQUIRE(hit.has_value());
+        CHECK(hit->t == doctest::Approx(69));
+      }
+    }
+  }
+}
+
+SCENARIO("Finding the closest hit in a world")
+{
+  GIVEN("w = world() with a row of spheres, a cube and a triangle\
+    \n AND floor = plane() with transform translation(0, -1, 0)")
+  {
+    auto w = World();
+    for (int i = 0; i < 10; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation(0, 0, i * 3.0f));
+      w.AddObject(s);
+    }
+    auto cube = std::make_shared<Cube>();
+    cube->SetTransform(translation(0, 0, -4) * scaling(0.5, 0.5, 0.5));
+    w.AddObject(cube);
+    w.AddObject(std::make_shared<Triangle>(
+      Point(-1, -1, 40), Point(1, -1, 40), Point(0, 1, 40)));
+    auto floor = std::make_shared<Plane>();
+    floor->SetTransform(translation(0, -1, 0));
+    w.AddObject(floor);
+
+    WHEN("rays are cast from inside, in front of and beside the objects")
+    {
+      const Ray rays[] = {
+        { Point(0, 0, -10), Vector(0, 0, 1) },
+        { Point(0, 0, 0), Vector(0, 0, 1) },
+        { Point(0, 0, 5), Vector(0, 0, -1) },
+        { Point(0, 5, -10), normalize(Vector(0, -1, 2)) },
+        { Point(0, 0, 31), Vector(0, 0, 1) },
+        { Point(5, 5, 5), Vector(1, 0, 0) },
+      };
+
+      THEN("IntersectClosest() agrees with hit(intersect_world(w, r))")
+      {
+        for (const auto& r : rays) {
+          const auto xs = intersect_world(w, r);
+          const auto* expected = xs.Hit();
+          const auto closest = w.IntersectClosest(r);
+          REQUIRE(closest.has_value() == (expected != nullptr));
+          if (expected) {
+            CHECK(*closest == *expected);
+          }
+        }
+      }
+    }
+
+    WHEN("r = ray(point(0, 0, -10), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(0, 0, -10), Vector(0, 0, 1) };
+
+      THEN("hits at or beyond tmax are rejected\
+            \n AND hits before tmin are skipped")
+      {
+        CHECK_FALSE(w.IntersectClosest(r, 0, 5.5f).has_value());
+        CHECK(w.IntersectClosest(r, 0, 5.6f)->t == doctest::Approx(5.5f));
+        CHECK(w.IntersectClosest(r, 6.0f, INFINITY)->t ==
+              doctest::Approx(6.5f));
+        CHECK(w.IntersectClosest(r, 7.0f, INFINITY)->t == doctest::Approx(9));
+      }
+    }
+  }
+}
+
+SCENARIO("Tracing rays through a committed world allocates nothing")
+{
+  GIVEN("w = default_world()\
+    \n AND g = group() of 64 spheres And a cube behind the default spheres\
+    \n AND floor = plane() with transform translation(0, -1, 0)")
+  {
+    auto w = default_world();
+    auto g = std::make_shared<Group>();
+    for (int i = 0; i < 64; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation((i % 8) - 3.5f, (i / 8) - 3.5f, 6) *
+                      scaling(0.4f, 0.4f, 0.4f));
+      g->AddChild(s);
+    }
+    w.AddObject(g);
+    auto cube = std::make_shared<Cube>();
+    cube->SetTransform(translation(0, 0, 10) * scaling(10, 10, 0.5f));
+    w.AddObject(cube);
+    auto floor = std::make_shared<Plane>();
+    floor->SetTransform(translation(0, -1, 0));
+    w.AddObject(floor);
+    w.Commit();
+
+    WHEN("a fan of rays is traced with color_at and intersect_world")
+    {
+      Intersections xs;
+      xs.Reserve(4 * Intersections::InlineCapacity);
+
+      TrackNew::reset();
+      auto hits = 0;
+      for (int i = 0; i < 64; ++i) {
+        const auto r = Ray{ Point(0, 0, -5),
+                            normalize(Vector((i % 8) * 0.1f - 0.35f,
+                                             (i / 8) * 0.1f - 0.35f,
+                                             1)) };
+        color_at(w, r);
+        intersect_world(w, r, xs);
+        hits += xs.Hit() != nullptr ? 1 : 0;
+      }
+      const auto allocations = TrackNew::getStatus().mallocNum;
+
+      THEN("no ray touched the heap")
+      {
+        CHECK(hits == 64);
+        CHECK(allocations == 0);
+      }
+    }
+  }
+}
+
 SCENARIO("Shading an intersection")
 {
   GIVEN("w = default_world() &&\
@@ -248,6 +473,59 @@ SCENARIO("There is no shadow when an object is behind the point")
   }
 }
 
+SCENARIO("Occlusion stops at the given distance")
+{
+  GIVEN("w = default_world()\
+    \n AND g = group() of a 10 x 10 grid of spheres behind it\
+    \n AND floor = plane() with transform translation(0, -1, 0)")
+  {
+    auto w = default_world();
+    auto g = std::make_shared<Group>();
+    for (int i = 0; i < 100; ++i) {
+      auto s = std::make_shared<Sphere>();
+      s->SetTransform(translation((i % 10) * 3.0f, (i / 10) * 3.0f, 10));
+      g->AddChild(s);
+    }
+    w.AddObject(g);
+    auto floor = std::make_shared<Plane>();
+    floor->SetTransform(translation(0, -1, 0));
+    w.AddObject(floor);
+
+    WHEN("r = ray(point(0, 0, -5), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(0, 0, -5), Vector(0, 0, 1) };
+
+      THEN("only blockers with t < maxDistance count")
+      {
+        CHECK_FALSE(w.Occluded(r, 4));
+        CHECK(w.Occluded(r, 4.001f));
+      }
+    }
+
+    WHEN("r = ray(point(9, 9, 0), vector(0, 0, 1))")
+    {
+      auto r = Ray{ Point(9, 9, 0), Vector(0, 0, 1) };
+
+      THEN("the blocker is found inside the group")
+      {
+        CHECK_FALSE(w.Occluded(r, 9));
+        CHECK(w.Occluded(r, 9.5f));
+      }
+    }
+
+    WHEN("r = ray(point(1.5, 5, 0), normalize(vector(0, -1, 0.1)))")
+    {
+      auto r = Ray{ Point(1.5, 5, 0), normalize(Vector(0, -1, 0.1f)) };
+
+      THEN("the floor outside the hierarchy blocks it")
+      {
+        CHECK_FALSE(w.Occluded(r, 5.9f));
+        CHECK(w.Occluded(r, 6.1f));
+      }
+    }
+  }
+}
+
 SCENARIO("shade_hit() is given an intersection in shadow")
 {
   GIVEN("w = world() &&\
@@ -520,132 +798,156 @@ public:
 };
 /// ---------------------------------------------------------------------------
 
-// SCENARIO("The refracted color with a refracted ray")
-// {
-//   GIVEN("w = default_world()\
-//   \n\t And A = the first object in w\
-//   \n\t And A has:\
-//   \n\t  | material.ambient | 1.0            |\
-//   \n\t  | material.pattern | test_pattern() |\
-//   \n\t And B = the second object in w\
-//   \n\t And B has:\
-//   \n\t  | material.transparency     | 1.0 |\
-//   \n\t  | material.refractive_index | 1.5 |\
-//   \n\t And r = ray(point(0, 0, 0.1), vector(0, 1, 0))\
-//   \n\t And xs = intersections(-0.9899:A, -0.4899:B, 0.4899:B, 0.9899:A)")
-//   {
-//     const auto w = default_world();
-//     Shape* A = w.GetObjects()[0].get();
-//     A->SetMaterial().ambient = 1.0;
-//     A->SetMaterial().pattern = std::make_shared<TestPattern>();
-//     Shape* B = w.GetObjects()[1].get();
-//     B->SetMaterial().transparency = 1.0;
-//     B->SetMaterial().refractiveIndex = 1.5;
-//     const auto r = Ray{ Point(0, 0, 0.1), Vector(0, 1, 0) };
-//     const auto xs = Intersections{
-//       { -0.9899, A }, { -0.4899, B }, { 0.4899, B }, { 0.9899, A }
-//     };
-
-//     WHEN("comps = prepare_computations(xs[2], r, xs) &&\
-//     \n\t And c = refracted_color(w, comps, 5)")
-//     {
-//       auto comps = prepare_computations(xs[2], r, &xs);
-//       auto c = refracted_color(w, comps, 5);
-
-//       THEN("c == color(0, 0.99888, 0.04725)")
-//       {
-//         CHECK(c == make_color(0, 0.99888, 0.04725));
-//       }
-//     }
-//   }
-// }
-
-// SCENARIO("shade_hit() with a transparent material")
-// {
-//   GIVEN("w = default_world()\
-//   \n\t And floor = plane() with:\
-//   \n\t  | transform                 | translation(0, -1, 0) |\
-//   \n\t  | material.transparency     | 0.5                   |\
-//   \n\t  | material.refractive_index | 1.5                   |\
-//   \n\t And floor is added to w\
-//   \n\t And ball = sphere() with:\
-//   \n\t  | material.color     | (1, 0, 0)                  |\
-//   \n\t  | material.ambient   | 0.5                        |\
-//   \n\t  | transform          | translation(0, -3.5, -0.5) |\
-//   \n\t And ball is added to w\
-//   \n\t And r = ray(point(0, 0, -3), vector(0, -SQRT(2)/2), SQRT(2)/2))\
-//   \n\t And xs = intersections(SQRT(2):floor)")
-//   {
-//     auto w = default_world();
-//     auto floor = std::make_shared<Plane>();
-//     floor->SetTransform(translation(0, -1, 0));
-//     floor->SetMaterial().transparency = 0.5;
-//     floor->SetMaterial().refractiveIndex = 1.5;
-//     w.AddObject(floor);
-//     auto ball = std::make_shared<Sphere>();
-//     ball->SetMaterial().color = make_color(1, 0, 0);
-//     ball->SetMaterial().ambient = 0.5;
-//     w.AddObject(ball);
-//     float sqrt2 = std::sqrt(2);
-//     auto r = Ray{ Point(0, 0, -3), Vector(0, -sqrt2 / 2, sqrt2 / 2)
-//     }; auto xs = Intersections{ { sqrt2, floor.get() } };
-
-//     WHEN("comps = prepare_computations(xs[0], r, xs)\
-//     \n\t And color = shade_hit(w, comps, 5)")
-//     {
-//       auto comps = prepare_computations(xs[0], r, &xs);
-//       auto c = shade_hit(w, comps, 5);
-//       THEN("c == color(0.93642, 0.68642, 0.68642)")
-//       {
-//         CHECK(c == make_color(0.93642, 0.68642, 0.68642));
-//       }
-//     }
-//   }
-// }
-
-// SCENARIO("shade_hit() with a reflective, transparent material")
-// {
-//   GIVEN("given w = default_world()\
-//   \n\t And r = ray(point(0, 0, -3), vector(0, -SQRT(2)/2, SQRT(2)/2))\
-//   \n\t And floor = plane() with:\
-//   \n\t  | transform                 | translation(0, -1, 0) |\
-//   \n\t  | material.reflective       | 0.5                   |\
-//   \n\t  | material.transparency     | 0.5                   |\
-//   \n\t  | material.refractive_index | 1.5                   |\
-//   \n\t And floor is added to w\
-//   \n\t And ball = sphere() with:\
-//   \n\t  | material.color    | (1, 0, 0)                  |\
-//   \n\t  | material.ambient  | 0.5                        |\
-//   \n\t  | transform         | translation(0, -3.5, -0.5) |\
-//   \n\t And ball is added to w\
-//   \n\t And xs = intersections(SQRT(2):floor)")
-//   {
-//     auto w = default_world();
-//     auto sqrt2 = static_cast<float>(std::sqrt(2));
-//     auto r = Ray{ Point(0, 0, -3), Vector(0, -sqrt2 / 2, sqrt2 / 2)
-//     }; auto floor = std::make_shared<Plane>();
-//     floor->SetTransform(translation(0, -1, 0));
-//     floor->SetMaterial().reflective = 0.5;
-//     floor->SetMaterial().transparency = 0.5;
-//     floor->SetMaterial().refractiveIndex = 1.5;
-//     w.AddObject(floor);
-//     auto ball = std::make_shared<Sphere>();
-//     ball->SetMaterial().color = make_color(1, 0, 0);
-//     ball->SetMaterial().ambient = 0.5;
-//     ball->SetTransform(translation(0, -3.5, -0.5));
-//     w.AddObject(ball);
-//     auto xs = Intersections{ { sqrt2, floor.get() } };
-
-//     WHEN("comps = prepare_computations(xs[0], r, xs)\
-//     \n\t And c = shade_hit(w, comps, 5)")
-//     {
-//       auto comps = prepare_computations(xs[0], r, &xs);
-//       auto c = shade_hit(w, comps, 5);
-
-//       THEN("c == color(0.93391, 0.69643, 0.69243)")
-//       {
-//         CHECK(c == make_color(0.93391, 0.69643, 0.69243));
-//       }
-//     }
-//   }
-// }
+SCENARIO("The refracted color with a refracted ray")
+{
+  GIVEN("w = default_world() &&\
+  \n A = the first object in w &&\
+  \n A has:\
+  \n | material.ambient | 1.0            |\
+  \n | material.pattern | test_pattern() |\
+  \n AND B = the second object in w &&\
+  \n B has:\
+  \n | material.transparency     | 1.0 |\
+  \n | material.refractive_index | 1.5 |\
+  \n AND r = ray(point(0, 0, 0.1), vector(0, 1, 0)) &&\
+  \n xs = intersections(-0.9899:A, -0.4899:B, 0.4899:B, 0.9899:A)")
+  {
+    const auto w = default_world();
+    Shape* A = w.GetObjects()[0].get();
+    A->SetMaterial().ambient = 1.0;
+    A->SetMaterial().pattern = std::make_shared<TestPattern>();
+    Shape* B = w.GetObjects()[1].get();
+    B->SetMaterial().transparency = 1.0;
+    B->SetMaterial().refractiveIndex = 1.5;
+    const auto r = Ray{ Point(0, 0, 0.1f), Vector(0, 1, 0) };
+    const auto xs = Intersections{
+      { -0.9899f, A }, { -0.4899f, B }, { 0.4899f, B }, { 0.9899f, A }
+    };
+
+    WHEN("comps = prepare_computations(xs[2], r, xs) &&\
+    \n c = refracted_color(w, comps, 5)")
+    {
+      std::vector<const Shape*> containers;
+      auto comps = prepare_computations(xs[2], r, &xs, &containers);
+      auto c = refracted_color(w, comps, 5);
+
+      THEN("c == color(0, 0.99888, 0.04725)")
+      {
+        CHECK(c == Color{ 0.0f, 0.99888f, 0.04725f });
+      }
+    }
+  }
+}
+
+SCENARIO("shade_hit() with a transparent material")
+{
+  GIVEN("w = default_world() &&\
+  \n floor = plane() with:\
+  \n | transform                 | translation(0, -1, 0) |\
+  \n | material.transparency     | 0.5                   |\
+  \n | material.refractive_index | 1.5                   |\
+  \n AND floor is added to w &&\
+  \n ball = sphere() with:\
+  \n | material.color     | (1, 0, 0)                  |\
+  \n | material.ambient   | 0.5                        |\
+  \n | transform          | translation(0, -3.5, -0.5) |\
+  \n AND ball is added to w &&\
+  \n r = ray(point(0, 0, -3), vector(0, -SQRT(2)/2, SQRT(2)/2)) &&\
+  \n xs = intersections(SQRT(2):floor)")
+  {
+    auto w = default_world();
+    auto floor = std::make_shared<Plane>();
+    floor->SetTransform(translation(0, -1, 0));
+    floor->SetMaterial().transparency = 0.5;
+    floor->SetMaterial().refractiveIndex = 1.5;
+    w.AddObject(floor);
+    auto ball = std::make_shared<Sphere>();
+    ball->SetMaterial().color = Color{ 1, 0, 0 };
+    ball->SetMaterial().ambient = 0.5;
+    ball->SetTransform(translation(0, -3.5f, -0.5f));
+    w.AddObject(ball);
+    const auto sqrt2 = static_cast<float>(std::sqrt(2));
+    const auto r = Ray{ Point(0, 0, -3), Vector(0, -sqrt2 / 2, sqrt2 / 2) };
+    const auto xs = Intersections{ { sqrt2, floor.get() } };
+
+    WHEN("comps = prepare_computations(xs[0], r, xs) &&\
+    \n color = shade_hit(w, comps, 5)")
+    {
+      std::vector<const Shape*> containers;
+      auto comps = prepare_computations(xs[0], r, &xs, &containers);
+      auto c = shade_hit(w, comps, 5);
+
+      THEN("c == color(0.93642, 0.68642, 0.68642)")
+      {
+        CHECK(c == Color{ 0.93642f, 0.68642f, 0.68642f });
+      }
+    }
+    WHEN("color = color_at(w, r, 5)")
+    {
+      auto c = color_at(w, r, 5);
+
+      THEN("c == color(0.93642, 0.68642, 0.68642), as color_at() finds the\
+      \n refractive indices on either side of the floor")
+      {
+        CHECK(c == Color{ 0.93642f, 0.68642f, 0.68642f });
+      }
+    }
+  }
+}
+
+SCENARIO("shade_hit() with a reflective, transparent material")
+{
+  GIVEN("w = default_world() &&\
+  \n r = ray(point(0, 0, -3), vector(0, -SQRT(2)/2, SQRT(2)/2)) &&\
+  \n floor = plane() with:\
+  \n | transform                 | translation(0, -1, 0) |\
+  \n | material.reflective       | 0.5                   |\
+  \n | material.transparency     | 0.5                   |\
+  \n | material.refractive_index | 1.5                   |\
+  \n AND floor is added to w &&\
+  \n ball = sphere() with:\
+  \n | material.color    | (1, 0, 0)                  |\
+  \n | material.ambient  | 0.5                        |\
+  \n | transform         | translation(0, -3.5, -0.5) |\
+  \n AND ball is added to w &&\
+  \n xs = intersections(SQRT(2):floor)")
+  {
+    auto w = default_world();
+    const auto sqrt2 = static_cast<float>(std::sqrt(2));
+    const auto r = Ray{ Point(0, 0, -3), Vector(0, -sqrt2 / 2, sqrt2 / 2) };
+    auto floor = std::make_shared<Plane>();
+    floor->SetTransform(translation(0, -1, 0));
+    floor->SetMaterial().reflective = 0.5;
+    floor->SetMaterial().transparency = 0.5;
+    floor->SetMaterial().refractiveIndex = 1.5;
+    w.AddObject(floor);
+    auto ball = std::make_shared<Sphere>();
+    ball->SetMaterial().color = Color{ 1, 0, 0 };
+    ball->SetMaterial().ambient = 0.5;
+    ball->SetTransform(translation(0, -3.5f, -0.5f));
+    w.AddObject(ball);
+    const auto xs = Intersections{ { sqrt2, floor.get() } };
+
+    WHEN("comps = prepare_computations(xs[0], r, xs) &&\
+    \n c = shade_hit(w, comps, 5)")
+    {
+      std::vector<const Shape*> containers;
+      auto comps = prepare_computations(xs[0], r, &xs, &containers);
+      auto c = shade_hit(w, comps, 5);
+
+      THEN("c == color(0.93391, 0.69643, 0.69243)")
+      {
+        CHECK(c == Color{ 0.93391f, 0.69643f, 0.69243f });
+      }
+    }
+    WHEN("c = color_at(w, r, 5)")
+    {
+      auto c = color_at(w, r, 5);
+
+      THEN("c == color(0.93391, 0.69643, 0.69243)")
+      {
+        CHECK(c == Color{ 0.93391f, 0.69643f, 0.69243f });
+      }
+    }
+  }
+}
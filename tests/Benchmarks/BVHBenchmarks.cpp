@@ -0,0 +1,309 @@
+#include "Benchmark.hpp"
+
+// Engine
+#include "RayTracer/Math/Transformations.hpp"
+#include "RayTracer/Rendering/Parsers/MeshCache.hpp"
+#include "RayTracer/Rendering/Parsers/OBJParser.hpp"
+#include "RayTracer/Rendering/Primitives/Group.hpp"
+#include "RayTracer/Rendering/Primitives/SmoothTriangle.hpp"
+#include "RayTracer/Rendering/Primitives/TriangleMesh.hpp"
+#include "RayTracer/Utils/OBJFile.hpp"
+
+#include <random>
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Acceleration;
+using namespace RayTracer::Rendering::Lighting;
+using namespace RayTracer::Rendering::Parsers;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Utils;
+
+namespace Benchmarks {
+
+namespace {
+
+constexpr std::size_t RayCount = 4096;
+
+std::filesystem::path GetSceneAssetsAbsolutePath()
+{
+  return std::filesystem::path(__FILE__)
+    .parent_path()
+    .parent_path()
+    .parent_path()
+    .append("assets")
+    .append("scenes");
+}
+
+std::shared_ptr<Group> LoadGroup(const OBJParser& parser)
+{
+  auto mesh = std::make_shared<Group>();
+  for (const auto& [name, triangles] : parser.GetGroupsMap()) {
+    for (const auto& triangle : triangles) {
+      mesh->AddChild(triangle);
+    }
+  }
+  return mesh;
+}
+
+/// @return the bytes a hierarchy keeps after its build
+std::size_t FootprintOf(const BVH& bvh)
+{
+  return bvh.GetNodes().size() * sizeof(BVH::Node) +
+         bvh.GetPrimitiveIndices().size() * sizeof(std::uint32_t);
+}
+
+/// @brief Bytes held by a Group of Triangles: the shapes, their owners and
+/// the hierarchy (make_shared's control block is counted as two pointers)
+std::size_t FootprintOf(const Group& group)
+{
+  std::size_t bytes = sizeof(Group) + FootprintOf(group.GetBVH());
+  for (const auto& child : group.GetChildren()) {
+    const bool smooth = dynamic_cast<const SmoothTriangle*>(child.get());
+    bytes += smooth ? sizeof(SmoothTriangle) : sizeof(Triangle);
+    bytes += 2 * sizeof(void*) + sizeof(child) + sizeof(const Shape*);
+  }
+  return bytes;
+}
+
+std::size_t FootprintOf(const TriangleMesh& mesh)
+{
+  return sizeof(TriangleMesh) + FootprintOf(mesh.GetBVH()) +
+         (mesh.GetVertices().size() + mesh.GetNormals().size()) *
+           sizeof(Tuple) +
+         (mesh.GetIndices().size() + mesh.GetNormalIndices().size()) *
+           sizeof(std::uint32_t);
+}
+
+/// @brief Rays from a sphere around the mesh toward points inside its box
+std::vector<Ray> RaysToward(const BoundingBox& box, std::mt19937& gen)
+{
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  const auto size = box.max - box.min;
+  const auto center = centroid(box);
+  const auto radius = magnitude(size);
+
+  std::vector<Ray> rays;
+  rays.reserve(RayCount);
+  for (std::size_t i = 0; i < RayCount; ++i) {
+    const auto target = Point(box.min.x + size.x * unit(gen),
+                              box.min.y + size.y * unit(gen),
+                              box.min.z + size.z * unit(gen));
+    auto offset = Vector(unit(gen) - 0.5f, unit(gen) - 0.5f, unit(gen) - 0.5f);
+    const auto origin = center + normalize(offset) * radius;
+    rays.push_back(Ray{ origin, normalize(target - origin) });
+  }
+  return rays;
+}
+
+float NearestHit(const Group& mesh, const Ray& r)
+{
+  const auto xs = mesh.Intersect(r);
+  const auto* hit = xs.Hit();
+  return hit ? hit->t : -1.0f;
+}
+
+float ClosestHit(const Group& mesh, const Ray& r)
+{
+  const auto hit = mesh.IntersectClosest(r, 0, INFINITY);
+  return hit ? hit->t : -1.0f;
+}
+
+bool RunMesh(const char* filename)
+{
+  std::printf(" %s\n", filename);
+  const auto path = GetSceneAssetsAbsolutePath().append(filename);
+  const OBJParser parser(OBJFile(path.string().c_str()));
+  auto mesh = LoadGroup(parser);
+
+  std::mt19937 gen(5);
+  const auto rays = RaysToward(mesh->Bounds(), gen);
+
+  std::vector<float> reference;
+  auto passed = true;
+  for (auto method : { BVH::SplitMethod::Median, BVH::SplitMethod::BinnedSAH }) {
+    const bool sah = method == BVH::SplitMethod::BinnedSAH;
+    BVH::BuildSettings settings{};
+    settings.splitMethod = method;
+    mesh->SetBuildSettings(settings);
+
+    const auto& stats = mesh->GetBVH().GetBuildStats();
+    std::printf("  %-9s %zu triangles: build %.2f ms, %zu nodes, depth %u, "
+                "SAH cost %.1f\n",
+                sah ? "SAH" : "median",
+                mesh->GetChildren().size(),
+                stats.milliseconds,
+                stats.nodeCount,
+                stats.depth,
+                mesh->GetBVH().GetSAHCost());
+
+    std::vector<float> hits;
+    hits.reserve(rays.size());
+    for (const auto& r : rays) {
+      hits.push_back(NearestHit(*mesh, r));
+    }
+    if (reference.empty()) {
+      reference = hits;
+    } else if (hits != reference) {
+      std::printf("  SAH and median hierarchies disagree on nearest hits\n");
+      passed = false;
+    }
+
+    Report(sah ? "intersect, binned SAH" : "intersect, median split",
+           NanosecondsPerCall(RayCount, [&](std::size_t i) {
+             return NearestHit(*mesh, rays[i]);
+           }));
+  }
+
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    if (ClosestHit(*mesh, rays[i]) != reference[i]) {
+      std::printf("  closest-hit query disagrees with the sorted list\n");
+      passed = false;
+      break;
+    }
+  }
+  Report("closest hit, binned SAH",
+         NanosecondsPerCall(RayCount, [&](std::size_t i) {
+           return ClosestHit(*mesh, rays[i]);
+         }));
+
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    if (mesh->Occluded(rays[i], 0, INFINITY) != (reference[i] >= 0)) {
+      std::printf("  any-hit query disagrees with the sorted list\n");
+      passed = false;
+      break;
+    }
+  }
+  Report("any hit, binned SAH",
+         NanosecondsPerCall(RayCount, [&](std::size_t i) {
+           return mesh->Occluded(rays[i], 0, INFINITY);
+         }));
+
+  // the same faces as one indexed TriangleMesh
+  const auto indexed = parser.GetMesh();
+  std::printf("  memory: %zu KiB as a Group of triangles, %zu KiB as a "
+              "TriangleMesh\n",
+              FootprintOf(*mesh) / 1024,
+              FootprintOf(*indexed) / 1024);
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    const auto hit = indexed->IntersectClosest(rays[i], 0, INFINITY);
+    if ((hit ? hit->t : -1.0f) != reference[i]) {
+      std::printf("  TriangleMesh disagrees with the Group of triangles\n");
+      passed = false;
+      break;
+    }
+  }
+  Report("intersect, TriangleMesh",
+         NanosecondsPerCall(RayCount, [&](std::size_t i) {
+           const auto xs = indexed->Intersect(rays[i]);
+           const auto* hit = xs.Hit();
+           return hit ? hit->t : -1.0f;
+         }));
+  Report("closest hit, TriangleMesh",
+         NanosecondsPerCall(RayCount, [&](std::size_t i) {
+           const auto hit = indexed->IntersectClosest(rays[i], 0, INFINITY);
+           return hit ? hit->t : -1.0f;
+         }));
+
+  // the same SAH hierarchy, collapsed into 4- and 8-wide nodes
+  for (std::uint32_t width : { 4u, 8u }) {
+    BVH::BuildSettings settings{};
+    settings.width = width;
+    mesh->SetBuildSettings(settings);
+    mesh->GetBVH();
+
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+      if (NearestHit(*mesh, rays[i]) != reference[i] ||
+          ClosestHit(*mesh, rays[i]) != reference[i] ||
+          mesh->Occluded(rays[i], 0, INFINITY) != (reference[i] >= 0)) {
+        std::printf("  %u-wide hierarchy disagrees with the binary one\n",
+                    width);
+        passed = false;
+        break;
+      }
+    }
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "intersect, %u-wide", width);
+    Report(label, NanosecondsPerCall(RayCount, [&](std::size_t i) {
+             return NearestHit(*mesh, rays[i]);
+           }));
+    std::snprintf(label, sizeof(label), "closest hit, %u-wide", width);
+    Report(label, NanosecondsPerCall(RayCount, [&](std::size_t i) {
+             return ClosestHit(*mesh, rays[i]);
+           }));
+    std::snprintf(label, sizeof(label), "any hit, %u-wide", width);
+    Report(label, NanosecondsPerCall(RayCount, [&](std::size_t i) {
+             return mesh->Occluded(rays[i], 0, INFINITY);
+           }));
+  }
+
+  // a small deformation: refitting the old topology against rebuilding
+  std::vector<BoundingBox> bounds;
+  for (const auto& child : mesh->GetChildren()) {
+    bounds.push_back(child->Bounds());
+  }
+  BVH bvh;
+  bvh.Build(bounds, BVH::BuildSettings{});
+  const auto size = magnitude(mesh->Bounds().max - mesh->Bounds().min);
+  std::uniform_real_distribution<float> jitter(-0.01f * size, 0.01f * size);
+  std::vector<BoundingBox> slotBounds;
+  for (auto primitive : bvh.GetPrimitiveIndices()) {
+    const auto& box = bounds[primitive];
+    slotBounds.push_back(
+      transform(box, translation(jitter(gen), jitter(gen), jitter(gen))));
+  }
+  const auto refitNs = NanosecondsPerCall(16, [&](std::size_t) {
+    bvh.Refit(slotBounds);
+    return bvh.GetBounds().max.x;
+  });
+  const auto refitCost = bvh.GetSAHCost();
+  BVH rebuilt;
+  const auto buildNs = NanosecondsPerCall(16, [&](std::size_t) {
+    rebuilt.Build(slotBounds, BVH::BuildSettings{});
+    return rebuilt.GetBounds().max.x;
+  });
+  std::printf("  refit %.3f ms, rebuild %.3f ms, refitted SAH cost %.2fx "
+              "the rebuilt one\n",
+              refitNs / 1e6,
+              buildNs / 1e6,
+              refitCost / rebuilt.GetSAHCost());
+
+  // startup: parsing and building against reading a cached entry
+  const auto cacheDirectory =
+    std::filesystem::temp_directory_path().append("RayTracerMeshCache");
+  std::filesystem::remove_all(cacheDirectory);
+  MeshCache cache(cacheDirectory);
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  const auto cold = cache.Load(path);
+  const auto built = Clock::now();
+  const auto warm = cache.Load(path);
+  const auto loaded = Clock::now();
+  const std::chrono::duration<double, std::milli> coldMs = built - start;
+  const std::chrono::duration<double, std::milli> warmMs = loaded - built;
+  std::printf("  load %.2f ms parsing and building, %.2f ms from the cache\n",
+              coldMs.count(),
+              warmMs.count());
+  if (cache.GetHitCount() != 1 ||
+      warm->GetIndices() != cold->GetIndices() ||
+      warm->GetBVH().GetNodes().size() != cold->GetBVH().GetNodes().size()) {
+    std::printf("  cached mesh differs from the built one\n");
+    passed = false;
+  }
+  std::filesystem::remove_all(cacheDirectory);
+  return passed;
+}
+
+} // namespace
+
+bool RunBVHBenchmarks()
+{
+  std::puts("BVH construction and traversal");
+
+  auto passed = RunMesh("teapot.obj");
+  passed &= RunMesh("teddy.obj");
+  passed &= RunMesh("pumpkin_tall_10k.obj");
+  return passed;
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,42 @@
+#pragma once
+#include "RayTracerPCH.hpp"
+
+namespace Benchmarks {
+
+/// @section Helper functions
+
+/**
+ * @brief Runs f() iterations times and returns the mean cost of one call
+ * @details f should return a value derived from its work; it is folded into a
+ * volatile sink so the optimizer cannot discard the loop.
+ */
+template<typename F>
+double NanosecondsPerCall(std::size_t iterations, F&& f)
+{
+  using Clock = std::chrono::steady_clock;
+  static volatile float sink{};
+
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    sink = sink + static_cast<float>(f(i));
+  }
+  const auto end = Clock::now();
+
+  const std::chrono::duration<double, std::nano> elapsed = end - start;
+  return elapsed.count() / static_cast<double>(iterations);
+}
+
+inline void Report(const char* label, double nanoseconds)
+{
+  std::printf("  %-40s %12.1f ns\n", label, nanoseconds);
+}
+
+/// @section Benchmark suites
+/// Each suite prints its timings and returns false if a correctness check
+/// failed.
+
+bool RunMatrixBenchmarks();
+bool RunBVHBenchmarks();
+bool RunSceneBenchmarks();
+
+} // namespace Benchmarks
@@ -0,0 +1,111 @@
+#include "Benchmark.hpp"
+
+// Engine
+#include "RayTracer/Math/Matrix.hpp"
+#include "RayTracer/Math/Transformations.hpp"
+
+#include <random>
+
+using namespace RayTracer::Math;
+
+namespace Benchmarks {
+
+namespace {
+
+constexpr std::size_t SampleCount = 256;
+
+std::vector<mat4> AffineSamples(std::mt19937& gen)
+{
+  std::uniform_real_distribution<float> angle(-PI, PI);
+  std::uniform_real_distribution<float> offset(-10.0f, 10.0f);
+  std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+
+  std::vector<mat4> samples;
+  samples.reserve(SampleCount);
+  for (std::size_t i = 0; i < SampleCount; ++i) {
+    samples.push_back(translation(offset(gen), offset(gen), offset(gen)) *
+                      rotation_x(angle(gen)) * rotation_y(angle(gen)) *
+                      rotation_z(angle(gen)) *
+                      scaling(scale(gen), scale(gen), scale(gen)));
+  }
+  return samples;
+}
+
+std::vector<mat4> GeneralSamples(std::mt19937& gen)
+{
+  std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+
+  std::vector<mat4> samples;
+  samples.reserve(SampleCount);
+  while (samples.size() < SampleCount) {
+    mat4 m;
+    for (auto row = 0; row < 4; ++row) {
+      for (auto col = 0; col < 4; ++col) {
+        m[row][col] = value(gen);
+      }
+    }
+    // keep the comparison meaningful in single precision
+    if (std::abs(determinant(m)) > 1.0f) {
+      samples.push_back(m);
+    }
+  }
+  return samples;
+}
+
+bool CheckAgreement(const char* label, const std::vector<mat4>& samples)
+{
+  std::size_t mismatches = 0;
+  for (const auto& m : samples) {
+    if (!(inverse(m) == inverse<4, 4>(m)) ||
+        !(m * inverse(m) == mat4::Identity())) {
+      ++mismatches;
+    }
+  }
+  if (mismatches > 0) {
+    std::printf("  %s: %zu of %zu inverses differ by more than EPSILON\n",
+                label,
+                mismatches,
+                samples.size());
+  }
+  return mismatches == 0;
+}
+
+} // namespace
+
+bool RunMatrixBenchmarks()
+{
+  std::puts("Matrix inverse (4x4)");
+
+  std::mt19937 gen(324);
+  const auto affine = AffineSamples(gen);
+  const auto general = GeneralSamples(gen);
+
+  auto passed = CheckAgreement("affine", affine);
+  passed &= CheckAgreement("general", general);
+
+  constexpr std::size_t Iterations = 1 << 16;
+  const auto pick = [](const std::vector<mat4>& v, std::size_t i) {
+    return v[i % v.size()];
+  };
+
+  Report("cofactor expansion, inverse<4, 4>()",
+         NanosecondsPerCall(Iterations, [&](std::size_t i) {
+           return inverse<4, 4>(pick(general, i))[3][3];
+         }));
+  Report("closed-form adjugate, inverse()",
+         NanosecondsPerCall(Iterations, [&](std::size_t i) {
+           return inverse(pick(general, i))[3][3];
+         }));
+  Report("cofactor expansion on affine input",
+         NanosecondsPerCall(Iterations, [&](std::size_t i) {
+           return inverse<4, 4>(pick(affine, i))[0][3];
+         }));
+  Report("affine_inverse()",
+         NanosecondsPerCall(Iterations, [&](std::size_t i) {
+           return affine_inverse(pick(affine, i))[0][3];
+         }));
+
+  return passed;
+}
+
+} // namespace Benchmarks
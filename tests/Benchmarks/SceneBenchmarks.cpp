@@ -0,0 +1,468 @@
+#include "Benchmark.hpp"
+
+// Engine
+#include "RayTracer/Math/Transformations.hpp"
+#include "RayTracer/Rendering/Cameras/Camera.hpp"
+#include "RayTracer/Rendering/Cameras/WavefrontRenderer.hpp"
+#include "RayTracer/Rendering/Patterns/StripePattern.hpp"
+#include "RayTracer/Rendering/Primitives/CSG.hpp"
+#include "RayTracer/Rendering/Primitives/Cone.hpp"
+#include "RayTracer/Rendering/Primitives/Cube.hpp"
+#include "RayTracer/Rendering/Primitives/Cylinder.hpp"
+#include "RayTracer/Rendering/Primitives/Group.hpp"
+#include "RayTracer/Rendering/Primitives/Plane.hpp"
+#include "RayTracer/Rendering/Primitives/Sphere.hpp"
+#include "RayTracer/Rendering/Primitives/Triangle.hpp"
+#include "RayTracer/Rendering/Scene/Integrator.hpp"
+#include "RayTracer/Rendering/Scene/World.hpp"
+
+using namespace RayTracer::Math;
+using namespace RayTracer::Rendering::Cameras;
+using namespace RayTracer::Rendering::Colors;
+using namespace RayTracer::Rendering::Materials;
+using namespace RayTracer::Rendering::Patterns;
+using namespace RayTracer::Rendering::Primitives;
+using namespace RayTracer::Rendering::Scene;
+
+namespace Benchmarks {
+
+namespace {
+
+constexpr std::size_t NormalCount = 1 << 16;
+constexpr std::size_t RayCount = 1 << 16;
+constexpr int MaterialReadCount = 1 << 22;
+constexpr std::size_t CSGRayCount = 1 << 12;
+constexpr std::size_t PacketWidth = 16;
+
+/// @return the sphere at the bottom of depth nested groups, and its root
+std::pair<std::shared_ptr<Group>, std::shared_ptr<Sphere>> Nested(int depth)
+{
+  auto root = std::make_shared<Group>();
+  root->SetTransform(rotation_y(0.1f));
+  auto parent = root;
+  for (int level = 1; level < depth; ++level) {
+    auto g = std::make_shared<Group>();
+    g->SetTransform(translation(0.1f, 0, 0) * rotation_z(0.1f));
+    parent->AddChild(g);
+    parent = g;
+  }
+  auto s = std::make_shared<Sphere>();
+  parent->AddChild(s);
+  return { root, s };
+}
+
+bool RunNormals()
+{
+  std::puts(" normals through nested groups");
+  auto passed = true;
+  for (int depth : { 1, 4, 16, 64 }) {
+    auto [root, s] = Nested(depth);
+    const auto point = Point(0.3f, 0.2f, -1.0f);
+
+    const auto walked = s->GetNormalAt(point);
+    const auto walkedNs = NanosecondsPerCall(NormalCount, [&](std::size_t) {
+      return s->GetNormalAt(point).x;
+    });
+    root->Bake();
+    if (!(s->GetNormalAt(point) == walked)) {
+      std::printf("  depth %d: baked normal differs from the walked one\n",
+                  depth);
+      passed = false;
+    }
+    const auto bakedNs = NanosecondsPerCall(NormalCount, [&](std::size_t) {
+      return s->GetNormalAt(point).x;
+    });
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "depth %d, parent walk", depth);
+    Report(label, walkedNs);
+    std::snprintf(label, sizeof(label), "depth %d, baked", depth);
+    Report(label, bakedNs);
+  }
+  return passed;
+}
+
+/// @brief A 32 x 32 x 4 lattice cycling through five kinds of primitive,
+/// each row of it in a group of its own
+World Lattice()
+{
+  World w;
+  for (int z = 0; z < 4; ++z) {
+    for (int y = 0; y < 32; ++y) {
+      auto row = std::make_shared<Group>();
+      row->SetTransform(translation(0, y * 3.0f, z * 3.0f));
+      for (int x = 0; x < 32; ++x) {
+        std::shared_ptr<Shape> shape;
+        switch ((x + y + z) % 5) {
+          case 0:
+            shape = std::make_shared<Sphere>();
+            break;
+          case 1:
+            shape = std::make_shared<Cube>();
+            break;
+          case 2: {
+            auto cylinder = std::make_shared<Cylinder>();
+            cylinder->SetMinimum(-1);
+            cylinder->SetMaximum(1);
+            cylinder->SetClosed(true);
+            shape = cylinder;
+            break;
+          }
+          case 3: {
+            auto cone = std::make_shared<Cone>();
+            cone->SetMinimum(-1);
+            cone->SetMaximum(0);
+            cone->SetClosed(true);
+            shape = cone;
+            break;
+          }
+          default:
+            shape = std::make_shared<Triangle>(
+              Point(-1, -1, 0), Point(1, -1, 0), Point(0, 1, 0));
+            break;
+        }
+        shape->SetTransform(translation(x * 3.0f, 0, 0) *
+                            rotation_y(0.1f * static_cast<float>(x)));
+        row->AddChild(shape);
+      }
+      w.AddObject(row);
+    }
+  }
+  return w;
+}
+
+bool RunCompiled()
+{
+  std::puts(" closest hits in a lattice of 4096 primitives");
+  auto w = Lattice();
+  std::vector<Ray> rays;
+  rays.reserve(RayCount);
+  for (std::size_t i = 0; i < RayCount; ++i) {
+    const auto x = static_cast<float>(i % 256) * 0.375f - 1.5f;
+    const auto y = static_cast<float>(i / 256) * 0.375f - 1.5f;
+    const auto origin = Point(48.1f, 47.7f, -30.3f);
+    rays.push_back(Ray{ origin, Point(x, y, 12) - origin });
+  }
+
+  std::vector<const Shape*> expected;
+  expected.reserve(rays.size());
+  for (const auto& r : rays) {
+    const auto hit = w.IntersectClosest(r);
+    expected.push_back(hit ? hit->object : nullptr);
+  }
+  const auto shapesNs = NanosecondsPerCall(rays.size(), [&](std::size_t i) {
+    const auto hit = w.IntersectClosest(rays[i]);
+    return hit ? hit->t : 0.0f;
+  });
+
+  // the paths round the ray transforms differently, which decides rays
+  // that graze a surface either way
+  w.Commit();
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < rays.size(); ++i) {
+    const auto hit = w.IntersectClosest(rays[i]);
+    if ((hit ? hit->object : nullptr) != expected[i]) {
+      ++mismatches;
+    }
+  }
+  const auto passed = mismatches <= rays.size() / 1000;
+  if (!passed) {
+    std::printf("  %zu rays hit another shape once compiled\n", mismatches);
+  }
+  const auto compiledNs = NanosecondsPerCall(rays.size(), [&](std::size_t i) {
+    const auto hit = w.IntersectClosest(rays[i]);
+    return hit ? hit->t : 0.0f;
+  });
+
+  // neighbouring rays of a grid row, traced together
+  RayPacket<PacketWidth> packet;
+  PacketHits<PacketWidth> hits;
+  const auto trace = [&](std::size_t first) {
+    for (std::size_t i = 0; i < PacketWidth; ++i) {
+      packet.Set(i, rays[first + i]);
+    }
+    w.IntersectClosest(packet, hits);
+  };
+  std::size_t packetMismatches = 0;
+  for (std::size_t first = 0; first < rays.size(); first += PacketWidth) {
+    trace(first);
+    for (std::size_t i = 0; i < PacketWidth; ++i) {
+      const auto alone = w.IntersectClosest(rays[first + i]);
+      const auto& hit = hits[i];
+      if ((hit ? hit->object : nullptr) != (alone ? alone->object : nullptr)) {
+        ++packetMismatches;
+      }
+    }
+  }
+  const auto packetsPassed = packetMismatches <= rays.size() / 1000;
+  if (!packetsPassed) {
+    std::printf("  %zu rays hit another shape in packets\n", packetMismatches);
+  }
+  const auto packetNs =
+    NanosecondsPerCall(rays.size() / PacketWidth,
+                       [&](std::size_t i) {
+                         trace(i * PacketWidth);
+                         return hits[0] ? hits[0]->t : 0.0f;
+                       }) /
+    PacketWidth;
+
+  Report("through shapes", shapesNs);
+  Report("compiled scene", compiledNs);
+  Report("compiled scene, packets of 16", packetNs);
+  return passed && packetsPassed;
+}
+
+/// @brief Mean cost of one read(), with every thread reading at once
+template<typename Read>
+double NanosecondsPerParallelRead(Read&& read)
+{
+  const auto ns = NanosecondsPerCall(1, [&](std::size_t) {
+    float total = 0.0f;
+#pragma omp parallel for reduction(+ : total)
+    for (int i = 0; i < MaterialReadCount; ++i) {
+      total += read();
+    }
+    return total;
+  });
+  return ns / MaterialReadCount;
+}
+
+bool RunMaterials()
+{
+  std::puts(" material reads of one patterned sphere, on every thread");
+  auto s = std::make_shared<Sphere>();
+  s->SetMaterial().pattern =
+    std::make_shared<StripePattern>(White, Black);
+  const Shape& shape = *s;
+
+  // a copy takes and drops a reference to the pattern, on a shared count
+  const auto copiedNs = NanosecondsPerParallelRead([&] {
+    const Material m = shape.GetMaterial();
+    return m.diffuse;
+  });
+  const auto referencedNs = NanosecondsPerParallelRead([&] {
+    return shape.GetMaterial().diffuse;
+  });
+
+  Report("copied", copiedNs);
+  Report("by reference", referencedNs);
+  return s->GetMaterial().pattern.has_value();
+}
+
+/// @brief A row of 256 spheres with a cube cut out of each, unioned in a
+/// balanced tree
+std::shared_ptr<Shape> CSGRow(int first, int count)
+{
+  if (count == 1) {
+    std::shared_ptr<Shape> sphere = std::make_shared<Sphere>();
+    std::shared_ptr<Shape> cube = std::make_shared<Cube>();
+    cube->SetTransform(translation(0, 0, -1) * scaling(0.5f, 0.5f, 0.5f));
+    auto cut = CreateCSGShape(CSGOperation::Difference, sphere, cube);
+    cut->SetTransform(translation(first * 2.5f, 0, 0));
+    return cut;
+  }
+  const auto half = count / 2;
+  return CreateCSGShape(CSGOperation::Union,
+                        CSGRow(first, half),
+                        CSGRow(first + half, count - half));
+}
+
+bool RunCSG()
+{
+  std::puts(" rays through a CSG tree of 512 leaves");
+  const auto row = CSGRow(0, 256);
+  std::vector<Ray> rays;
+  rays.reserve(CSGRayCount);
+  for (std::size_t i = 0; i < CSGRayCount; ++i) {
+    const auto x = static_cast<float>(i) * 640.0f / CSGRayCount - 1.0f;
+    rays.push_back(Ray{ Point(x, 0.1f, -5), Vector(0, 0, 1) });
+  }
+
+  std::size_t hits = 0;
+  for (const auto& r : rays) {
+    hits += row->Intersect(r).Count();
+  }
+  const auto ns = NanosecondsPerCall(rays.size(), [&](std::size_t i) {
+    return row->Intersect(rays[i]).Count();
+  });
+
+  Report("intersect", ns);
+  return hits > 0;
+}
+
+bool RunPrimaryRays()
+{
+  std::puts(" primary rays for a 1280 x 720 image");
+  auto c = Camera{ 1280, 720, 1.0472f };
+  c.transform = view_transform(
+    Point(0, 1.5f, -5), Point(0, 1, 0), Vector(0, 1, 0));
+  const int width = 1280;
+  const int height = 720;
+  const auto pixels = static_cast<std::size_t>(width) * height;
+
+  // what ray_for_pixel() did before the camera kept its inverse
+  const auto inverting = [&](float px, float py) {
+    const auto x = c.half_width - (px + 0.5f) * c.pixel_size;
+    const auto y = c.half_height - (py + 0.5f) * c.pixel_size;
+    const auto pixel = inverse(c.transform) * Point(x, y, -1);
+    const auto origin = inverse(c.transform) * Point(0, 0, 0);
+    return Ray{ origin, normalize(pixel - origin) };
+  };
+  const auto invertingNs = NanosecondsPerCall(pixels, [&](std::size_t i) {
+    return inverting(i % width, i / width).direction.x;
+  });
+  const auto cachedNs = NanosecondsPerCall(pixels, [&](std::size_t i) {
+    return ray_for_pixel(c, i % width, i / width).direction.x;
+  });
+
+  std::vector<Ray> rays;
+  auto mismatches = 0;
+  const auto rowNs = NanosecondsPerCall(height, [&](std::size_t y) {
+    rays_for_row(c, 0, y, width, rays);
+    const auto expected = ray_for_pixel(c, width - 1, y);
+    mismatches += !(rays.back().direction == expected.direction);
+    return rays.back().direction.x;
+  }) / width;
+
+  Report("per pixel, inverting twice", invertingNs);
+  Report("per pixel, cached inverse", cachedNs);
+  Report("per row, incremental", rowNs);
+  return mismatches == 0;
+}
+
+bool RunWavefront()
+{
+  std::puts(" a 160 x 120 frame with reflections, on one thread");
+  auto w = default_world();
+  auto floor = std::make_shared<Plane>();
+  floor->SetTransform(translation(0, -1, 0));
+  floor->SetMaterial().reflective = 0.5f;
+  w.AddObject(floor);
+  auto glass = std::make_shared<Sphere>(GlassSphere());
+  glass->SetTransform(translation(-1.5f, 0, -1.5f) * scaling(0.5f, 0.5f, 0.5f));
+  glass->SetMaterial().reflective = 0.9f;
+  w.AddObject(glass);
+
+  auto c = Camera{ 160, 120, 1.0472f };
+  c.transform = view_transform(
+    Point(-2.0f, 2.5f, -6.0f), Point(0.0f, 0.0f, 0.0f), Vector(0, 1, 0));
+  RayTracer::Core::ThreadPool pool(1);
+  WavefrontRenderer wavefront;
+  const auto pixels = 160.0 * 120.0;
+
+  const auto expected = render(c, w, pool);
+  const auto image = wavefront.Render(c, w, pool);
+  auto mismatches = 0;
+  for (int y = 0; y < 120; ++y) {
+    for (int x = 0; x < 160; ++x) {
+      mismatches += !(pixel_at(image, x, y) == pixel_at(expected, x, y));
+    }
+  }
+
+  const auto depthFirstNs = NanosecondsPerCall(1, [&](std::size_t) {
+    return pixel_at(render(c, w, pool), 80, 60).r;
+  });
+  const auto wavefrontNs = NanosecondsPerCall(1, [&](std::size_t) {
+    return pixel_at(wavefront.Render(c, w, pool), 80, 60).r;
+  });
+
+  const auto& stats = wavefront.GetStats();
+  Report("depth-first, per pixel", depthFirstNs / pixels);
+  Report("wavefront, per pixel", wavefrontNs / pixels);
+  std::printf("  %zu shadow, %zu reflection and %zu refraction rays;"
+              " %zu bounces, queues up to %zu\n",
+              stats.shadowRays,
+              stats.reflectionRays,
+              stats.refractionRays,
+              stats.raysPerBounce.size(),
+              stats.peakRayQueue);
+  return mismatches == 0;
+}
+
+bool RunIntegrator()
+{
+  std::puts(" a 160 x 120 frame of glass spheres, on one thread");
+  auto w = default_world();
+  auto floor = std::make_shared<Plane>();
+  floor->SetTransform(translation(0, -1, 0));
+  floor->SetMaterial().reflective = 0.5f;
+  w.AddObject(floor);
+  for (int z = 0; z < 3; ++z) {
+    for (int x = 0; x < 4; ++x) {
+      auto glass = std::make_shared<Sphere>(GlassSphere());
+      const auto at = Point(-3.0f + 1.6f * x, -0.5f, -2.0f + 1.6f * z);
+      glass->SetTransform(translation(at.x, at.y, at.z) *
+                          scaling(0.5f, 0.5f, 0.5f));
+      glass->SetMaterial().reflective = 0.9f;
+      w.AddObject(glass);
+    }
+  }
+
+  auto c = Camera{ 160, 120, 1.0472f };
+  c.transform = view_transform(
+    Point(-2.0f, 2.5f, -6.0f), Point(0.0f, 0.0f, 0.0f), Vector(0, 1, 0));
+  RayTracer::Core::ThreadPool pool(1);
+  const auto pixels = 160.0 * 120.0;
+  const auto expected = render(c, w, pool);
+
+  const auto recursiveNs = NanosecondsPerCall(1, [&](std::size_t) {
+    return pixel_at(render(c, w, pool), 80, 60).r;
+  });
+  Report("recursive, per pixel", recursiveNs / pixels);
+
+  auto passed = true;
+  const std::pair<const char*, Integrator::Settings> runs[] = {
+    { "iterative, no cutoff", { 5, 0.0f } },
+    { "iterative, cutoff 1/512", {} },
+    { "iterative, cutoff 1/512 and roulette", { 5, 1.0f / 512, true } },
+  };
+  for (const auto& [label, settings] : runs) {
+    const auto ns = NanosecondsPerCall(1, [&](std::size_t) {
+      return pixel_at(render(c, w, settings, pool), 80, 60).r;
+    });
+
+    // the rays behind the same image, and how far it strays from render()'s
+    const auto image = render(c, w, settings, pool);
+    auto integrator = Integrator(settings);
+    auto error = 0.0f;
+    for (int y = 0; y < 120; ++y) {
+      for (int x = 0; x < 160; ++x) {
+        integrator.Trace(w, ray_for_pixel(c, x, y));
+        const auto d = pixel_at(image, x, y) - pixel_at(expected, x, y);
+        error =
+          std::max({ error, std::abs(d.r), std::abs(d.g), std::abs(d.b) });
+      }
+    }
+
+    Report(label, ns / pixels);
+    const auto& stats = integrator.GetStats();
+    std::printf("  %.2f rays per pixel, %zu culled, %zu ended by roulette;"
+                " largest error %.4f\n",
+                stats.rays / pixels,
+                stats.culled,
+                stats.terminated,
+                error);
+    if (!settings.russianRoulette && error > 1.0f / 64) {
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+} // namespace
+
+bool RunSceneBenchmarks()
+{
+  std::puts("Scene preparation and shading");
+
+  auto passed = RunNormals();
+  passed = RunCompiled() && passed;
+  passed = RunMaterials() && passed;
+  passed = RunCSG() && passed;
+  passed = RunPrimaryRays() && passed;
+  passed = RunWavefront() && passed;
+  passed = RunIntegrator() && passed;
+  return passed;
+}
+
+} // namespace Benchmarks
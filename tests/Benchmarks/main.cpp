@@ -0,0 +1,12 @@
+#include "Benchmark.hpp"
+
+int main()
+{
+  auto passed = true;
+
+  passed &= Benchmarks::RunMatrixBenchmarks();
+  passed &= Benchmarks::RunBVHBenchmarks();
+  passed &= Benchmarks::RunSceneBenchmarks();
+
+  return passed ? 0 : 1;
+}